@@ -38,7 +38,9 @@
 #include "Network/NetworkManager.hpp"
 
 #include "Utils/DataPaths.hpp"
+#include "Utils/Metrics.hpp"
 #include "Utils/Settings.hpp"
+#include "Utils/Trace.hpp"
 
 #include "AdBlock/Rule.hpp"
 #include "AdBlock/Matcher.hpp"
@@ -77,6 +79,8 @@ void Manager::load()
 	if (m_loaded)
 		return;
 
+	SN_TRACE_SCOPE("ADB::Manager::load");
+
 	Settings settings{};
 
 	settings.beginGroup("AdBlock-Settings");
@@ -327,19 +331,28 @@ bool Manager::removeSubscription(Subscription* subscription)
 
 bool Manager::block(Engine::UrlRequestInfo& request)
 {
-	const QString urlString{request.requestUrl().toEncoded().toLower()};
-	const QString urlDomain{request.requestUrl().host().toLower()};
-	const QString urlScheme{request.requestUrl().scheme().toLower()};
+	const QString& urlString{request.normalizedUrl()};
+	const QString& urlDomain{request.host()};
+	const QString& urlScheme{request.scheme()};
 
 	if (!isEnabled() || !canRunOnScheme(urlScheme))
 		return false;
 
+	Metrics::increment(Metrics::AdBlockRequests);
+
 	bool res{false};
-	const Rule* blockedRule{m_matcher->match(request, urlDomain, urlString)};
+	const Rule* blockedRule{nullptr};
+
+	{
+		ScopedTiming timing{Metrics::AdBlockMatch};
+		blockedRule = m_matcher->match(request, urlDomain, urlString);
+	}
 
 	if (blockedRule) {
 		res = true;
 
+		Metrics::increment(Metrics::AdBlockBlocked);
+
 		if (request.resourceType() == Engine::UrlRequestInfo::ResourceTypeMainFrame) {
 			QUrl url{QStringLiteral("sielo:adblock")};
 			QUrlQuery query{};
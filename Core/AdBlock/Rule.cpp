@@ -32,25 +32,6 @@
 namespace Sn {
 namespace ADB {
 
-static QString toSecondLevelDomain(const QUrl& url)
-{
-	const QString topLevelDomain{url.topLevelDomain()};
-	const QString urlHost{url.host()};
-
-	if (topLevelDomain.isEmpty() || url.host().isEmpty())
-		return QString();
-
-	QString domain{urlHost.left(urlHost.size() - topLevelDomain.size())};
-
-	if (domain.count(QLatin1Char('.')) != 0)
-		return urlHost;
-
-	while (domain.count(QLatin1Char('.')) != 0)
-		domain = domain.mid(domain.indexOf(QLatin1Char('.')) + 1);
-
-	return domain + topLevelDomain;
-}
-
 Rule::Rule(const QString& filter, Subscription* subscription) :
 		m_subscription(subscription),
 		m_type(StringContainsMatchRule),
@@ -179,7 +160,7 @@ bool Rule::networkMatch(const Engine::UrlRequestInfo& request, const QString& do
 	bool matched{stringMatch(domain, encodedUrl)};
 
 	if (matched) {
-		if (hasOption(DomainRestrictedOption) && !matchDomain(request.firstPartyUrl().host()))
+		if (hasOption(DomainRestrictedOption) && !matchDomain(request.firstPartyHost()))
 			return false;
 		if (hasOption(ThirdPartyOption) && !matchThirdParty(request))
 			return false;
@@ -251,10 +232,7 @@ bool Rule::matchDomain(const QString& domain) const
 
 bool Rule::matchThirdParty(const Engine::UrlRequestInfo& request) const
 {
-	const QString firstPartyHost{toSecondLevelDomain(request.firstPartyUrl())};
-	const QString host{toSecondLevelDomain(request.requestUrl())};
-
-	bool match{firstPartyHost != host};
+	bool match{request.isThirdParty()};
 
 	return hasException(ThirdPartyOption) == !match;
 }
@@ -44,6 +44,10 @@ public:
 
 	void interceptRequest(Engine::UrlRequestInfo& info);
 
+	// Blocking first lets the other interceptors skip blocked requests
+	int priority() const { return HighPriority; }
+	QString name() const { return QStringLiteral("AdBlock"); }
+
 private:
 	Manager* m_manager{nullptr};
 };
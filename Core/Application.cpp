@@ -35,6 +35,7 @@
 
 #include <QProcess>
 #include <QThreadPool> 
+#include <QDebug>
 
 #include <QDesktopServices>
 #include <QFontDatabase>
@@ -58,24 +59,37 @@
 #include "MaquetteGrid/MaquetteGrid.hpp"
 #include "MaquetteGrid/MaquetteGridManager.hpp"
 #include "Download/DownloadManager.hpp"
+#include "Download/DownloadEngine.hpp"
 
 #include "Database/SqlDatabase.hpp"
 #include "Database/ProfileManager.hpp"
 
+#include "Utils/BackgroundCompositor.hpp"
 #include "Utils/RegExp.hpp"
 #include "Utils/CommandLineOption.hpp"
 #include "Utils/DataPaths.hpp"
+#include "Utils/InitScheduler.hpp"
+#include "Utils/Metrics.hpp"
+#include "Utils/Trace.hpp"
 #include "Utils/Updater.hpp"
 #include "Utils/RestoreManager.hpp"
 #include "Utils/Settings.hpp"
+#include "Utils/SettingsSnapshot.hpp"
+#include "Utils/ThemeCompiler.hpp"
+#include "Utils/ThumbnailService.hpp"
+#include "Utils/ClosedTabsManager.hpp"
 #include "Utils/SideBarManager.hpp"
 
 #include "Web/WebPage.hpp"
 #include "Web/Scripts.hpp"
+#include "Web/InternalPages.hpp"
 #include "Web/HTML5Permissions/HTML5PermissionsManager.hpp"
+#include "Web/Tab/TabLifecycleManager.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
 
 #include "Network/NetworkManager.hpp"
+#include "Network/HostInfoCache.hpp"
+#include "Network/SpeculativeLoader.hpp"
 
 #include "Widgets/TitleBar.hpp"
 #include "Widgets/Tab/TabWidget.hpp"
@@ -220,6 +234,10 @@ Application::Application(int& argc, char** argv) :
 	m_networkManager(nullptr),
 	m_webProfile(nullptr)
 {
+	m_startupTimer.start();
+
+	PhaseTimer startupPhase{};
+
 	// Setting up settings environment
 	QCoreApplication::setApplicationName(QLatin1String("Sielo"));
 	QCoreApplication::setApplicationVersion(QLatin1String("1.18.04"));
@@ -236,12 +254,6 @@ Application::Application(int& argc, char** argv) :
 			return;
 		}
 	*/
-	// Loading fonts information
-	int id = QFontDatabase::addApplicationFont(":data/fonts/morpheus.ttf");
-	QString family = QFontDatabase::applicationFontFamilies(id).at(0);
-	m_morpheusFont = QFont(family);
-	m_normalFont = font();
-
 	// Check command line options with given arguments
 	QUrl startUrl{};
 	QString startProfile{ };
@@ -272,6 +284,9 @@ Application::Application(int& argc, char** argv) :
 			case Application::CL_StartNewInstance:
 				newInstance = true;
 				break;
+			case Application::CL_TraceStartup:
+				m_traceFile = pair.text;
+				break;
 			case Application::CL_OpenUrlInCurrentTab:
 				startUrl = QUrl::fromUserInput(pair.text);
 				messages.append("ACTION:OpenUrlInCurrentTab" + pair.text);
@@ -308,17 +323,36 @@ Application::Application(int& argc, char** argv) :
 		return;
 	}
 
+#ifdef SIELO_TRACING
+	Trace::setEnabled(!m_traceFile.isEmpty());
+#else
+	if (!m_traceFile.isEmpty())
+		qWarning() << "Sielo was built without SIELO_TRACING, --trace-startup is ignored";
+#endif
+
+	// Loading fonts information
+	startupPhase.begin("Fonts");
+
+	int id = QFontDatabase::addApplicationFont(":data/fonts/morpheus.ttf");
+	QString family = QFontDatabase::applicationFontFamilies(id).at(0);
+	m_morpheusFont = QFont(family);
+	m_normalFont = font();
+
 	// Open urls from Sielo dialogs in Sielo itself
 	QDesktopServices::setUrlHandler("http", this, "addNewTab");
 	QDesktopServices::setUrlHandler("https", this, "addNewTab");
 	QDesktopServices::setUrlHandler("ftp", this, "addNewTab");
 
+	startupPhase.begin("Profile");
+
 	ProfileManager::initConfigDir();
 	ProfileManager profileManager{};
 	profileManager.initCurrentProfile(startProfile);
 
 	Settings::createSettings(DataPaths::currentProfilePath() + "/settings.ini");
 
+	m_initScheduler = new InitScheduler(this);
+
 #ifndef QT_DEBUG
 	// the 3rd parameter is the site id
 	m_piwikTracker = new PiwikTracker(this, QUrl("https://sielo.app/analytics"), 1);
@@ -326,12 +360,20 @@ Application::Application(int& argc, char** argv) :
 #endif 
 
 	// Setting up web and network objects
+	startupPhase.begin("Web profile");
+
 	m_webProfile = privateBrowsing() ? new Engine::WebProfile(this) : Engine::WebProfile::defaultWebProfile();
 	connect(m_webProfile, &Engine::WebProfile::downloadRequested, this, &Application::downloadRequested);
 
+	m_schemeHandler = new Engine::UrlSchemeHandler(this);
+	InternalPages::addPages(m_schemeHandler);
+	m_webProfile->installUrlSchemeHandler(QByteArrayLiteral("sielo"), m_schemeHandler);
+
 	m_networkManager = new NetworkManager(this);
 	m_autoFill = new AutoFill;
 
+	startupPhase.begin("Settings");
+
 	loadSettings();
 	translateApplication();
 
@@ -343,10 +385,21 @@ Application::Application(int& argc, char** argv) :
 							   Engine::WebProfile::DocumentCreation,
 							   Engine::WebProfile::MainWorld,
 							   true);
+	m_webProfile->insertScript(QStringLiteral("_sielo_hovered_link"),
+							   Scripts::hoveredLinkReporter(),
+							   Engine::WebProfile::DocumentReady,
+							   Engine::WebProfile::MainWorld,
+							   true);
+
+	startupPhase.begin("Plugins");
+
+	m_initScheduler->waitFor(QStringLiteral("Plugin extraction"));
 
 	m_plugins = new PluginProxy;
 	m_plugins->loadPlugins();
 
+	startupPhase.finish();
+
 	// Check if we start after a crash
 	if (!privateBrowsing()) {
 		Settings settings{};
@@ -359,7 +412,18 @@ Application::Application(int& argc, char** argv) :
 	}
 
 	// Create or restore window
+	startupPhase.begin("First window");
+
 	BrowserWindow* window{createWindow(Application::WT_FirstAppWindow, startUrl)};
+	window->installEventFilter(this);
+
+	startupPhase.finish();
+
+	// Nothing needs the ad-block rules before the first page finished loading
+	m_initScheduler->addTask(QStringLiteral("AdBlock"), InitScheduler::GuiThread, []()
+	{
+		ADB::Manager::instance();
+	}, QStringList(), InitScheduler::Deferred);
 
 	connect(this, SIGNAL(focusChanged(QWidget*,QWidget*)), this, SLOT(onFocusChanged()));
 
@@ -376,9 +440,14 @@ Application::Application(int& argc, char** argv) :
 			destroyRestoreManager();
 	}
 
-	if (m_restoreManager)
+	if (m_restoreManager) {
+		startupPhase.begin("Session restore");
+
 		restoreSession(window, m_restoreManager->restoreData());
 
+		startupPhase.finish();
+	}
+
 	// Check for update
 	Updater* updater{new Updater(window)};
 	Q_UNUSED(updater);
@@ -397,12 +466,16 @@ Application::~Application()
 	delete m_plugins;
 	delete m_cookieJar;
 	delete m_downloadManager;
+	delete m_closedTabsManager;
 }
 
 void Application::loadSettings()
 {
 	Settings settings;
 
+	// Values read on hot paths and from other threads
+	SettingsSnapshot::rebuild();
+
 	// General Sielo settings
 	m_fullyLoadThemes = settings.value("Settings/fullyLoadThemes", true).toBool();
 	m_showFloatingButton = settings.value("Settings/showFloatingButton", false).toBool();
@@ -432,11 +505,41 @@ void Application::loadSettings()
 	if (m_autoFill)
 		m_autoFill->loadSettings();
 
-	loadWebSettings();
-	loadApplicationSettings();
-	loadThemesSettings();
-	loadPluginsSettings();
-	loadTranslationSettings();
+	if (m_tabLifecycleManager)
+		m_tabLifecycleManager->loadSettings();
+
+	if (m_hostInfoCache)
+		m_hostInfoCache->loadSettings();
+
+	if (m_speculativeLoader)
+		m_speculativeLoader->loadSettings();
+
+	if (m_thumbnailService)
+		m_thumbnailService->loadSettings();
+
+	if (m_downloadEngine)
+		m_downloadEngine->loadSettings();
+
+	{
+		SN_TRACE_SCOPE("Application::loadWebSettings");
+		loadWebSettings();
+	}
+	{
+		SN_TRACE_SCOPE("Application::loadApplicationSettings");
+		loadApplicationSettings();
+	}
+	{
+		SN_TRACE_SCOPE("Application::loadThemesSettings");
+		loadThemesSettings();
+	}
+	{
+		SN_TRACE_SCOPE("Application::loadPluginsSettings");
+		loadPluginsSettings();
+	}
+	{
+		SN_TRACE_SCOPE("Application::loadTranslationSettings");
+		loadTranslationSettings();
+	}
 }
 
 void Application::loadWebSettings()
@@ -573,17 +676,10 @@ void Application::loadThemesSettings()
 				QDir(defaultThemePath + "/white-flat").removeRecursively();
 				QDir(defaultThemePath + "/yellow-flat").removeRecursively();
 
-				loadThemeFromResources("sielo-default", false);
 				settings.setValue("Themes/currentTheme", QLatin1String("sielo-default"));
 			}
 
-			loadThemeFromResources("firefox-like-light", false);
-			loadThemeFromResources("firefox-like-dark", false);
-			loadThemeFromResources("sielo-flat", false);
-			loadThemeFromResources("round-theme", false);
-			loadThemeFromResources("ColorZilla", false);
-			loadThemeFromResources("sielo-default", false);
-			settings.setValue("Themes/defaultThemeVersion", 56);
+			extractBundledThemes(settings.value("Themes/currentTheme", QLatin1String("sielo-default")).toString(), 56);
 		}
 
 		loadTheme(settings.value("Themes/currentTheme", QLatin1String("sielo-default")).toString(),
@@ -591,14 +687,8 @@ void Application::loadThemesSettings()
 
 	}
 	else {
-		loadThemeFromResources("firefox-like-light", false);
-		loadThemeFromResources("firefox-like-dark", false);
-		loadThemeFromResources("sielo-flat", false);
-		loadThemeFromResources("round-theme", false);
-		loadThemeFromResources("ColorZilla", false);
-		loadThemeFromResources();
-
-		settings.setValue("Themes/defaultThemeVersion", 56);
+		extractBundledThemes(QLatin1String("sielo-default"), 56);
+		loadTheme(QLatin1String("sielo-default"));
 	}
 }
 
@@ -610,16 +700,23 @@ void Application::loadPluginsSettings()
 	QString pluginsPath{DataPaths::currentProfilePath() + "/plugins"};
 	QString dataPluginsPath{":/plugins/data/plugins/"};
 
-	if (pluginsVersion < 6) {
+	if (pluginsVersion < 6 && !m_initScheduler->contains(QStringLiteral("Plugin extraction"))) {
+		m_initScheduler->addTask(QStringLiteral("Plugin extraction"), InitScheduler::WorkerThread,
+								 [this, pluginsPath, dataPluginsPath]()
+								 {
 #if defined(Q_OS_WIN)
-		copyPath(QDir(dataPluginsPath + "/windows").absolutePath(), pluginsPath);
-#elif defined(Q_OS_MACOS) 
-		copyPath(QDir(dataPluginsPath + "/macos").absolutePath(), pluginsPath);
-#else 
-		copyPath(QDir(dataPluginsPath + "/linux").absolutePath(), pluginsPath);
+									 copyPath(QDir(dataPluginsPath + "/windows").absolutePath(), pluginsPath);
+#elif defined(Q_OS_MACOS)
+									 copyPath(QDir(dataPluginsPath + "/macos").absolutePath(), pluginsPath);
+#else
+									 copyPath(QDir(dataPluginsPath + "/linux").absolutePath(), pluginsPath);
 #endif
-
-		settings.setValue("Plugin-Settings/pluginsVersion", 6);
+								 });
+		m_initScheduler->addTask(QStringLiteral("Plugin extraction version"), InitScheduler::GuiThread, []()
+		{
+			Settings settings{};
+			settings.setValue("Plugin-Settings/pluginsVersion", 6);
+		}, QStringList(QStringLiteral("Plugin extraction")));
 	}
 }
 
@@ -628,10 +725,20 @@ void Application::loadTranslationSettings()
 	Settings settings{};
 	settings.beginGroup("Language");
 
-	if (settings.value("version", 0).toInt() < 18) {
-		QDir(DataPaths::currentProfilePath() + "/locale").removeRecursively();
-		copyPath(QDir(":data/locale").absolutePath(), DataPaths::currentProfilePath() + "/locale");
-		settings.setValue("version", 18);
+	if (settings.value("version", 0).toInt() < 18 && !m_initScheduler->contains(QStringLiteral("Translation extraction"))) {
+		const QString localePath{DataPaths::currentProfilePath() + "/locale"};
+
+		m_initScheduler->addTask(QStringLiteral("Translation extraction"), InitScheduler::WorkerThread,
+								 [this, localePath]()
+								 {
+									 QDir(localePath).removeRecursively();
+									 copyPath(QDir(":data/locale").absolutePath(), localePath);
+								 });
+		m_initScheduler->addTask(QStringLiteral("Translation extraction version"), InitScheduler::GuiThread, []()
+		{
+			Settings settings{};
+			settings.setValue("Language/version", 18);
+		}, QStringList(QStringLiteral("Translation extraction")));
 	}
 }
 
@@ -668,6 +775,8 @@ void Application::updateToProfiles()
 
 void Application::translateApplication()
 {
+	m_initScheduler->waitFor(QStringLiteral("Translation extraction"));
+
 	Settings settings{};
 	QString file{settings.value("Language/language", QLocale::system().name()).toString()};
 
@@ -862,8 +971,10 @@ void Application::saveSettings()
 
 	bool deleteCookies{settings.value("Cookie-Settings/deleteCookiesOnClose", false).toBool()};
 
-	if (deleteHistory)
+	if (deleteHistory) {
 		m_history->clearHistory();
+		thumbnailService()->clear();
+	}
 	if (deleteCookies)
 		m_cookieJar->deleteAllCookies();
 
@@ -877,6 +988,8 @@ void Application::saveSession(bool saveForHome)
 	if (m_privateBrowsing || m_isRestoring || m_windows.count() == 0 || m_restoreManager)
 		return;
 
+	ScopedTiming timing{Metrics::SessionSave};
+
 	QByteArray data{};
 	QDataStream stream{&data, QIODevice::WriteOnly};
 
@@ -925,12 +1038,42 @@ void Application::quitApplication()
 
 void Application::postLaunch()
 {
+	SN_TRACE_SCOPE("Application::postLaunch");
+
 	// Check if we want to open a new tab
 	if (m_postLaunchActions.contains(OpenNewTab))
 		getWindow()->tabWidget()->addView(QUrl(), Application::NTT_SelectedNewEmptyTab);
 
 	connect(this, &Application::receivedMessage, this, &Application::messageReceived);
 	connect(this, &Application::aboutToQuit, this, &Application::saveSettings);
+
+	// In case the first window is never painted, like when started minimized
+	QTimer::singleShot(3 * 1000, m_initScheduler, &InitScheduler::releaseDeferred);
+
+#ifdef SIELO_TRACING
+	// The trace covers the first paint and the deferred tasks it releases
+	if (!m_traceFile.isEmpty()) {
+		if (m_initScheduler->isIdle())
+			writeStartupTrace();
+		else
+			connect(m_initScheduler, &InitScheduler::idle, this, &Application::writeStartupTrace);
+	}
+#endif
+}
+
+void Application::writeStartupTrace()
+{
+#ifdef SIELO_TRACING
+	disconnect(m_initScheduler, &InitScheduler::idle, this, &Application::writeStartupTrace);
+
+	if (!Trace::isEnabled())
+		return;
+
+	if (!Trace::writeJson(m_traceFile))
+		qWarning() << "Unable to write the startup trace to" << m_traceFile;
+
+	Trace::setEnabled(false);
+#endif
 }
 
 void Application::windowDestroyed(QObject* window)
@@ -1083,6 +1226,25 @@ DownloadManager *Application::downloadManager()
 	return m_downloadManager;
 }
 
+ClosedTabsManager *Application::closedTabsManager()
+{
+	if (!m_closedTabsManager)
+		m_closedTabsManager = new ClosedTabsManager();
+
+	return m_closedTabsManager;
+}
+
+DownloadEngine *Application::downloadEngine()
+{
+	if (!m_downloadEngine) {
+		// Private browsing opens the database read only
+		m_downloadEngine = new DownloadEngine(networkManager(), !privateBrowsing(), this);
+		m_downloadEngine->setUserAgent(webProfile()->httpUserAgent().toUtf8());
+	}
+
+	return m_downloadEngine;
+}
+
 HTML5PermissionsManager *Application::permissionsManager()
 {
 	if (!m_permissionsManager)
@@ -1091,6 +1253,38 @@ HTML5PermissionsManager *Application::permissionsManager()
 	return m_permissionsManager;
 }
 
+TabLifecycleManager *Application::tabLifecycleManager()
+{
+	if (!m_tabLifecycleManager)
+		m_tabLifecycleManager = new TabLifecycleManager(this);
+
+	return m_tabLifecycleManager;
+}
+
+HostInfoCache *Application::hostInfoCache()
+{
+	if (!m_hostInfoCache)
+		m_hostInfoCache = new HostInfoCache(this);
+
+	return m_hostInfoCache;
+}
+
+SpeculativeLoader *Application::speculativeLoader()
+{
+	if (!m_speculativeLoader)
+		m_speculativeLoader = new SpeculativeLoader(this);
+
+	return m_speculativeLoader;
+}
+
+ThumbnailService *Application::thumbnailService()
+{
+	if (!m_thumbnailService)
+		m_thumbnailService = new ThumbnailService(this);
+
+	return m_thumbnailService;
+}
+
 void Application::startAfterCrash()
 {
 	QMessageBox requestAction{};
@@ -1259,8 +1453,13 @@ void Application::startPrivateBrowsing(const QUrl& startUrl)
 
 void Application::loadTheme(const QString& name, const QString& lightness)
 {
+	// The deferred extraction removes and copies the directory of this theme
+	if (m_extractingThemes.contains(name)) {
+		m_initScheduler->waitFor(QStringLiteral("Theme extraction"));
+		m_extractingThemes.clear();
+	}
+
 	QString activeThemePath{DataPaths::currentProfilePath() + "/themes" + QLatin1Char('/') + name};
-	QString sss{readFile(activeThemePath + QLatin1String("/main.sss"))};
 
 	// If the theme use user color API
 	if (QDir(activeThemePath + "/dark").exists() && QDir(activeThemePath + "/light").exists()) {
@@ -1272,22 +1471,11 @@ void Application::loadTheme(const QString& name, const QString& lightness)
 		QIcon::setThemeName(name);
 	}
 
-	// Load specific theme file for the current OS
+	// Main and OS specific theme files, compiled or taken from the theme cache
 	if (m_fullyLoadThemes) {
-#if defined(Q_OS_MAC)
-		sss.append(readFile(activeThemePath + QLatin1String("/mac.sss")));
-#elif defined(Q_OS_LINUX)
-		sss.append(readFile(activeThemePath + QLatin1String("/linux.sss")));
-#elif defined(Q_OS_WIN)
-		sss.append(readFile(activeThemePath + QLatin1String("/windows.sss")));
-#endif
-
-		QString relativePath{QDir::current().relativeFilePath(activeThemePath)};
+		ThemeCompiler compiler{activeThemePath, lightness};
 
-		sss = parseSSS(sss, relativePath, lightness);
-		//		sss.replace(RegExp(QStringLiteral("scolor\\s*\\(\\s*main\\s*(\\s*,\\s*)\b([0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])\b\\s*(,\\s*normal))\\s*\\)")), "testeee");
-
-		setStyleSheet(sss);
+		setStyleSheet(compiler.styleSheet());
 	}
 	else {
 		setStyleSheet("");
@@ -1299,66 +1487,38 @@ void Application::loadTheme(const QString& name, const QString& lightness)
 
 QString Application::parseSSS(QString& sss, const QString& relativePath, const QString& lightness)
 {
-	// Replace url with absolute path
-	sss.replace(RegExp(QStringLiteral("url\\s*\\(\\s*([^\\*:\\);]+)\\s*\\)")),
-				QString("url(%1/\\1)").arg(relativePath));
-
-	// Replace some Sielo API properties to Qt properties
-	sss.replace("sproperty", "qproperty");
-	sss.replace("slineargradient", "qlineargradient");
-
-	// Replace sbackground with a blured background 
-	sss = parseSSSBackground(sss, relativePath);
+	ThemeCompiler::Context context{};
+	context.relativePath = relativePath;
+	context.lightness = lightness;
+	context.backgroundPath = getBlurredBackgroundPath("images/background.png", 10);
+	context.colors = ThemeCompiler::userColors();
 
-	// Replace theme colors to user colors
-	sss = parseSSSColor(sss, lightness);
+	sss = ThemeCompiler::compile(sss, context);
 
 	return sss;
 }
 
 QString Application::parseSSSBackground(QString& sss, const QString& relativePath)
 {
-	QString bluredBackgroundPath = getBlurredBackgroundPath("images/background.png", 15);
+	Q_UNUSED(relativePath);
 
-	if (bluredBackgroundPath.isEmpty())
-		sss.replace(RegExp(";\\s*\\background\\s*\\:\\s*\\sbackground\\s*\\;"), "");
-	else
-		sss.replace("sbackground()", "url(" + bluredBackgroundPath + ")");
+	ThemeCompiler::Context context{};
+	context.backgroundPath = getBlurredBackgroundPath("images/background.png", 10);
+	context.substitutions = ThemeCompiler::Background;
 
-	std::string strSss = sss.toStdString();
+	sss = ThemeCompiler::compile(sss, context);
 
 	return sss;
 }
 
 QString Application::parseSSSColor(QString& sss, const QString& lightness)
 {
-	sss.replace(RegExp(QStringLiteral(
-		"scolor\\s*\\(\\s*(main|second|accent|text)\\s*,\\s*(normal|light|dark)\\s*,\\s*([01]?[0-9]?[0-9]|2[0-4][0-9]|25[0-5])\\s*\\)"
-	)),
-		"rgba($color\\1\\2, \\3\\4)");
-	sss.replace(
-		RegExp(QStringLiteral(
-		"scolor\\s*\\(\\s*(main|second|accent|text)\\s*,\\s*(normal|light|dark)\\s*\\)")),
-		"rgba($color\\1\\2, 255)");
-	sss.replace(RegExp(QStringLiteral("scolor\\s*\\(\\s*(main|second|accent|text)\\s*\\)")),
-				"rgba($color\\1normal, 255)");
-
-	sss.replace(QLatin1String("\\4"), "");
-
-	sss.replace("$colormainlight", AppearancePage::colorString("mainlight"));
-	sss.replace("$colormaindark", AppearancePage::colorString("maindark"));
-	sss.replace("$colormainnormal", AppearancePage::colorString("mainnormal"));
-	sss.replace("$colorsecondlight", AppearancePage::colorString("secondlight"));
-	sss.replace("$colorseconddark", AppearancePage::colorString("seconddark"));
-	sss.replace("$colorsecondnormal", AppearancePage::colorString("secondnormal"));
-	sss.replace("$coloraccentlight", AppearancePage::colorString("accentlight"));
-	sss.replace("$coloraccentdark", AppearancePage::colorString("accentdark"));
-	sss.replace("$coloraccentnormal", AppearancePage::colorString("accentnormal"));
-	sss.replace("$colortextlight", AppearancePage::colorString("textlight"));
-	sss.replace("$colortextdark", AppearancePage::colorString("textdark"));
-	sss.replace("$colortextnormal", AppearancePage::colorString("textnormal"));
-
-	sss.replace("$ulightness", lightness);
+	ThemeCompiler::Context context{};
+	context.lightness = lightness;
+	context.colors = ThemeCompiler::userColors();
+	context.substitutions = ThemeCompiler::Colors;
+
+	sss = ThemeCompiler::compile(sss, context);
 
 	return sss;
 }
@@ -1372,14 +1532,7 @@ QString Application::getBlurredBackgroundPath(const QString& defaultBackground,
 	if (!QFile::exists(backgroundPath))
 		return QString();
 
-	QImage backgroundImage{backgroundPath};
-	QPixmap output = QPixmap::fromImage(blurImage(backgroundImage, backgroundImage.rect(), 10));
-
-	QFile file{DataPaths::currentProfilePath() + "/themes" + QLatin1String("/bluredBackground.png")};
-	file.open(QIODevice::WriteOnly);
-	output.save(&file, "PNG");
-
-	return file.fileName();
+	return BackgroundCompositor::instance()->blurredImagePath(backgroundPath, radius);
 }
 
 QImage Application::blurImage(const QImage& image, const QRect& rect, int radius, bool alphaOnly)
@@ -1466,6 +1619,63 @@ void Application::loadThemeFromResources(QString name, bool loadAtEnd)
 		loadTheme(name);
 }
 
+void Application::extractBundledThemes(const QString& currentTheme, int themesVersion)
+{
+	const QStringList bundledThemes{
+		QStringLiteral("firefox-like-light"), QStringLiteral("firefox-like-dark"), QStringLiteral("sielo-flat"),
+		QStringLiteral("round-theme"), QStringLiteral("ColorZilla"), QStringLiteral("sielo-default")
+	};
+
+	// An extraction still running would race with this one
+	m_initScheduler->waitFor(QStringLiteral("Theme extraction version"));
+
+	// The current theme is loaded right after, only the other ones can wait for the first window
+	QStringList otherThemes{bundledThemes};
+
+	if (otherThemes.removeOne(currentTheme))
+		loadThemeFromResources(currentTheme, false);
+
+	if (m_initScheduler->contains(QStringLiteral("Theme extraction")))
+		return;
+
+	m_extractingThemes = otherThemes;
+
+	m_initScheduler->addTask(QStringLiteral("Theme extraction"), InitScheduler::WorkerThread, [this, otherThemes]()
+	{
+		foreach (const QString& theme, otherThemes) loadThemeFromResources(theme, false);
+	}, QStringList(), InitScheduler::Deferred);
+	m_initScheduler->addTask(QStringLiteral("Theme extraction version"), InitScheduler::GuiThread, [themesVersion]()
+	{
+		Settings settings{};
+		settings.setValue("Themes/defaultThemeVersion", themesVersion);
+	}, QStringList(QStringLiteral("Theme extraction")), InitScheduler::Deferred);
+}
+
+void Application::firstWindowPainted()
+{
+	const qint64 elapsed{m_startupTimer.elapsed()};
+
+	Metrics::recordStartupPhase(QStringLiteral("Time to first paint"), elapsed);
+
+#ifdef SIELO_TRACING
+	if (Trace::isEnabled())
+		Trace::addSpan("Time to first paint", 0, elapsed * 1000);
+#endif
+
+	m_initScheduler->releaseDeferred();
+}
+
+bool Application::eventFilter(QObject* watched, QEvent* event)
+{
+	// The first window is only watched until its first backing store flush
+	if (event->type() == QEvent::UpdateRequest) {
+		watched->removeEventFilter(this);
+		QTimer::singleShot(0, this, &Application::firstWindowPainted);
+	}
+
+	return SingleApplication::eventFilter(watched, event);
+}
+
 bool Application::copyPath(const QString& fromDir, const QString& toDir, bool coverFileIfExist)
 {
 	QDir sourceDir(fromDir);
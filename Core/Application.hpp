@@ -34,11 +34,13 @@
 #include <QPointer>
 
 #include <QFont>
+#include <QElapsedTimer>
 
 #include "3rdparty/SingleApplication/singleapplication.h"
 #include "3rdparty/Piwik/piwiktracker.h"
 
 #include <QWebEngine/WebProfile.hpp>
+#include <QWebEngine/UrlSchemeHandler.hpp>
 #include <QWebEngine/DownloadItem.hpp>
 
 namespace Sn
@@ -50,7 +52,14 @@ class History;
 class Bookmarks;
 class MaquetteGrid;
 class DownloadManager;
+class ClosedTabsManager;
+class DownloadEngine;
 class HTML5PermissionsManager;
+class TabLifecycleManager;
+class HostInfoCache;
+class SpeculativeLoader;
+class ThumbnailService;
+class InitScheduler;
 class NetworkManager;
 
 class SideBarInterface;
@@ -94,6 +103,8 @@ public:
 		/*!< We want to open a new private browsing window */
 		CL_StartNewInstance,
 		/*!< We want to start a new instance of Sielo */
+		CL_TraceStartup,
+		/*!< We want to write a trace of the startup in a file */
 		CL_ExitAction /*!< We want to close Sielo */
 	};
 
@@ -240,11 +251,19 @@ public:
 	Bookmarks *bookmarks();
 	MaquetteGrid *maquetteGrid();
 	DownloadManager *downloadManager();
+	ClosedTabsManager *closedTabsManager();
+	DownloadEngine *downloadEngine();
 	HTML5PermissionsManager *permissionsManager();
+	TabLifecycleManager *tabLifecycleManager();
+	HostInfoCache *hostInfoCache();
+	SpeculativeLoader *speculativeLoader();
+	ThumbnailService *thumbnailService();
 	NetworkManager *networkManager() const { return m_networkManager; }
 	RestoreManager *restoreManager() const { return m_restoreManager; }
+	InitScheduler *initScheduler() const { return m_initScheduler; }
 
 	Engine::WebProfile *webProfile();
+	Engine::UrlSchemeHandler *schemeHandler() const { return m_schemeHandler; }
 
 	PiwikTracker *piwikTraker() { return m_piwikTracker; }
 
@@ -285,6 +304,9 @@ public:
 signals:
 	void activeWindowChanged(BrowserWindow* window);
 
+protected:
+	bool eventFilter(QObject* watched, QEvent* event) override;
+
 public slots:
 	/*!
 	 * Add a new tab to the current tabs space.
@@ -328,6 +350,9 @@ private:
 	void setUserStyleSheet(const QString& filePath);
 
 	void loadThemeFromResources(QString name = "sielo-default", bool loadAtEnd = true);
+	void extractBundledThemes(const QString& currentTheme, int themesVersion);
+	void firstWindowPainted();
+	void writeStartupTrace();
 
 	QString m_languageFile{};
 
@@ -353,10 +378,24 @@ private:
 	Bookmarks* m_bookmarks{nullptr};
 	MaquetteGrid* m_maquetteGrid{nullptr};
 	DownloadManager* m_downloadManager{nullptr};
+	ClosedTabsManager* m_closedTabsManager{nullptr};
+	DownloadEngine* m_downloadEngine{nullptr};
 	HTML5PermissionsManager* m_permissionsManager{nullptr};
+	TabLifecycleManager* m_tabLifecycleManager{nullptr};
+	HostInfoCache* m_hostInfoCache{nullptr};
+	SpeculativeLoader* m_speculativeLoader{nullptr};
+	ThumbnailService* m_thumbnailService{nullptr};
 
 	NetworkManager* m_networkManager{nullptr};
 	Engine::WebProfile* m_webProfile{nullptr};
+	Engine::UrlSchemeHandler* m_schemeHandler{nullptr};
+
+	QString m_traceFile{};
+	// Bundled themes extracted by a deferred worker task
+	QStringList m_extractingThemes{};
+
+	InitScheduler* m_initScheduler{nullptr};
+	QElapsedTimer m_startupTimer{};
 
 	RestoreManager* m_restoreManager{nullptr};
 
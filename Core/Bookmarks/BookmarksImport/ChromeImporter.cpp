@@ -27,9 +27,7 @@
 #include <QDir>
 #include <QFileDialog>
 
-#include <QJsonDocument>
-
-#include <QVariant>
+#include <cctype>
 
 #include "Bookmarks/BookmarkItem.hpp"
 
@@ -84,62 +82,344 @@ bool ChromeImporter::prepareImport()
 
 BookmarkItem *ChromeImporter::importBookmarks()
 {
-	const QByteArray data{m_file.readAll()};
-	m_file.close();
+	m_buffer.clear();
+	m_position = 0;
+	m_parseError = false;
+
+	BookmarkItem* root{new BookmarkItem(BookmarkItem::Folder)};
+	root->setTitle("Chrome Import");
+
+	// The file is read as a stream: only the "roots" object is walked, every other value is skipped without
+	// being materialized
+	if (expect('{')) {
+		while (!m_parseError && peek() != '}') {
+			const QString key{readString()};
+
+			if (!expect(':'))
+				break;
 
-	QJsonParseError err{};
-	QJsonDocument json{QJsonDocument::fromJson(data, &err)};
-	const QVariant res{json.toVariant()};
+			if (key == QLatin1String("roots"))
+				readRoots(root);
+			else
+				skipValue();
 
-	if (err.error != QJsonParseError::NoError || res.type() != QVariant::Map) {
+			if (peek() == ',')
+				takeByte();
+		}
+
+		expect('}');
+	}
+
+	m_buffer.clear();
+	m_file.close();
+
+	if (m_parseError) {
+		delete root;
 		setError(BookmarksImporter::tr("Cannot parse JSON file!"));
 		return nullptr;
 	}
 
-	QVariantMap rootMap{res.toMap().value("roots").toMap()};
+	return root;
+}
+
+void ChromeImporter::readRoots(BookmarkItem* root)
+{
+	if (!expect('{'))
+		return;
 
-	BookmarkItem* root{new BookmarkItem(BookmarkItem::Folder)};
-	root->setTitle("Chrome Import");
+	while (!m_parseError && peek() != '}') {
+		const QString key{readString()};
 
-	BookmarkItem* toolbar{new BookmarkItem(BookmarkItem::Folder, root)};
-	toolbar->setTitle(rootMap.value("bookmark_bar").toMap().value("name").toString());
-	readBookmarks(rootMap.value("bookmark_bar").toMap().value("children").toList(), toolbar);
+		if (!expect(':'))
+			return;
 
-	BookmarkItem* other{new BookmarkItem(BookmarkItem::Folder, root)};
-	other->setTitle(rootMap.value("other").toMap().value("name").toString());
-	readBookmarks(rootMap.value("other").toMap().value("children").toList(), other);
+		if (key == QLatin1String("bookmark_bar") || key == QLatin1String("other") || key == QLatin1String("synced")) {
+			BookmarkItem* folder{readNode()};
 
-	BookmarkItem* synced{new BookmarkItem(BookmarkItem::Folder, root)};
-	synced->setTitle(rootMap.value("synced").toMap().value("name").toString());
-	readBookmarks(rootMap.value("synced").toMap().value("synced").toList(), other);
+			if (folder) {
+				folder->setType(BookmarkItem::Folder);
+				root->addChild(folder);
+			}
+		}
+		else {
+			skipValue();
+		}
 
-	return root;
+		if (peek() == ',')
+			takeByte();
+	}
+
+	expect('}');
 }
 
-void ChromeImporter::readBookmarks(const QVariantList& list, BookmarkItem* parent)
+BookmarkItem* ChromeImporter::readNode()
 {
-	Q_ASSERT(parent);
+	if (!expect('{'))
+		return nullptr;
+
+	// Chrome writes "children" before "type", so children are collected first and attached once the node type is
+	// known
+	QString type{};
+	QString name{};
+	QByteArray url{};
+	QList<BookmarkItem*> children{};
 
-	foreach(const QVariant &entry, list) {
-		const QVariantMap map{entry.toMap()};
-		const QString typeString{map.value("type").toString()};
-		BookmarkItem::Type type{};
+	while (!m_parseError && peek() != '}') {
+		const QString key{readString()};
 
-		if (typeString == QLatin1String("url"))
-			type = BookmarkItem::Url;
-		else if (typeString == QLatin1String("folder"))
-			type = BookmarkItem::Folder;
+		if (!expect(':'))
+			break;
+
+		if (key == QLatin1String("type"))
+			type = readString();
+		else if (key == QLatin1String("name"))
+			name = readString();
+		else if (key == QLatin1String("url"))
+			url = readString().toUtf8();
+		else if (key == QLatin1String("children"))
+			readChildren(children);
 		else
+			skipValue();
+
+		if (peek() == ',')
+			takeByte();
+	}
+
+	expect('}');
+
+	BookmarkItem::Type itemType{BookmarkItem::Invalid};
+
+	if (type == QLatin1String("url"))
+		itemType = BookmarkItem::Url;
+	else if (type == QLatin1String("folder"))
+		itemType = BookmarkItem::Folder;
+
+	if (m_parseError || itemType == BookmarkItem::Invalid) {
+		qDeleteAll(children);
+		return nullptr;
+	}
+
+	BookmarkItem* item{new BookmarkItem(itemType)};
+	item->setTitle(name);
+
+	if (item->isUrl())
+		item->setUrl(QUrl::fromEncoded(url));
+
+	foreach(BookmarkItem* child, children)
+		item->addChild(child);
+
+	return item;
+}
+
+void ChromeImporter::readChildren(QList<BookmarkItem*>& children)
+{
+	if (!expect('['))
+		return;
+
+	while (!m_parseError && peek() != ']') {
+		BookmarkItem* child{readNode()};
+
+		if (child)
+			children.append(child);
+
+		if (peek() == ',')
+			takeByte();
+	}
+
+	expect(']');
+}
+
+QString ChromeImporter::readString()
+{
+	if (!expect('"'))
+		return QString();
+
+	QByteArray bytes{};
+
+	while (!m_parseError) {
+		if (!fillBuffer()) {
+			m_parseError = true;
+			break;
+		}
+
+		const char c{takeByte()};
+
+		if (c == '"')
+			break;
+
+		if (c != '\\') {
+			bytes.append(c);
 			continue;
+		}
+
+		if (!fillBuffer()) {
+			m_parseError = true;
+			break;
+		}
+
+		const char escaped{takeByte()};
+
+		switch (escaped) {
+		case 'b':
+			bytes.append('\b');
+			break;
+		case 'f':
+			bytes.append('\f');
+			break;
+		case 'n':
+			bytes.append('\n');
+			break;
+		case 'r':
+			bytes.append('\r');
+			break;
+		case 't':
+			bytes.append('\t');
+			break;
+		case 'u': {
+			ushort unit{readHexUnit()};
+			QString character{QChar(unit)};
 
-		BookmarkItem* item{new BookmarkItem(type, parent)};
-		item->setTitle(map.value("name").toString());
+			// Characters outside of the BMP are written as an escaped surrogate pair
+			if (QChar::isHighSurrogate(unit) && peekRaw() == '\\') {
+				takeByte();
 
-		if (item->isUrl())
-			item->setUrl(QUrl::fromEncoded(map.value("url").toByteArray()));
+				if (takeByte() == 'u')
+					character.append(QChar(readHexUnit()));
+				else
+					m_parseError = true;
+			}
 
-		if (map.contains("children"))
-			readBookmarks(map.value("children").toList(), item);
+			bytes.append(character.toUtf8());
+			break;
+		}
+		default:
+			bytes.append(escaped);
+			break;
+		}
 	}
+
+	return QString::fromUtf8(bytes);
+}
+
+ushort ChromeImporter::readHexUnit()
+{
+	ushort unit{0};
+
+	for (int i{0}; i < 4; ++i) {
+		if (!fillBuffer()) {
+			m_parseError = true;
+			return 0;
+		}
+
+		const char c{takeByte()};
+		int value{-1};
+
+		if (c >= '0' && c <= '9')
+			value = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			value = c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			value = c - 'A' + 10;
+
+		if (value < 0) {
+			m_parseError = true;
+			return 0;
+		}
+
+		unit = static_cast<ushort>(unit * 16 + value);
+	}
+
+	return unit;
+}
+
+void ChromeImporter::skipValue()
+{
+	const char c{peek()};
+
+	if (c == '"') {
+		readString();
+		return;
+	}
+
+	if (c != '{' && c != '[') {
+		// Number, boolean or null literal
+		while (fillBuffer()) {
+			const char current{m_buffer.at(m_position)};
+
+			if (current == ',' || current == '}' || current == ']' || isspace(static_cast<unsigned char>(current)))
+				break;
+
+			++m_position;
+		}
+
+		return;
+	}
+
+	// Objects and arrays are skipped by tracking the nesting depth, strings are read to ignore brackets they contain
+	int depth{0};
+
+	while (fillBuffer()) {
+		const char current{m_buffer.at(m_position)};
+
+		if (current == '"') {
+			readString();
+			continue;
+		}
+
+		++m_position;
+
+		if (current == '{' || current == '[')
+			++depth;
+		else if ((current == '}' || current == ']') && --depth == 0)
+			return;
+	}
+
+	m_parseError = true;
+}
+
+bool ChromeImporter::expect(char c)
+{
+	if (peek() != c) {
+		m_parseError = true;
+		return false;
+	}
+
+	takeByte();
+	return true;
+}
+
+char ChromeImporter::peek()
+{
+	while (fillBuffer()) {
+		const char c{m_buffer.at(m_position)};
+
+		if (!isspace(static_cast<unsigned char>(c)))
+			return c;
+
+		++m_position;
+	}
+
+	return '\0';
+}
+
+char ChromeImporter::peekRaw()
+{
+	return fillBuffer() ? m_buffer.at(m_position) : '\0';
+}
+
+char ChromeImporter::takeByte()
+{
+	return fillBuffer() ? m_buffer.at(m_position++) : '\0';
+}
+
+bool ChromeImporter::fillBuffer()
+{
+	if (m_position < m_buffer.size())
+		return true;
+
+	m_buffer = m_file.read(ReadChunkSize);
+	m_position = 0;
+
+	return !m_buffer.isEmpty();
 }
 }
@@ -31,6 +31,8 @@
 #include "BookmarksImporter.hpp"
 
 #include <QFile>
+#include <QByteArray>
+#include <QList>
 
 namespace Sn
 {
@@ -45,15 +47,35 @@ public:
 	QString standardPath() const;
 
 	QString getPath(QWidget* parent);
+	// Imports path without asking the user for it
+	void setPath(const QString& path) { m_path = path; }
 	bool prepareImport();
 
 	BookmarkItem *importBookmarks();
 
 private:
-	void readBookmarks(const QVariantList& list, BookmarkItem* parent);
+	static constexpr int ReadChunkSize = 64 * 1024;
+
+	void readRoots(BookmarkItem* root);
+	BookmarkItem* readNode();
+	void readChildren(QList<BookmarkItem*>& children);
+
+	QString readString();
+	ushort readHexUnit();
+	void skipValue();
+
+	bool expect(char c);
+	char peek();
+	char peekRaw();
+	char takeByte();
+	bool fillBuffer();
 
 	QString m_path{};
 	QFile m_file{};
+
+	QByteArray m_buffer{};
+	int m_position{0};
+	bool m_parseError{false};
 };
 }
 
@@ -26,8 +26,6 @@
 
 #include <QFileDialog>
 
-#include "Utils/RegExp.hpp"
-
 #include "Bookmarks/BookmarkItem.hpp"
 
 namespace Sn
@@ -76,96 +74,195 @@ bool HtmlImporter::prepareImport()
 
 BookmarkItem *HtmlImporter::importBookmarks()
 {
-	QString bookmarks = QString::fromUtf8(m_file.readAll());
-	m_file.close();
-
-	bookmarks.replace(QLatin1String("<DL"), QLatin1String("<dl"));
-	bookmarks.replace(QLatin1String("</DL"), QLatin1String("</dl"));
-	bookmarks.replace(QLatin1String("<DT"), QLatin1String("<dt"));
-	bookmarks.replace(QLatin1String("</DT"), QLatin1String("</dt"));
-	bookmarks.replace(QLatin1String("<P"), QLatin1String("<p"));
-	bookmarks.replace(QLatin1String("</P"), QLatin1String("</p"));
-	bookmarks.replace(QLatin1String("<A"), QLatin1String("<a"));
-	bookmarks.replace(QLatin1String("</A"), QLatin1String("</a"));
-	bookmarks.replace(QLatin1String("HREF="), QLatin1String("href="));
-	bookmarks.replace(QLatin1String("<H3"), QLatin1String("<h3"));
-	bookmarks.replace(QLatin1String("</H3"), QLatin1String("</h3"));
-
-	bookmarks = bookmarks.left(bookmarks.lastIndexOf(QLatin1String("</dl><p>")));
-	int start{bookmarks.indexOf(QLatin1String("<dl><p>"))};
+	m_stream.setDevice(&m_file);
+	m_stream.setCodec("UTF-8");
+	m_buffer.clear();
+	m_position = 0;
 
 	BookmarkItem* root{new BookmarkItem(BookmarkItem::Folder)};
 	root->setTitle("HTML Import");
 
+	// Netscape bookmark files describe a folder as <dt><h3>Title</h3> followed by its <dl> list, so a folder is
+	// only pushed on the stack once its list is opened. Items are added to a detached tree which is inserted in
+	// the bookmarks model in one go by the import dialog.
 	QList<BookmarkItem*> folders{};
-	folders.append(root);
-
-	while (start > 0) {
-		QString string{bookmarks.mid(start)};
-
-		int posOfFolder{string.indexOf(QLatin1String("<dt><h3"))};
-		int posOfEndFolder{string.indexOf(QLatin1String("</dl><p>"))};
-		int posOfLink{string.indexOf(QLatin1String("<dt><a"))};
-		int nearest{snMin(posOfLink, snMin(posOfFolder, posOfEndFolder))};
+	BookmarkItem* pendingFolder{nullptr};
+	Token token{};
 
-		if (nearest == -1)
-			break;
+	while (readToken(token)) {
+		if (token.type == EndTag) {
+			if (token.name == QLatin1String("dl") && !folders.isEmpty())
+				folders.removeLast();
 
-		if (nearest == posOfFolder) {
-			RegExp rx("<dt><h3(.*)>(.*)</h3>");
-			rx.setMinimal(true);
-			rx.indexIn(string);
+			continue;
+		}
 
-			QString folderName{rx.capture(2).trimmed()};
-			BookmarkItem* folder{new BookmarkItem(BookmarkItem::Folder, folders.isEmpty() ? root : folders.last())};
+		if (token.type != StartTag)
+			continue;
 
-			folder->setTitle(folderName);
-			folders.append(folder);
+		BookmarkItem* parent{folders.isEmpty() ? root : folders.last()};
 
-			start += posOfFolder + rx.capture(0).size();
+		if (token.name == QLatin1String("dl")) {
+			folders.append(pendingFolder ? pendingFolder : parent);
+			pendingFolder = nullptr;
 		}
-		else if (nearest == posOfEndFolder) {
-			if (!folders.isEmpty())
-				folders.removeLast();
+		else if (token.name == QLatin1String("h3")) {
+			BookmarkItem* folder{new BookmarkItem(BookmarkItem::Folder, parent)};
+			folder->setTitle(readText(QLatin1String("h3")));
 
-			start += posOfEndFolder + 8;
+			pendingFolder = folder;
 		}
-		else {
-			RegExp rx{ "<dt><a(.*)>(.*)</a>" };
-			rx.setMinimal(true);
-			rx.indexIn(string);
-
-			QString arguments{rx.capture(1)};
-			QString linkName{rx.capture(2).trimmed()};
-
-			RegExp rx2("href=\"(.*)\"");
-			rx2.setMinimal(true);
-			rx2.indexIn(arguments);
+		else if (token.name == QLatin1String("a")) {
+			const QUrl url{QUrl::fromEncoded(token.href.trimmed().toUtf8())};
+			const QString linkName{readText(QLatin1String("a"))};
 
-			QUrl url{QUrl::fromEncoded(rx2.capture(1).trimmed().toUtf8())};
-
-			start += posOfLink + rx.capture(0).size();
+			pendingFolder = nullptr;
 
 			if (url.isEmpty() || url.scheme() == QLatin1String("place") || url.scheme() == QLatin1String("about"))
 				continue;
 
-			BookmarkItem* b{new BookmarkItem(BookmarkItem::Url, folders.isEmpty() ? root : folders.last())};
+			BookmarkItem* b{new BookmarkItem(BookmarkItem::Url, parent)};
 			b->setTitle(linkName.isEmpty() ? url.toString() : linkName);
 			b->setUrl(url);
 		}
 	}
 
+	m_stream.setDevice(nullptr);
+	m_buffer.clear();
+	m_file.close();
+
 	return root;
 }
 
-int HtmlImporter::snMin(int a, int b)
+bool HtmlImporter::readToken(Token& token)
 {
-	if (a > -1 && b > -1)
-		return qMin(a, b);
+	token.name.clear();
+	token.href.clear();
+	token.text.clear();
+
+	if (atEnd())
+		return false;
+
+	if (currentChar() != QLatin1Char('<')) {
+		token.type = Text;
+
+		while (!atEnd() && currentChar() != QLatin1Char('<'))
+			token.text.append(takeChar());
+
+		return true;
+	}
+
+	takeChar();
+
+	// Comments, doctype and processing instructions are skipped entirely
+	if (!atEnd() && (currentChar() == QLatin1Char('!') || currentChar() == QLatin1Char('?'))) {
+		token.type = Text;
+
+		QString skipped{};
+		while (!atEnd()) {
+			const QChar c{takeChar()};
+
+			if (c == QLatin1Char('>') && (!skipped.startsWith(QLatin1String("!--")) || skipped.endsWith(QLatin1String("--"))))
+				break;
+
+			skipped.append(c);
+		}
+
+		return true;
+	}
+
+	token.type = StartTag;
+
+	if (!atEnd() && currentChar() == QLatin1Char('/')) {
+		token.type = EndTag;
+		takeChar();
+	}
+
+	while (!atEnd() && currentChar().isLetterOrNumber())
+		token.name.append(takeChar().toLower());
+
+	// Attributes, only "href" is kept
+	while (!atEnd() && currentChar() != QLatin1Char('>')) {
+		if (currentChar().isSpace() || currentChar() == QLatin1Char('/')) {
+			takeChar();
+			continue;
+		}
 
-	if (a > -1)
-		return a;
+		QString attributeName{};
+		while (!atEnd() && !currentChar().isSpace() && currentChar() != QLatin1Char('=')
+			&& currentChar() != QLatin1Char('>'))
+			attributeName.append(takeChar().toLower());
 
-	return b;
+		while (!atEnd() && currentChar().isSpace())
+			takeChar();
+
+		if (atEnd() || currentChar() != QLatin1Char('='))
+			continue;
+
+		takeChar();
+
+		while (!atEnd() && currentChar().isSpace())
+			takeChar();
+
+		QString value{};
+
+		if (!atEnd() && (currentChar() == QLatin1Char('"') || currentChar() == QLatin1Char('\''))) {
+			const QChar quote{takeChar()};
+
+			while (!atEnd() && currentChar() != quote)
+				value.append(takeChar());
+
+			if (!atEnd())
+				takeChar();
+		}
+		else {
+			while (!atEnd() && !currentChar().isSpace() && currentChar() != QLatin1Char('>'))
+				value.append(takeChar());
+		}
+
+		if (attributeName == QLatin1String("href"))
+			token.href = value;
+	}
+
+	if (!atEnd())
+		takeChar();
+
+	return true;
+}
+
+QString HtmlImporter::readText(const QString& endTag)
+{
+	QString text{};
+	Token token{};
+
+	while (readToken(token)) {
+		if (token.type == Text)
+			text.append(token.text);
+		else if (token.type == EndTag && token.name == endTag)
+			break;
+	}
+
+	return text.trimmed();
+}
+
+bool HtmlImporter::atEnd()
+{
+	if (m_position < m_buffer.size())
+		return false;
+
+	m_buffer = m_stream.read(ReadChunkSize);
+	m_position = 0;
+
+	return m_buffer.isEmpty();
+}
+
+QChar HtmlImporter::currentChar() const
+{
+	return m_buffer.at(m_position);
+}
+
+QChar HtmlImporter::takeChar()
+{
+	return m_buffer.at(m_position++);
 }
 }
@@ -32,6 +32,7 @@
 
 #include <QString>
 #include <QFile>
+#include <QTextStream>
 
 namespace Sn
 {
@@ -46,15 +47,41 @@ public:
 	QString standardPath() const;
 
 	QString getPath(QWidget* parent);
+	// Imports path without asking the user for it
+	void setPath(const QString& path) { m_path = path; }
 	bool prepareImport();
 
 	BookmarkItem *importBookmarks();
 
 private:
-	int snMin(int a, int b);
+	enum TokenType {
+		StartTag,
+		EndTag,
+		Text
+	};
+
+	struct Token {
+		TokenType type{Text};
+		QString name{};
+		QString href{};
+		QString text{};
+	};
+
+	static constexpr int ReadChunkSize = 64 * 1024;
+
+	bool readToken(Token& token);
+	QString readText(const QString& endTag);
+
+	bool atEnd();
+	QChar currentChar() const;
+	QChar takeChar();
 
 	QString m_path{};
 	QFile m_file{};
+
+	QTextStream m_stream{};
+	QString m_buffer{};
+	int m_position{0};
 };
 }
 
@@ -37,6 +37,8 @@
 #include <QTimer>
 #include <QMessageBox>
 
+#include <QtConcurrent/QtConcurrentRun>
+
 #include "Bookmarks/BookmarksUtils.hpp"
 #include "Bookmarks/BookmarksToolbar.hpp"
 
@@ -44,13 +46,16 @@
 
 #include "Plugins/PluginProxy.hpp"
 
+#include "Utils/BackgroundCompositor.hpp"
 #include "Utils/DataPaths.hpp"
 #include "Utils/RestoreManager.hpp"
 #include "Utils/Settings.hpp"
+#include "Utils/Trace.hpp"
 
 #include "Web/LoadRequest.hpp"
 #include "Web/WebPage.hpp"
 #include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/PageSnapshotCache.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
 
 #include "Widgets/TitleBar.hpp"
@@ -71,10 +76,6 @@
 
 #endif
 
-QT_BEGIN_NAMESPACE
-extern Q_WIDGETS_EXPORT void qt_blurImage(QPainter *p, QImage &blurImage, qreal radius, bool quality, bool alphaOnly, int transposed = 0);
-QT_END_NAMESPACE
-
 #ifdef Q_OS_WIN
 bool DWMEnabled(void)
 {
@@ -205,7 +206,10 @@ BrowserWindow::BrowserWindow(Application::WindowType type, const QUrl& url) :
 	QMainWindow(nullptr),
 	m_startUrl(url),
 	m_windowType(type),
-	m_backgroundTimer(new QTimer())
+	m_backgroundTimer(new QTimer()),
+	m_backgroundShotTimer(new QTimer(this)),
+	m_blurWatcher(new QFutureWatcher<QImage>(this)),
+	m_pageSnapshotCache(new PageSnapshotCache(this))
 {
 	setAttribute(Qt::WA_DeleteOnClose);
 	setAttribute(Qt::WA_DontCreateNativeAncestors);
@@ -232,6 +236,13 @@ BrowserWindow::BrowserWindow(Application::WindowType type, const QUrl& url) :
 	connect(m_backgroundTimer, &QTimer::timeout, this, &BrowserWindow::loadWallpaperSettings);
 	m_backgroundTimer->start(1000);
 
+	// Resizing fires many events, the background is only shot again once the size is stable
+	m_backgroundShotTimer->setSingleShot(true);
+	m_backgroundShotTimer->setInterval(150);
+
+	connect(m_backgroundShotTimer, &QTimer::timeout, this, &BrowserWindow::shotBackground);
+	connect(m_blurWatcher, &QFutureWatcher<QImage>::finished, this, &BrowserWindow::backgroundBlurred);
+
 	// Just wait some milli seconds before doing some post launch action
 	QTimer::singleShot(10, this, &BrowserWindow::postLaunch);
 }
@@ -272,6 +283,7 @@ void BrowserWindow::loadSettings()
 	}
 
 	m_titleBar->loadSettings();
+	m_pageSnapshotCache->loadSettings();
 	m_bookmarksToolbar->loadSettings();
 	m_tabsSpaceSplitter->loadSettings();
 
@@ -388,12 +400,12 @@ TabWidget *BrowserWindow::tabWidget(int index) const
 
 const QImage *BrowserWindow::background()
 {
-	return m_bg;
+	return m_bg.isNull() ? nullptr : &m_bg;
 }
 
 const QImage *BrowserWindow::processedBackground()
 {
-	return m_blur_bg;
+	return m_blur_bg.isNull() ? nullptr : &m_blur_bg;
 }
 
 void BrowserWindow::setWindowTitle(const QString& title)
@@ -471,62 +483,27 @@ void BrowserWindow::shotBackground()
 	if (m_fButton) m_fButton->hide();
 	m_titleBar->hide();
 
-	QPixmap *bg = new QPixmap(size());
-	render(bg, QPoint(), QRect(0, 0, width(), height()));
-	m_bg = new QImage(bg->toImage());
+	QImage background{size(), QImage::Format_ARGB32_Premultiplied};
+	render(&background, QPoint(), QRect(0, 0, width(), height()));
+	m_bg = background;
+
 	m_tabsSpaceSplitter->show();
 	m_titleBar->show();
 	if (m_fButton) m_fButton->show();
-	m_blur_bg = new QImage(applyBlur(m_bg, m_blur_radius));
-}
-
-QImage BrowserWindow::applyBlur(const QImage *src, qreal radius, bool quality, bool alphaOnly, int transposed)
-{
-	QPixmap ret(src->size());
-	QPainter painter(&ret);
-	{
-		QPixmap big(QSize(src->width() + 2 * radius, src->height() + 2 * radius));
-		QPainter big_painter(&big);
 
-		big_painter.drawImage(QPoint(radius, radius), src->copy());
-
-		{
-			QPixmap	left(QSize(1, big.height())),
-				right(QSize(1, big.height()));
+	// The blur is done by the compositor on a worker thread, a newer shot replaces the pending one
+	const int radius{static_cast<int>(m_blur_radius)};
 
-			QPainter painter_left(&left),
-				painter_right(&right);
-
-			painter_left.drawImage(QPoint(0, radius), src->copy());
-			painter_right.drawImage(QPoint(1 - src->width(), radius), src->copy());
-
-			for (int i = 0; i < radius; i++) {
-				big_painter.drawImage(QPoint(i, 0), left.toImage());
-				big_painter.drawImage(QPoint(radius + src->width() + i, 0), right.toImage());
-			}
-		}
-
-		{
-			QPixmap top(QSize(big.width(), 1)),
-				bottom(QSize(big.width(), 1));
-
-			QPainter painter_top(&top),
-				painter_bottom(&bottom);
-
-			painter_top.drawImage(QPoint(0, -radius), big.toImage());
-			painter_bottom.drawImage(QPoint(0, 1 + radius - big.height()), big.toImage());
-
-			for (int i = 0; i < radius; i++) {
-				big_painter.drawImage(QPoint(0, i), top.toImage());
-				big_painter.drawImage(QPoint(0, radius + src->height() + i), bottom.toImage());
-			}
-		}
+	m_blurWatcher->setFuture(QtConcurrent::run([background, radius]()
+	{
+		return BackgroundCompositor::instance()->blurred(background, radius);
+	}));
+}
 
-		QImage bgImage{big.toImage()};
-		qt_blurImage(&big_painter, bgImage, radius, quality, alphaOnly, transposed);
-		painter.drawImage(QPoint(-radius, -radius), big.toImage());
-	}
-	return ret.toImage();
+void BrowserWindow::backgroundBlurred()
+{
+	m_blur_bg = m_blurWatcher->result();
+	update();
 }
 
 void BrowserWindow::paintEvent(QPaintEvent* event)
@@ -560,7 +537,7 @@ void BrowserWindow::resizeEvent(QResizeEvent* event)
 
 	QMainWindow::resizeEvent(event);
 
-	shotBackground();
+	m_backgroundShotTimer->start();
 }
 
 void BrowserWindow::keyPressEvent(QKeyEvent* event)
@@ -597,6 +574,8 @@ void BrowserWindow::addTab()
 
 void BrowserWindow::postLaunch()
 {
+	SN_TRACE_SCOPE("BrowserWindow::postLaunch");
+
 	bool addTab{true};
 	QUrl startUrl{};
 
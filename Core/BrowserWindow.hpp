@@ -39,6 +39,9 @@
 
 #include <QResizeEvent>
 
+#include <QFutureWatcher>
+#include <QImage>
+
 #include "Widgets/Tab/TabsSpaceSplitter.hpp"
 #include "Widgets/FloatingButton.hpp"
 
@@ -56,6 +59,7 @@ class TitleBar;
 class BookmarksToolbar;
 
 class MaquetteGridItem;
+class PageSnapshotCache;
 
 //! Represent a window of the browser.
 /*!
@@ -128,6 +132,7 @@ public:
 
 	TitleBar* titleBar() const { return m_titleBar; }
 	BookmarksToolbar* bookmarksToolBar() const { return m_bookmarksToolbar; }
+	PageSnapshotCache* pageSnapshotCache() const { return m_pageSnapshotCache; }
 
 	const QImage* background();
 	const QImage* processedBackground();
@@ -156,7 +161,6 @@ public slots:
 
 protected:
 	void shotBackground();
-	QImage applyBlur(const QImage *src, qreal radius, bool quality = true, bool alphaOnly = false, int transposed = 0);
 	void paintEvent(QPaintEvent* event);
 	void resizeEvent(QResizeEvent* event);
 	void keyPressEvent(QKeyEvent* event) override;
@@ -171,6 +175,8 @@ private slots:
 	void addTab();
 	void postLaunch();
 
+	void backgroundBlurred();
+
 	void floatingButtonPatternChange(RootFloatingButton::Pattern pattern);
 
 	void newWindow();
@@ -211,9 +217,13 @@ private:
 
 	QTimer* m_backgroundTimer{nullptr};
 	QImage m_currentBackground{};
-	QImage* m_bg{ nullptr };
-	QImage* m_blur_bg{ nullptr };
+	QTimer* m_backgroundShotTimer{nullptr};
+	QFutureWatcher<QImage>* m_blurWatcher{nullptr};
+	QImage m_bg{};
+	QImage m_blur_bg{};
 	bool m_upd_ss{ false };
+
+	PageSnapshotCache* m_pageSnapshotCache{nullptr};
 };
 
 }
@@ -0,0 +1,155 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Cookies/CookieIndex.hpp"
+
+#include <QUrl>
+
+namespace Sn {
+
+DomainSuffixSet::DomainSuffixSet(const QStringList& domains)
+{
+	m_domains.reserve(domains.size());
+
+	foreach (const QString& domain, domains) {
+		const QString normalized{CookieIndex::normalizedDomain(domain)};
+
+		if (!normalized.isEmpty())
+			m_domains.insert(normalized);
+	}
+}
+
+bool DomainSuffixSet::matches(const QString& domain) const
+{
+	if (m_domains.isEmpty())
+		return false;
+
+	const QString host{CookieIndex::normalizedDomain(domain)};
+	int position{0};
+
+	while (position >= 0) {
+		if (m_domains.contains(host.mid(position)))
+			return true;
+
+		position = host.indexOf(QLatin1Char('.'), position);
+
+		if (position >= 0)
+			++position;
+	}
+
+	return false;
+}
+
+bool CookieIndex::insert(const QNetworkCookie& cookie)
+{
+	QVector<QNetworkCookie>& bucket = m_buckets[registrableDomain(cookie.domain())];
+	const int index{indexOf(bucket, cookie)};
+
+	if (index >= 0) {
+		bucket[index] = cookie;
+		return false;
+	}
+
+	bucket.append(cookie);
+	++m_count;
+
+	return true;
+}
+
+bool CookieIndex::remove(const QNetworkCookie& cookie)
+{
+	auto it = m_buckets.find(registrableDomain(cookie.domain()));
+
+	if (it == m_buckets.end())
+		return false;
+
+	const int index{indexOf(it.value(), cookie)};
+
+	if (index < 0)
+		return false;
+
+	it.value().remove(index);
+	--m_count;
+
+	if (it.value().isEmpty())
+		m_buckets.erase(it);
+
+	return true;
+}
+
+void CookieIndex::clear()
+{
+	m_buckets.clear();
+	m_count = 0;
+}
+
+QVector<QNetworkCookie> CookieIndex::allCookies() const
+{
+	QVector<QNetworkCookie> cookies{};
+	cookies.reserve(m_count);
+
+	for (auto it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it)
+		cookies += it.value();
+
+	return cookies;
+}
+
+QString CookieIndex::normalizedDomain(const QString& domain)
+{
+	QString normalized{domain.trimmed().toLower()};
+
+	if (normalized.startsWith(QLatin1Char('.')))
+		normalized = normalized.mid(1);
+
+	return normalized;
+}
+
+QString CookieIndex::registrableDomain(const QString& domain)
+{
+	const QString host{normalizedDomain(domain)};
+	const QString topLevelDomain{QUrl(QLatin1String("http://") + host).topLevelDomain()};
+
+	// IP addresses, single label hosts and unknown suffixes are their own bucket
+	if (topLevelDomain.isEmpty() || topLevelDomain.size() >= host.size())
+		return host;
+
+	const int labelEnd{host.size() - topLevelDomain.size()};
+	const int labelStart{host.lastIndexOf(QLatin1Char('.'), labelEnd - 1)};
+
+	return host.mid(labelStart + 1);
+}
+
+int CookieIndex::indexOf(const QVector<QNetworkCookie>& bucket, const QNetworkCookie& cookie)
+{
+	for (int i{0}; i < bucket.size(); ++i) {
+		const QNetworkCookie& other = bucket[i];
+
+		if (other.name() == cookie.name() && other.domain() == cookie.domain() && other.path() == cookie.path())
+			return i;
+	}
+
+	return -1;
+}
+
+}
@@ -0,0 +1,88 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELO_BROWSER_COOKIEINDEX_HPP
+#define SIELO_BROWSER_COOKIEINDEX_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QStringList>
+
+#include <QNetworkCookie>
+
+namespace Sn {
+
+/*
+ * Set of domains compiled from the cookie white and black lists. A host matches when it, or one of its parent
+ * domains, is in the set. Lookups cost one hash probe per label of the host instead of a scan of the whole list.
+ */
+class SIELO_SHAREDLIB DomainSuffixSet {
+public:
+	DomainSuffixSet() = default;
+	DomainSuffixSet(const QStringList& domains);
+
+	bool matches(const QString& domain) const;
+	bool isEmpty() const { return m_domains.isEmpty(); }
+
+private:
+	QSet<QString> m_domains{};
+};
+
+/*
+ * Cookies bucketed by registrable domain. Each bucket is a small vector in which a cookie is identified by its
+ * name, domain and path, the same identity used by the engine cookie store.
+ */
+class SIELO_SHAREDLIB CookieIndex {
+public:
+	CookieIndex() = default;
+
+	// Return true if the cookie was not in the index yet
+	bool insert(const QNetworkCookie& cookie);
+	// Return true if the cookie was in the index
+	bool remove(const QNetworkCookie& cookie);
+	void clear();
+
+	int count() const { return m_count; }
+
+	QStringList domains() const { return m_buckets.keys(); }
+	QVector<QNetworkCookie> cookies(const QString& registrableDomain) const { return m_buckets.value(registrableDomain); }
+	QVector<QNetworkCookie> allCookies() const;
+
+	static QString normalizedDomain(const QString& domain);
+	static QString registrableDomain(const QString& domain);
+
+private:
+	static int indexOf(const QVector<QNetworkCookie>& bucket, const QNetworkCookie& cookie);
+
+	QHash<QString, QVector<QNetworkCookie>> m_buckets{};
+	int m_count{0};
+};
+
+}
+
+#endif //SIELO_BROWSER_COOKIEINDEX_HPP
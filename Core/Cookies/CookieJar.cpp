@@ -37,8 +37,8 @@ CookieJar::CookieJar(QObject* parent) :
 	loadSettings();
 	m_client->loadAllCookies();
 
-	connect(m_client, &Engine::CookieStore::cookieAdded, this, &CookieJar::sCookieAdded);
-	connect(m_client, &Engine::CookieStore::cookieRemoved, this, &CookieJar::sCookieRemoved);
+	connect(m_client, &Engine::CookieStore::cookiesAdded, this, &CookieJar::sCookiesAdded);
+	connect(m_client, &Engine::CookieStore::cookiesRemoved, this, &CookieJar::sCookiesRemoved);
 }
 
 void CookieJar::loadSettings()
@@ -50,8 +50,8 @@ void CookieJar::loadSettings()
 	m_allowCookies = settings.value("allowCookies", true).toBool();
 	m_filterThirdParty = settings.value("filterThirdPartyCookies", false).toBool();
 	m_filterTrackingCookie = settings.value("filterTrackingCookies", false).toBool();
-	m_whiteList = settings.value("whiteList", QStringList()).toStringList();
-	m_blackList = settings.value("blackList", QStringList()).toStringList();
+	m_whiteList = DomainSuffixSet(settings.value("whiteList", QStringList()).toStringList());
+	m_blackList = DomainSuffixSet(settings.value("blackList", QStringList()).toStringList());
 
 	settings.endGroup();
 }
@@ -71,6 +71,18 @@ void CookieJar::deleteAllCookies()
 	m_client->deleteAllCookies();
 }
 
+bool CookieJar::hasCookiesForHost(const QString& host) const
+{
+	const QString domain{CookieIndex::normalizedDomain(host)};
+
+	foreach (const QNetworkCookie& cookie, m_cookies.cookies(CookieIndex::registrableDomain(domain))) {
+		if (matchDomain(cookie.domain(), domain))
+			return true;
+	}
+
+	return false;
+}
+
 bool CookieJar::matchDomain(QString cookieDomain, QString siteDomain) const
 {
 	if (cookieDomain.startsWith(QLatin1Char('.')))
@@ -88,32 +100,37 @@ bool CookieJar::matchDomain(QString cookieDomain, QString siteDomain) const
 	return siteDomain.indexOf(cookieDomain) > 0 && siteDomain[siteDomain.indexOf(cookieDomain) - 1] == QLatin1Char('.');
 }
 
-bool CookieJar::listMatchesDomain(const QStringList& list, const QString& cookieDomain) const
+void CookieJar::sCookiesAdded(const QVector<QNetworkCookie>& cookies)
 {
-		foreach (const QString& domain, list) {
-			if (matchDomain(domain, cookieDomain))
-				return true;
-		}
+	QVector<QNetworkCookie> accepted{};
+	accepted.reserve(cookies.size());
 
-	return false;
-}
+	foreach (const QNetworkCookie& cookie, cookies) {
+		if (rejectCookie(QString(), cookie, cookie.domain())) {
+			m_client->deleteCookie(cookie);
+			continue;
+		}
 
-void CookieJar::sCookieAdded(const QNetworkCookie& cookie)
-{
-	if (rejectCookie(QString(), cookie, cookie.domain())) {
-		m_client->deleteCookie(cookie);
-		return;
+		m_cookies.insert(cookie);
+		accepted.append(cookie);
 	}
 
-	m_cookies.append(cookie);
-
-	emit cookieAdded(cookie);
+	if (!accepted.isEmpty())
+		emit cookiesAdded(accepted);
 }
 
-void CookieJar::sCookieRemoved(const QNetworkCookie& cookie)
+void CookieJar::sCookiesRemoved(const QVector<QNetworkCookie>& cookies)
 {
-	if (m_cookies.removeOne(cookie))
-		emit cookieRemoved(cookie);
+	QVector<QNetworkCookie> removed{};
+	removed.reserve(cookies.size());
+
+	foreach (const QNetworkCookie& cookie, cookies) {
+		if (m_cookies.remove(cookie))
+			removed.append(cookie);
+	}
+
+	if (!removed.isEmpty())
+		emit cookiesRemoved(removed);
 }
 
 bool CookieJar::acceptCookie(const QUrl& firstPartyUrl, const QByteArray& cookieLine, const QUrl& cookieSource) const
@@ -129,7 +146,7 @@ bool CookieJar::acceptCookie(const QUrl& firstPartyUrl, const QByteArray& cookie
 bool CookieJar::rejectCookie(const QString& domain, const QNetworkCookie& cookie, const QString& cookieDomain) const
 {
 	if (!m_allowCookies) {
-		bool result{listMatchesDomain(m_whiteList, cookieDomain)};
+		bool result{m_whiteList.matches(cookieDomain)};
 
 		if (!result) {
 			return true;
@@ -137,7 +154,7 @@ bool CookieJar::rejectCookie(const QString& domain, const QNetworkCookie& cookie
 	}
 
 	if (m_allowCookies) {
-		bool result{listMatchesDomain(m_blackList, cookieDomain)};
+		bool result{m_blackList.matches(cookieDomain)};
 
 		if (result)
 			return true;
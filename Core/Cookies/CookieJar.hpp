@@ -33,6 +33,8 @@
 
 #include <QWebEngine/CookieStore.hpp>
 
+#include "Cookies/CookieIndex.hpp"
+
 namespace Sn {
 
 class SIELO_SHAREDLIB CookieJar: public QObject {
@@ -47,20 +49,28 @@ public:
 
 	void deleteCookie(const QNetworkCookie& cookie);
 
-	QVector<QNetworkCookie> getAllCookies() const { return m_cookies; }
+	QVector<QNetworkCookie> getAllCookies() const { return m_cookies.allCookies(); }
 	void deleteAllCookies();
 
+	// Registrable domains which have at least one cookie, and the cookies of one of them
+	QStringList cookieDomains() const { return m_cookies.domains(); }
+	QVector<QNetworkCookie> cookiesForDomain(const QString& registrableDomain) const
+	{
+		return m_cookies.cookies(registrableDomain);
+	}
+	// Whether a request to host would carry at least one cookie of the profile
+	bool hasCookiesForHost(const QString& host) const;
+
 signals:
-	void cookieAdded(const QNetworkCookie& cookie);
-	void cookieRemoved(const QNetworkCookie& cookie);
+	void cookiesAdded(const QVector<QNetworkCookie>& cookies);
+	void cookiesRemoved(const QVector<QNetworkCookie>& cookies);
 
 protected:
 	bool matchDomain(QString cookieDomain, QString siteDomain) const;
-	bool listMatchesDomain(const QStringList& list, const QString& cookieDomain) const;
 
 private:
-	void sCookieAdded(const QNetworkCookie& cookie);
-	void sCookieRemoved(const QNetworkCookie& cookie);
+	void sCookiesAdded(const QVector<QNetworkCookie>& cookies);
+	void sCookiesRemoved(const QVector<QNetworkCookie>& cookies);
 
 	bool acceptCookie(const QUrl& firstPartyUrl, const QByteArray& cookieLine, const QUrl& cookieSource) const;
 	bool rejectCookie(const QString& domain, const QNetworkCookie& cookie, const QString& cookieDomain) const;
@@ -69,11 +79,11 @@ private:
 	bool m_filterTrackingCookie{};
 	bool m_filterThirdParty{};
 
-	QStringList m_whiteList{};
-	QStringList m_blackList{};
+	DomainSuffixSet m_whiteList{};
+	DomainSuffixSet m_blackList{};
 
 	Engine::CookieStore* m_client{nullptr};
-	QVector<QNetworkCookie> m_cookies{};
+	CookieIndex m_cookies{};
 };
 
 }
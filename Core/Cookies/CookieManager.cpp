@@ -35,6 +35,7 @@
 #include "Utils/Settings.hpp"
 
 #include "Cookies/CookieJar.hpp"
+#include "Cookies/CookieIndex.hpp"
 
 #include "Widgets/EllipseLabel.hpp"
 
@@ -57,6 +58,7 @@ CookieManager::CookieManager() :
 
 	// Stored cookie
 	connect(m_cookieTree, &QTreeWidget::currentItemChanged, this, &CookieManager::currentItemChanged);
+	connect(m_cookieTree, &QTreeWidget::itemExpanded, this, &CookieManager::loadDomain);
 	connect(m_removeAllCookies, &QPushButton::clicked, this, &CookieManager::removeAll);
 	connect(m_removeCookie, &QPushButton::clicked, this, &CookieManager::remove);
 	connect(m_storedCloseDialogButtonBox, &QDialogButtonBox::clicked, this, &CookieManager::close);
@@ -88,10 +90,16 @@ CookieManager::CookieManager() :
 	QShortcut* removeShortcut{new QShortcut(QKeySequence("Del"), this)};
 	connect(removeShortcut, &QShortcut::activated, this, &CookieManager::deletePressed);
 
-	connect(Application::instance()->cookieJar(), &CookieJar::cookieAdded, this, &CookieManager::addCookie);
-	connect(Application::instance()->cookieJar(), &CookieJar::cookieRemoved, this, &CookieManager::removeCookie);
+	connect(Application::instance()->cookieJar(), &CookieJar::cookiesAdded, this, &CookieManager::addCookies);
+	connect(Application::instance()->cookieJar(), &CookieJar::cookiesRemoved, this, &CookieManager::removeCookies);
 
-		foreach (const QNetworkCookie& cookie, Application::instance()->cookieJar()->getAllCookies()) addCookie(cookie);
+	// Only domains are listed here, their cookies are loaded when the domain item is expanded
+	QList<QTreeWidgetItem*> domains{};
+
+	foreach (const QString& domain, Application::instance()->cookieJar()->cookieDomains())
+		domains.append(createDomainItem(domain));
+
+	m_cookieTree->addTopLevelItems(domains);
 }
 
 CookieManager::~CookieManager()
@@ -139,15 +147,11 @@ void CookieManager::remove()
 	if (!current)
 		return;
 
-	QList<QNetworkCookie> cookies{};
+	QVector<QNetworkCookie> cookies{};
 
-	if (current->childCount()) {
-		for (int i{0}; i < current->childCount(); ++i) {
-			QTreeWidgetItem* item{current->child(i)};
-
-			if (item && m_itemHash.contains(item))
-				cookies.append(m_itemHash.value(item));
-		}
+	if (!current->parent()) {
+		const QString domain{current->data(0, Qt::UserRole + 10).toString()};
+		cookies = Application::instance()->cookieJar()->cookiesForDomain(domain);
 	}
 	else if (m_itemHash.contains(current))
 		cookies.append(m_itemHash.value(current));
@@ -198,6 +202,7 @@ void CookieManager::removeAll()
 
 	m_itemHash.clear();
 	m_domainHash.clear();
+	m_loadedDomains.clear();
 	m_cookieTree->clear();
 }
 
@@ -233,50 +238,107 @@ void CookieManager::filterString(const QString& string)
 	}
 }
 
-void CookieManager::addCookie(const QNetworkCookie& cookie)
+void CookieManager::addCookies(const QVector<QNetworkCookie>& cookies)
 {
-	QTreeWidgetItem* item{nullptr};
-	const QString domain{cookieDomain(cookie)};
-	QTreeWidgetItem* findParent{m_domainHash.value(domain)};
+	QList<QTreeWidgetItem*> newDomains{};
+	QHash<QTreeWidgetItem*, QList<QTreeWidgetItem*>> newItems{};
 
-	if (findParent)
-		item = new QTreeWidgetItem(findParent);
-	else {
-		QTreeWidgetItem* newParent{new QTreeWidgetItem(m_cookieTree)};
-		newParent->setText(0, domain);
-		newParent->setIcon(0, QApplication::style()->standardIcon(QStyle::SP_DirIcon));
-		newParent->setData(0, Qt::UserRole + 10, cookie.domain());
+	foreach (const QNetworkCookie& cookie, cookies) {
+		const QString domain{CookieIndex::registrableDomain(cookie.domain())};
+		QTreeWidgetItem* parent{m_domainHash.value(domain)};
+
+		if (!parent) {
+			parent = createDomainItem(domain);
+			newDomains.append(parent);
+		}
 
-		m_cookieTree->addTopLevelItem(newParent);
-		m_domainHash[domain] = newParent;
+		if (!m_loadedDomains.contains(domain))
+			continue;
 
-		item = new QTreeWidgetItem(newParent);
+		QTreeWidgetItem* item{cookieItem(cookie)};
+
+		if (!item) {
+			foreach (QTreeWidgetItem* pending, newItems.value(parent)) {
+				if (sameCookie(m_itemHash.value(pending), cookie)) {
+					item = pending;
+					break;
+				}
+			}
+		}
+
+		if (item) {
+			item->setData(0, Qt::UserRole + 10, QVariant::fromValue(cookie));
+			m_itemHash[item] = cookie;
+		}
+		else {
+			newItems[parent].append(createCookieItem(cookie));
+		}
 	}
 
-	item->setText(0, "." + domain);
-	item->setText(1, cookie.name());
-	item->setData(0, Qt::UserRole + 10, QVariant::fromValue(cookie));
+	// Items are inserted with one range insertion per domain, and sorting is done once for the whole batch
+	m_cookieTree->setUpdatesEnabled(false);
+	m_cookieTree->setSortingEnabled(false);
 
-	m_cookieTree->addTopLevelItem(item);
-	m_itemHash[item] = cookie;
+	m_cookieTree->addTopLevelItems(newDomains);
+
+	for (auto it = newItems.constBegin(); it != newItems.constEnd(); ++it)
+		it.key()->addChildren(it.value());
+
+	m_cookieTree->setSortingEnabled(true);
+	m_cookieTree->setUpdatesEnabled(true);
 }
 
-void CookieManager::removeCookie(const QNetworkCookie& cookie)
+void CookieManager::removeCookies(const QVector<QNetworkCookie>& cookies)
 {
-	QTreeWidgetItem* item{cookieItem(cookie)};
+	m_cookieTree->setUpdatesEnabled(false);
 
-	if (!item)
-		return;
+	foreach (const QNetworkCookie& cookie, cookies) {
+		const QString domain{CookieIndex::registrableDomain(cookie.domain())};
+		QTreeWidgetItem* parent{m_domainHash.value(domain)};
+
+		if (!parent)
+			continue;
+
+		QTreeWidgetItem* item{cookieItem(cookie)};
 
-	m_itemHash.remove(item);
+		if (item) {
+			m_itemHash.remove(item);
+			delete item;
+		}
+
+		if (Application::instance()->cookieJar()->cookiesForDomain(domain).isEmpty()) {
+			for (int i{0}; i < parent->childCount(); ++i)
+				m_itemHash.remove(parent->child(i));
 
-	if (item->parent() && item->parent()->childCount() == 1) {
-		m_domainHash.remove(cookieDomain(cookie));
-		delete item->parent();
-		item = nullptr;
+			m_domainHash.remove(domain);
+			m_loadedDomains.remove(domain);
+			delete parent;
+		}
 	}
 
-	delete item;
+	m_cookieTree->setUpdatesEnabled(true);
+}
+
+void CookieManager::loadDomain(QTreeWidgetItem* item)
+{
+	if (!item || item->parent())
+		return;
+
+	const QString domain{item->data(0, Qt::UserRole + 10).toString()};
+
+	if (m_loadedDomains.contains(domain))
+		return;
+
+	m_loadedDomains.insert(domain);
+
+	QList<QTreeWidgetItem*> items{};
+
+	foreach (const QNetworkCookie& cookie, Application::instance()->cookieJar()->cookiesForDomain(domain))
+		items.append(createCookieItem(cookie));
+
+	item->addChildren(items);
+
+	item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
 }
 
 void CookieManager::closeEvent(QCloseEvent* event)
@@ -590,18 +652,52 @@ QString CookieManager::cookieDomain(const QNetworkCookie& cookie) const
 	return domain;
 }
 
+QTreeWidgetItem* CookieManager::createDomainItem(const QString& domain)
+{
+	QTreeWidgetItem* item{new QTreeWidgetItem()};
+	item->setText(0, domain);
+	item->setIcon(0, QApplication::style()->standardIcon(QStyle::SP_DirIcon));
+	item->setData(0, Qt::UserRole + 10, domain);
+	item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+
+	m_domainHash[domain] = item;
+
+	return item;
+}
+
+QTreeWidgetItem* CookieManager::createCookieItem(const QNetworkCookie& cookie)
+{
+	QTreeWidgetItem* item{new QTreeWidgetItem()};
+
+	item->setText(0, "." + cookieDomain(cookie));
+	item->setText(1, cookie.name());
+	item->setData(0, Qt::UserRole + 10, QVariant::fromValue(cookie));
+
+	m_itemHash[item] = cookie;
+
+	return item;
+}
+
 QTreeWidgetItem* CookieManager::cookieItem(const QNetworkCookie& cookie) const
 {
-	QHashIterator<QTreeWidgetItem*, QNetworkCookie> it(m_itemHash);
+	QTreeWidgetItem* parent{m_domainHash.value(CookieIndex::registrableDomain(cookie.domain()))};
+
+	if (!parent)
+		return nullptr;
 
-	while (it.hasNext()) {
-		it.next();
+	for (int i{0}; i < parent->childCount(); ++i) {
+		QTreeWidgetItem* item{parent->child(i)};
 
-		if (it.value() == cookie)
-			return it.key();
+		if (sameCookie(m_itemHash.value(item), cookie))
+			return item;
 	}
 
 	return nullptr;
 }
 
-}
\ No newline at end of file
+bool CookieManager::sameCookie(const QNetworkCookie& first, const QNetworkCookie& second) const
+{
+	return first.name() == second.name() && first.domain() == second.domain() && first.path() == second.path();
+}
+
+}
@@ -50,6 +50,8 @@
 #include <QKeyEvent>
 
 #include <QHash>
+#include <QSet>
+#include <QVector>
 
 namespace Sn {
 class EllipseLabel;
@@ -75,8 +77,10 @@ private slots:
 
 	void filterString(const QString& string);
 
-	void addCookie(const QNetworkCookie& cookie);
-	void removeCookie(const QNetworkCookie& cookie);
+	void addCookies(const QVector<QNetworkCookie>& cookies);
+	void removeCookies(const QVector<QNetworkCookie>& cookies);
+
+	void loadDomain(QTreeWidgetItem* item);
 
 private:
 	void setupUI();
@@ -86,7 +90,10 @@ private:
 
 	void addBlackList(const QString& server);
 	QString cookieDomain(const QNetworkCookie& cookie) const;
+	QTreeWidgetItem* createDomainItem(const QString& domain);
+	QTreeWidgetItem* createCookieItem(const QNetworkCookie& cookie);
 	QTreeWidgetItem* cookieItem(const QNetworkCookie& cookie) const;
+	bool sameCookie(const QNetworkCookie& first, const QNetworkCookie& second) const;
 
 	QHBoxLayout* m_layout{nullptr};
 
@@ -157,6 +164,7 @@ private:
 
 	QHash<QString, QTreeWidgetItem*> m_domainHash{};
 	QHash<QTreeWidgetItem*, QNetworkCookie> m_itemHash{};
+	QSet<QString> m_loadedDomains{};
 };
 
 }
@@ -29,6 +29,8 @@
 
 #include <QCoreApplication>
 
+#include "Utils/Metrics.hpp"
+
 namespace  Sn
 {
 
@@ -62,6 +64,12 @@ QSqlDatabase SqlDatabase::database() const {
 	return s_databases.localData();
 }
 
+bool SqlDatabase::exec(QSqlQuery& query) {
+	ScopedTiming timing{Metrics::SqlStatement};
+
+	return query.exec();
+}
+
 void SqlDatabase::setDatabase(const QSqlDatabase& database) {
 	m_databaseName = database.databaseName();
 	m_connectOptions = database.connectOptions();
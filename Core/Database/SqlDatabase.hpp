@@ -113,6 +113,7 @@
 #include <QObject>
 
 #include <QSqlDatabase>
+#include <QSqlQuery>
 
 namespace Sn {
 
@@ -128,6 +129,9 @@ public:
 
 	static SqlDatabase* instance();
 
+	// Executes the query and records its duration in the metrics
+	static bool exec(QSqlQuery& query);
+
 private:
 	QString m_databaseName{};
 	QString m_connectOptions{};
@@ -0,0 +1,734 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Download/DownloadEngine.hpp"
+
+#include <QThread>
+#include <QHash>
+#include <QFile>
+
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+
+#include <QSqlQuery>
+#include <QVariant>
+
+#include "Database/SqlDatabase.hpp"
+
+#include "Utils/Settings.hpp"
+
+namespace Sn {
+
+// Data read from the network but not yet written, segments stop reading above it
+static const qint64 MaximumPendingBytes = 16 * 1024 * 1024;
+static const qint64 ReadBufferSize = 1024 * 1024;
+static const qint64 MinimumSegmentSize = 1024 * 1024;
+static const int MaximumRetries = 3;
+static const int RetryDelay = 2000;
+static const int JournalInterval = 1000;
+
+/*
+ * Files of the segmented downloads. It lives in the writer thread of the engine, every method is called there so
+ * the main thread never waits on the disk.
+ */
+class DownloadWriter: public QObject {
+public:
+	~DownloadWriter()
+	{
+		qDeleteAll(m_files);
+	}
+
+	bool open(qint64 id, const QString& path, qint64 size)
+	{
+		if (m_files.contains(id))
+			return true;
+
+		QFile* file{new QFile(path)};
+
+		// Unbuffered so bytes reported as written are in the file, the journal relies on it
+		if (!file->open(QIODevice::ReadWrite | QIODevice::Unbuffered) || (file->size() != size && !file->resize(size))) {
+			delete file;
+			return false;
+		}
+
+		m_files.insert(id, file);
+
+		return true;
+	}
+
+	bool write(qint64 id, qint64 offset, const QByteArray& data)
+	{
+		QFile* file{m_files.value(id)};
+
+		return file && file->seek(offset) && file->write(data) == data.size();
+	}
+
+	void close(qint64 id)
+	{
+		delete m_files.take(id);
+	}
+
+	bool finish(qint64 id, const QString& partPath, const QString& path)
+	{
+		close(id);
+
+		if (QFile::exists(path))
+			QFile::remove(path);
+
+		return QFile::rename(partPath, path);
+	}
+
+	void remove(qint64 id, const QString& path)
+	{
+		close(id);
+		QFile::remove(path);
+	}
+
+private:
+	QHash<qint64, QFile*> m_files{};
+};
+
+SegmentedDownload::SegmentedDownload(DownloadEngine* engine, qint64 id, const QUrl& url, const QString& path,
+									 qint64 size, const QByteArray& validator) :
+	QObject(),
+	m_engine(engine),
+	m_id(id),
+	m_url(url),
+	m_path(path),
+	m_size(size),
+	m_validator(validator)
+{
+	m_journalTimer.setSingleShot(true);
+	m_journalTimer.setInterval(JournalInterval);
+
+	connect(&m_journalTimer, &QTimer::timeout, this, [this]()
+	{
+		if (m_engine)
+			m_engine->updateJournal(this);
+	});
+}
+
+SegmentedDownload::~SegmentedDownload()
+{
+	abortSegments();
+
+	if (!m_engine)
+		return;
+
+	if (m_state == InProgress || canResume())
+		m_engine->updateJournal(this);
+
+	if (m_fileOpened) {
+		DownloadWriter* writer{m_engine->m_writer};
+		qint64 id{m_id};
+
+		QMetaObject::invokeMethod(writer, [writer, id]() { writer->close(id); }, Qt::QueuedConnection);
+	}
+}
+
+qint64 SegmentedDownload::bytesReceived() const
+{
+	qint64 received{0};
+
+	foreach (const Segment& segment, m_segments) received += segment.received;
+
+	return received;
+}
+
+void SegmentedDownload::start()
+{
+	if (!m_engine || !canResume())
+		return;
+
+	m_state = InProgress;
+	m_errorString.clear();
+
+	// Data of a failed write is lost, fetch it again
+	if (m_pendingBytes == 0) {
+		for (Segment& segment : m_segments)
+			segment.received = segment.written;
+	}
+
+	if (!m_fileOpened) {
+		DownloadWriter* writer{m_engine->m_writer};
+		QPointer<SegmentedDownload> download{this};
+		DownloadEngine* engine{m_engine};
+		qint64 id{m_id};
+		QString partPath{this->partPath()};
+		qint64 size{m_size};
+
+		QMetaObject::invokeMethod(writer, [=]()
+		{
+			bool opened{writer->open(id, partPath, size)};
+
+			QMetaObject::invokeMethod(engine, [=]()
+			{
+				if (download && !opened)
+					download->fail(tr("Can't write %1").arg(partPath), false);
+			}, Qt::QueuedConnection);
+		}, Qt::QueuedConnection);
+
+		m_fileOpened = true;
+	}
+
+	for (int i{0}; i < m_segments.count(); ++i) {
+		if (!m_segments[i].isComplete() && !m_segments[i].reply)
+			startSegment(i);
+	}
+
+	checkCompleted();
+}
+
+void SegmentedDownload::pause()
+{
+	if (m_state != InProgress)
+		return;
+
+	m_state = Paused;
+	abortSegments();
+
+	m_journalTimer.stop();
+
+	if (m_engine)
+		m_engine->updateJournal(this);
+}
+
+void SegmentedDownload::cancel()
+{
+	if (m_state == Completed || m_state == Cancelled)
+		return;
+
+	abortSegments();
+
+	if (m_engine) {
+		DownloadWriter* writer{m_engine->m_writer};
+		qint64 id{m_id};
+		QString partPath{this->partPath()};
+
+		QMetaObject::invokeMethod(writer, [writer, id, partPath]() { writer->remove(id, partPath); },
+								  Qt::QueuedConnection);
+		m_engine->removeJournal(m_id);
+	}
+
+	m_fileOpened = false;
+
+	setFinished(Cancelled);
+}
+
+QString SegmentedDownload::partPath() const
+{
+	return m_path + QLatin1String(".part");
+}
+
+void SegmentedDownload::startSegment(int index)
+{
+	Segment& segment{m_segments[index]};
+	QNetworkRequest request{m_engine->request(m_url)};
+
+	request.setRawHeader("Range", "bytes=" + QByteArray::number(segment.start + segment.received) + '-'
+		+ QByteArray::number(segment.end - 1));
+
+	if (!m_validator.isEmpty())
+		request.setRawHeader("If-Range", m_validator);
+
+	segment.checked = false;
+	segment.reply = m_engine->m_networkManager->get(request);
+	segment.reply->setReadBufferSize(ReadBufferSize);
+
+	connect(segment.reply, &QNetworkReply::readyRead, this, [this, index]() { readSegment(index); });
+	connect(segment.reply, &QNetworkReply::finished, this, [this, index]() { segmentFinished(index); });
+}
+
+void SegmentedDownload::readSegment(int index)
+{
+	Segment& segment{m_segments[index]};
+	QNetworkReply* reply{segment.reply};
+
+	if (!reply || m_state != InProgress || !m_engine)
+		return;
+
+	if (!segment.checked) {
+		int status{reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()};
+
+		// Errors are retried once the reply is finished
+		if (status >= 400)
+			return;
+
+		QByteArray range{"bytes " + QByteArray::number(segment.start + segment.received) + '-'};
+
+		// A full response means the validator doesn't match anymore
+		if (status != 206 || !reply->rawHeader("Content-Range").startsWith(range)) {
+			fail(tr("The file changed on the server"), false);
+			return;
+		}
+
+		segment.checked = true;
+	}
+
+	if (m_pendingBytes >= MaximumPendingBytes)
+		return;
+
+	QByteArray data{reply->read(qMin(reply->bytesAvailable(), segment.length() - segment.received))};
+
+	if (data.isEmpty())
+		return;
+
+	DownloadWriter* writer{m_engine->m_writer};
+	QPointer<SegmentedDownload> download{this};
+	DownloadEngine* engine{m_engine};
+	qint64 id{m_id};
+	qint64 offset{segment.start + segment.received};
+	int generation{m_writeGeneration};
+
+	segment.received += data.size();
+	m_pendingBytes += data.size();
+
+	QMetaObject::invokeMethod(writer, [=]()
+	{
+		bool written{writer->write(id, offset, data)};
+		qint64 bytes{data.size()};
+
+		QMetaObject::invokeMethod(engine, [=]()
+		{
+			if (download && download->m_writeGeneration == generation)
+				download->segmentWritten(index, bytes, written);
+		}, Qt::QueuedConnection);
+	}, Qt::QueuedConnection);
+
+	emit downloadProgress(static_cast<quint64>(bytesReceived()), static_cast<quint64>(m_size));
+}
+
+void SegmentedDownload::segmentFinished(int index)
+{
+	Segment& segment{m_segments[index]};
+	QNetworkReply* reply{segment.reply};
+
+	if (!reply || m_state != InProgress)
+		return;
+
+	if (reply->error() == QNetworkReply::NoError) {
+		readSegment(index);
+
+		// The rest is read once the writer caught up
+		if (m_state != InProgress || (reply->bytesAvailable() > 0 && !segment.isComplete()))
+			return;
+	}
+
+	segment.reply = nullptr;
+	reply->deleteLater();
+
+	if (segment.isComplete()) {
+		checkCompleted();
+		return;
+	}
+
+	if (++segment.retries > MaximumRetries) {
+		fail(reply->error() == QNetworkReply::NoError ? tr("Download interrupted") : reply->errorString());
+		return;
+	}
+
+	QTimer::singleShot(RetryDelay * segment.retries, this, [this, index]()
+	{
+		if (m_state == InProgress && !m_segments[index].reply)
+			startSegment(index);
+	});
+}
+
+void SegmentedDownload::segmentWritten(int index, qint64 bytes, bool success)
+{
+	m_pendingBytes -= bytes;
+
+	if (!success) {
+		fail(tr("Can't write %1").arg(partPath()));
+		return;
+	}
+
+	m_segments[index].written += bytes;
+
+	if (m_state != InProgress)
+		return;
+
+	if (!m_journalTimer.isActive())
+		m_journalTimer.start();
+
+	readPendingSegments();
+	checkCompleted();
+}
+
+void SegmentedDownload::readPendingSegments()
+{
+	for (int i{0}; i < m_segments.count() && m_pendingBytes < MaximumPendingBytes; ++i) {
+		QNetworkReply* reply{m_segments[i].reply};
+
+		if (!reply || reply->bytesAvailable() == 0)
+			continue;
+
+		if (reply->isFinished())
+			segmentFinished(i);
+		else
+			readSegment(i);
+	}
+}
+
+void SegmentedDownload::checkCompleted()
+{
+	if (m_state != InProgress || m_pendingBytes > 0 || !m_engine)
+		return;
+
+	foreach (const Segment& segment, m_segments) {
+		if (!segment.isComplete() || segment.reply)
+			return;
+	}
+
+	// Stays in progress until the file is renamed
+	m_journalTimer.stop();
+
+	DownloadWriter* writer{m_engine->m_writer};
+	QPointer<SegmentedDownload> download{this};
+	DownloadEngine* engine{m_engine};
+	qint64 id{m_id};
+	QString partPath{this->partPath()};
+	QString path{m_path};
+
+	m_fileOpened = false;
+
+	QMetaObject::invokeMethod(writer, [=]()
+	{
+		bool finished{writer->finish(id, partPath, path)};
+
+		QMetaObject::invokeMethod(engine, [=]()
+		{
+			if (!download || download->m_state != InProgress)
+				return;
+
+			if (!finished) {
+				download->fail(tr("Can't write %1").arg(path), false);
+				return;
+			}
+
+			engine->removeJournal(id);
+			download->setFinished(Completed);
+		}, Qt::QueuedConnection);
+	}, Qt::QueuedConnection);
+}
+
+void SegmentedDownload::abortSegments()
+{
+	for (Segment& segment : m_segments) {
+		QNetworkReply* reply{segment.reply};
+
+		if (!reply)
+			continue;
+
+		segment.reply = nullptr;
+
+		reply->disconnect(this);
+		reply->abort();
+		reply->deleteLater();
+	}
+}
+
+void SegmentedDownload::fail(const QString& errorString, bool resumable)
+{
+	if (m_state == Completed || m_state == Cancelled || m_state == Failed)
+		return;
+
+	abortSegments();
+
+	m_errorString = errorString;
+	m_resumable = resumable;
+
+	if (m_engine) {
+		if (resumable) {
+			m_engine->updateJournal(this);
+		}
+		else {
+			DownloadWriter* writer{m_engine->m_writer};
+			qint64 id{m_id};
+			QString partPath{this->partPath()};
+
+			QMetaObject::invokeMethod(writer, [writer, id, partPath]() { writer->remove(id, partPath); },
+									  Qt::QueuedConnection);
+			m_engine->removeJournal(m_id);
+
+			m_fileOpened = false;
+
+			// Writes still queued land in the removed file, they must not count anymore
+			++m_writeGeneration;
+			m_pendingBytes = 0;
+
+			for (Segment& segment : m_segments) {
+				segment.received = 0;
+				segment.written = 0;
+			}
+		}
+	}
+
+	setFinished(Failed);
+}
+
+void SegmentedDownload::setFinished(State state)
+{
+	m_state = state;
+	m_journalTimer.stop();
+
+	emit finished();
+}
+
+DownloadEngine::DownloadEngine(QNetworkAccessManager* networkManager, bool journalEnabled, QObject* parent) :
+	QObject(parent),
+	m_networkManager(networkManager),
+	m_journalEnabled(journalEnabled),
+	m_writerThread(new QThread(this)),
+	m_writer(new DownloadWriter())
+{
+	loadSettings();
+
+	m_writer->moveToThread(m_writerThread);
+	m_writerThread->start();
+
+	if (m_journalEnabled)
+		createJournal();
+}
+
+DownloadEngine::~DownloadEngine()
+{
+	m_writerThread->quit();
+	m_writerThread->wait();
+
+	delete m_writer;
+}
+
+void DownloadEngine::loadSettings()
+{
+	Settings settings{};
+
+	settings.beginGroup(QLatin1String("Download-Settings"));
+
+	m_enabled = settings.value(QLatin1String("segmentedDownloads"), false).toBool();
+	m_connections = qBound(1, settings.value(QLatin1String("segmentedDownloadConnections"), 4).toInt(), 16);
+	m_minimumSize = settings.value(QLatin1String("segmentedDownloadMinimumSize"), 16).toLongLong() * 1024 * 1024;
+
+	settings.endGroup();
+}
+
+void DownloadEngine::probe(const QUrl& url, QObject* context, const ProbeCallback& callback)
+{
+	QNetworkReply* reply{m_networkManager->head(request(url))};
+	qint64 minimumSize{m_minimumSize};
+
+	connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+	connect(reply, &QNetworkReply::finished, context, [=]()
+	{
+		int status{reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()};
+		qint64 size{reply->header(QNetworkRequest::ContentLengthHeader).toLongLong()};
+		bool ranges{reply->rawHeader("Accept-Ranges").toLower().contains("bytes")};
+
+		if (reply->error() != QNetworkReply::NoError || status != 200 || !ranges || size <= 0 || size < minimumSize) {
+			callback(-1, QByteArray());
+			return;
+		}
+
+		// Weak validators can't be used with If-Range
+		QByteArray validator{reply->rawHeader("ETag")};
+
+		if (validator.isEmpty() || validator.startsWith("W/"))
+			validator = reply->rawHeader("Last-Modified");
+
+		callback(size, validator);
+	});
+}
+
+SegmentedDownload* DownloadEngine::download(const QUrl& url, const QString& path, qint64 size,
+											const QByteArray& validator)
+{
+	SegmentedDownload* download{new SegmentedDownload(this, 0, url, path, size, validator)};
+	int count{static_cast<int>(qBound(qint64(1), size / MinimumSegmentSize, qint64(m_connections)))};
+	qint64 length{size / count};
+
+	for (int i{0}; i < count; ++i) {
+		SegmentedDownload::Segment segment{};
+
+		segment.start = i * length;
+		segment.end = i == count - 1 ? size : segment.start + length;
+
+		download->m_segments.append(segment);
+	}
+
+	download->m_id = insertJournal(download);
+	download->start();
+
+	return download;
+}
+
+QVector<SegmentedDownload*> DownloadEngine::unfinishedDownloads()
+{
+	QVector<SegmentedDownload*> downloads{};
+
+	if (!m_journalEnabled)
+		return downloads;
+
+	QSqlQuery query{SqlDatabase::instance()->database()};
+	query.prepare("SELECT id, url, path, size, validator FROM downloads");
+	SqlDatabase::exec(query);
+
+	while (query.next()) {
+		qint64 id{query.value(0).toLongLong()};
+		SegmentedDownload* download{new SegmentedDownload(this, id, query.value(1).toUrl(), query.value(2).toString(),
+														  query.value(3).toLongLong(), query.value(4).toByteArray())};
+
+		QSqlQuery segmentsQuery{SqlDatabase::instance()->database()};
+		segmentsQuery.prepare("SELECT range_start, range_end, written FROM download_segments WHERE download_id = ? "
+							  "ORDER BY range_start");
+		segmentsQuery.addBindValue(id);
+		SqlDatabase::exec(segmentsQuery);
+
+		while (segmentsQuery.next()) {
+			SegmentedDownload::Segment segment{};
+
+			segment.start = segmentsQuery.value(0).toLongLong();
+			segment.end = segmentsQuery.value(1).toLongLong();
+			segment.written = segmentsQuery.value(2).toLongLong();
+			segment.received = segment.written;
+
+			download->m_segments.append(segment);
+		}
+
+		// Nothing to resume from
+		if (download->m_segments.isEmpty() || !QFile::exists(download->partPath())) {
+			delete download;
+			removeJournal(id);
+			continue;
+		}
+
+		downloads.append(download);
+	}
+
+	return downloads;
+}
+
+QNetworkRequest DownloadEngine::request(const QUrl& url) const
+{
+	QNetworkRequest request{url};
+
+	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+	// Ranges are offsets in the encoded content, it must be the file itself
+	request.setRawHeader("Accept-Encoding", "identity");
+
+	if (!m_userAgent.isEmpty())
+		request.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+
+	return request;
+}
+
+void DownloadEngine::createJournal()
+{
+	QSqlQuery query{SqlDatabase::instance()->database()};
+
+	query.prepare("CREATE TABLE IF NOT EXISTS downloads (id INTEGER PRIMARY KEY, url TEXT NOT NULL, "
+				  "path TEXT NOT NULL, size INTEGER NOT NULL, validator TEXT)");
+	SqlDatabase::exec(query);
+
+	query.prepare("CREATE TABLE IF NOT EXISTS download_segments (download_id INTEGER NOT NULL, "
+				  "range_start INTEGER NOT NULL, range_end INTEGER NOT NULL, written INTEGER NOT NULL)");
+	SqlDatabase::exec(query);
+}
+
+qint64 DownloadEngine::insertJournal(SegmentedDownload* download)
+{
+	if (!m_journalEnabled)
+		return --m_lastPrivateId;
+
+	QSqlDatabase database{SqlDatabase::instance()->database()};
+	QSqlQuery query{database};
+
+	database.transaction();
+
+	query.prepare("INSERT INTO downloads (url, path, size, validator) VALUES (?, ?, ?, ?)");
+	query.addBindValue(download->url().toString());
+	query.addBindValue(download->path());
+	query.addBindValue(download->size());
+	query.addBindValue(download->m_validator);
+
+	if (!SqlDatabase::exec(query)) {
+		database.rollback();
+		return --m_lastPrivateId;
+	}
+
+	qint64 id{query.lastInsertId().toLongLong()};
+
+	foreach (const SegmentedDownload::Segment& segment, download->m_segments) {
+		query.prepare("INSERT INTO download_segments (download_id, range_start, range_end, written) "
+					  "VALUES (?, ?, ?, ?)");
+		query.addBindValue(id);
+		query.addBindValue(segment.start);
+		query.addBindValue(segment.end);
+		query.addBindValue(segment.written);
+		SqlDatabase::exec(query);
+	}
+
+	database.commit();
+
+	return id;
+}
+
+void DownloadEngine::updateJournal(SegmentedDownload* download)
+{
+	if (!m_journalEnabled || download->id() < 0)
+		return;
+
+	QSqlDatabase database{SqlDatabase::instance()->database()};
+	QSqlQuery query{database};
+
+	database.transaction();
+
+	foreach (const SegmentedDownload::Segment& segment, download->m_segments) {
+		query.prepare("UPDATE download_segments SET written = ? WHERE download_id = ? AND range_start = ?");
+		query.addBindValue(segment.written);
+		query.addBindValue(download->id());
+		query.addBindValue(segment.start);
+		SqlDatabase::exec(query);
+	}
+
+	database.commit();
+}
+
+void DownloadEngine::removeJournal(qint64 id)
+{
+	if (!m_journalEnabled || id < 0)
+		return;
+
+	QSqlQuery query{SqlDatabase::instance()->database()};
+
+	query.prepare("DELETE FROM download_segments WHERE download_id = ?");
+	query.addBindValue(id);
+	SqlDatabase::exec(query);
+
+	query.prepare("DELETE FROM downloads WHERE id = ?");
+	query.addBindValue(id);
+	SqlDatabase::exec(query);
+}
+
+}
@@ -0,0 +1,198 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_DOWNLOADENGINE_HPP
+#define SIELOBROWSER_DOWNLOADENGINE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+#include <QUrl>
+#include <QVector>
+#include <QTimer>
+#include <QPointer>
+
+#include <functional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QNetworkRequest;
+class QThread;
+
+namespace Sn {
+class DownloadEngine;
+class DownloadWriter;
+
+/*
+ * A download split in byte ranges fetched in parallel. Every segment writes at its own offset in a file of the final
+ * size, so segments never wait on each other. Written bytes are recorded in the journal of the engine, an
+ * interrupted download resumes where each of its segments stopped.
+ */
+class SIELO_SHAREDLIB SegmentedDownload: public QObject {
+Q_OBJECT
+
+public:
+	enum State {
+		Paused,
+		InProgress,
+		Completed,
+		Cancelled,
+		Failed
+	};
+
+	~SegmentedDownload();
+
+	qint64 id() const { return m_id; }
+	QUrl url() const { return m_url; }
+	QString path() const { return m_path; }
+	qint64 size() const { return m_size; }
+	qint64 bytesReceived() const;
+
+	State state() const { return m_state; }
+	QString errorString() const { return m_errorString; }
+	// Paused, or failed with the data received so far still valid
+	bool canResume() const { return m_state == Paused || (m_state == Failed && m_resumable); }
+
+	void start();
+	void pause();
+	void cancel();
+
+signals:
+	void downloadProgress(quint64 bytesReceived, quint64 bytesTotal);
+	void finished();
+
+private:
+	struct Segment {
+		qint64 start{0};
+		qint64 end{0};
+		qint64 received{0};
+		qint64 written{0};
+		QNetworkReply* reply{nullptr};
+		int retries{0};
+		bool checked{false};
+
+		qint64 length() const { return end - start; }
+		bool isComplete() const { return received >= length(); }
+	};
+
+	SegmentedDownload(DownloadEngine* engine, qint64 id, const QUrl& url, const QString& path, qint64 size,
+					  const QByteArray& validator);
+
+	QString partPath() const;
+
+	void startSegment(int index);
+	void readSegment(int index);
+	void segmentFinished(int index);
+	void segmentWritten(int index, qint64 bytes, bool success);
+
+	void readPendingSegments();
+	void checkCompleted();
+	void abortSegments();
+	void fail(const QString& errorString, bool resumable = true);
+	void setFinished(State state);
+
+	QPointer<DownloadEngine> m_engine{};
+
+	qint64 m_id{0};
+	QUrl m_url{};
+	QString m_path{};
+	qint64 m_size{0};
+	QByteArray m_validator{};
+
+	QVector<Segment> m_segments{};
+	qint64 m_pendingBytes{0};
+	// Incremented when the part file is dropped, writes queued before are ignored
+	int m_writeGeneration{0};
+	bool m_fileOpened{false};
+
+	State m_state{Paused};
+	QString m_errorString{};
+	bool m_resumable{true};
+
+	QTimer m_journalTimer{};
+
+	friend class DownloadEngine;
+};
+
+/*
+ * Native download engine built on the network manager, used instead of the web engine for big files over http(s)
+ * when the server accepts range requests. Downloads are fetched with several connections, the data is written by a
+ * worker thread, and the state of every unfinished download is kept in the browsedata.db journal so it can be
+ * resumed after a restart.
+ */
+class SIELO_SHAREDLIB DownloadEngine: public QObject {
+Q_OBJECT
+
+public:
+	// The callback gets the size of the file and its validator, or -1 if the file should not be segmented
+	typedef std::function<void(qint64 size, const QByteArray& validator)> ProbeCallback;
+
+	// Without a journal, nothing is written to the database and interrupted downloads can't be resumed
+	DownloadEngine(QNetworkAccessManager* networkManager, bool journalEnabled, QObject* parent = nullptr);
+	~DownloadEngine();
+
+	void loadSettings();
+
+	bool isEnabled() const { return m_enabled; }
+	int connections() const { return m_connections; }
+
+	// Sent with every request, so servers see the same client as the web engine
+	QByteArray userAgent() const { return m_userAgent; }
+	void setUserAgent(const QByteArray& userAgent) { m_userAgent = userAgent; }
+
+	// Asks the server if url can be segmented, the callback is not called if context is destroyed before
+	void probe(const QUrl& url, QObject* context, const ProbeCallback& callback);
+
+	// The caller owns the returned download, it is already started
+	SegmentedDownload* download(const QUrl& url, const QString& path, qint64 size, const QByteArray& validator);
+	// Downloads interrupted before the end of the last session, they are paused
+	QVector<SegmentedDownload*> unfinishedDownloads();
+
+private:
+	QNetworkRequest request(const QUrl& url) const;
+
+	void createJournal();
+	qint64 insertJournal(SegmentedDownload* download);
+	void updateJournal(SegmentedDownload* download);
+	void removeJournal(qint64 id);
+
+	QNetworkAccessManager* m_networkManager{nullptr};
+
+	bool m_enabled{false};
+	int m_connections{4};
+	qint64 m_minimumSize{0};
+	QByteArray m_userAgent{};
+	bool m_journalEnabled{true};
+	qint64 m_lastPrivateId{0};
+
+	QThread* m_writerThread{nullptr};
+	DownloadWriter* m_writer{nullptr};
+
+	friend class SegmentedDownload;
+};
+}
+
+#endif //SIELOBROWSER_DOWNLOADENGINE_HPP
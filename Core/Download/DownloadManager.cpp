@@ -38,6 +38,9 @@
 
 #include "Download/DownloadWidget.hpp"
 #include "Download/DownloadModel.hpp"
+#include "Download/DownloadEngine.hpp"
+
+#include "Cookies/CookieJar.hpp"
 
 #include "Application.hpp"
 
@@ -108,6 +111,27 @@ void DownloadManager::downlaod(Engine::DownloadItem* download)
 	DownloadWidget* widget{new DownloadWidget(download, this)};
 
 	addItem(widget);
+
+	DownloadEngine* engine{Application::instance()->downloadEngine()};
+	QString scheme{download->url().scheme()};
+
+	if (!engine->isEnabled() || download->isFinished()
+		|| (scheme != QLatin1String("http") && scheme != QLatin1String("https")))
+		return;
+
+	// The engine has neither the cookies nor the referrer of the page, the file may need a logged in session
+	if (Application::instance()->cookieJar()->hasCookiesForHost(download->url().host()))
+		return;
+
+	// The web engine starts the download meanwhile, it is replaced if the file is worth being segmented
+	engine->probe(download->url(), widget, [engine, widget](qint64 size, const QByteArray& validator)
+	{
+		if (size < 0 || !widget->m_download || widget->m_download->isFinished())
+			return;
+
+		widget->setSegmentedDownload(engine->download(widget->m_url, widget->m_file.absoluteFilePath(), size,
+													  validator));
+	});
 }
 
 void DownloadManager::cleanup()
@@ -304,6 +328,12 @@ void DownloadManager::load()
 		key = QString(QLatin1String("download_%1_")).arg(++i);
 	}
 
+	// Segmented downloads interrupted by the end of the last session
+	foreach (SegmentedDownload* download, Application::instance()->downloadEngine()->unfinishedDownloads()) {
+		download->start();
+		addItem(new DownloadWidget(download, this));
+	}
+
 	m_buttonCleanUp->setEnabled(m_downloads.count() - activeDownloads() > 0);
 }
 
@@ -37,6 +37,7 @@
 #include "Widgets/EllipseLabel.hpp"
 
 #include "Download/DownloadManager.hpp"
+#include "Download/DownloadEngine.hpp"
 
 namespace Sn {
 
@@ -75,6 +76,34 @@ DownloadWidget::DownloadWidget(Engine::DownloadItem* download, QWidget* parent)
 	connect(m_buttonOpen, &QPushButton::clicked, this, &DownloadWidget::open);
 }
 
+DownloadWidget::DownloadWidget(SegmentedDownload* download, QWidget* parent) :
+	QWidget(parent),
+	m_bytesReceived(0)
+{
+	setupUI();
+
+	QPalette palette{m_downloadInfoLabel->palette()};
+	palette.setColor(QPalette::Text, Qt::darkGray);
+
+	m_downloadInfoLabel->setPalette(palette);
+
+	m_file.setFile(download->path());
+	m_url = download->url();
+
+	m_fileNameLabel->setText(m_file.fileName());
+	m_downloadInfoLabel->clear();
+
+	m_downloadTime.start();
+
+	m_buttonOpen->setEnabled(false);
+	m_buttonOpen->hide();
+
+	connect(m_buttonStop, &QPushButton::clicked, this, &DownloadWidget::stop);
+	connect(m_buttonOpen, &QPushButton::clicked, this, &DownloadWidget::open);
+
+	setSegmentedDownload(download);
+}
+
 bool DownloadWidget::downloading() const
 {
 	return m_buttonOpen->isVisible();
@@ -85,6 +114,9 @@ bool DownloadWidget::downloadedSuccessfully() const
 	bool completed
 		{m_download && m_download->isFinished() && m_download->state() == Engine::DownloadItem::DownloadCompleted};
 
+	if (m_segmentedDownload)
+		completed = m_segmentedDownload->state() == SegmentedDownload::Completed;
+
 	return completed || !m_buttonStop->isVisible();
 }
 
@@ -138,7 +170,12 @@ void DownloadWidget::stop()
 
 	setUpdatesEnabled(true);
 
-	if (m_download) {
+	if (m_segmentedDownload) {
+		m_buttonPause->hide();
+		m_segmentedDownload->cancel();
+		m_buttonOpen->setEnabled(false);
+	}
+	else if (m_download) {
 		m_download->cancel();
 		m_buttonOpen->setEnabled(false);
 	}
@@ -153,6 +190,26 @@ void DownloadWidget::open()
 	QDesktopServices::openUrl(url);
 }
 
+void DownloadWidget::pauseOrResume()
+{
+	if (!m_segmentedDownload)
+		return;
+
+	if (m_segmentedDownload->state() == SegmentedDownload::InProgress) {
+		m_segmentedDownload->pause();
+		m_downloadInfoLabel->setText(tr("Paused"));
+	}
+	else {
+		// Downloads failed for a network error resume from the journal too
+		m_downloadInfoLabel->clear();
+		m_segmentedDownload->start();
+	}
+
+	updatePauseButton();
+
+	emit statusChanged();
+}
+
 void DownloadWidget::downloadProgress(quint64 byteReceived, quint64 bytesTotal)
 {
 	m_bytesReceived = byteReceived;
@@ -171,7 +228,34 @@ void DownloadWidget::downloadProgress(quint64 byteReceived, quint64 bytesTotal)
 
 void DownloadWidget::finished()
 {
-	if (m_download) {
+	if (m_segmentedDownload) {
+		QString message{};
+
+		switch (m_segmentedDownload->state()) {
+		case SegmentedDownload::Paused:
+		case SegmentedDownload::InProgress:
+			return;
+		case SegmentedDownload::Completed:
+			break;
+		case SegmentedDownload::Cancelled:
+			message = QStringLiteral("Download cancelled");
+			break;
+		case SegmentedDownload::Failed:
+			message = m_segmentedDownload->errorString();
+			break;
+		}
+
+		updatePauseButton();
+
+		if (!message.isEmpty()) {
+			m_downloadInfoLabel->setText(message);
+			m_buttonOpen->setEnabled(false);
+
+			emit statusChanged();
+			return;
+		}
+	}
+	else if (m_download) {
 		Engine::DownloadItem::DownloadState state{m_download->state()};
 		QString message{};
 		bool interupted{false};
@@ -196,6 +280,8 @@ void DownloadWidget::finished()
 		if (interupted) {
 			m_downloadInfoLabel->setText(message);
 			m_buttonOpen->setEnabled(false);
+
+			emit statusChanged();
 			return;
 		}
 	}
@@ -260,6 +346,9 @@ void DownloadWidget::setupUI()
 
 	m_spacerTop = new QSpacerItem(17, 1, QSizePolicy::Minimum, QSizePolicy::Expanding);
 
+	m_buttonPause = new QPushButton(tr("Pause"), this);
+	m_buttonPause->hide();
+
 	m_buttonStop = new QPushButton(tr("Stop"), this);
 
 	m_buttonOpen = new QPushButton(tr("Open"), this);
@@ -271,6 +360,7 @@ void DownloadWidget::setupUI()
 	m_layoutProgress->addWidget(m_downloadInfoLabel);
 
 	m_layoutButton->addItem(m_spacerTop);
+	m_layoutButton->addWidget(m_buttonPause);
 	m_layoutButton->addWidget(m_buttonStop);
 	m_layoutButton->addWidget(m_buttonOpen);
 	m_layoutButton->addItem(m_spacerBottom);
@@ -280,6 +370,44 @@ void DownloadWidget::setupUI()
 	m_layout->addLayout(m_layoutButton);
 }
 
+void DownloadWidget::setSegmentedDownload(SegmentedDownload* download)
+{
+	// The data of the web engine download is not needed anymore
+	if (m_download) {
+		m_download->disconnect(this);
+		m_download->cancel();
+	}
+
+	m_segmentedDownload = download;
+	m_segmentedDownload->setParent(this);
+
+	connect(m_segmentedDownload, &SegmentedDownload::downloadProgress, this, &DownloadWidget::downloadProgress);
+	connect(m_segmentedDownload, &SegmentedDownload::finished, this, &DownloadWidget::finished);
+	connect(m_buttonPause, &QPushButton::clicked, this, &DownloadWidget::pauseOrResume);
+
+	updatePauseButton();
+	downloadProgress(static_cast<quint64>(download->bytesReceived()), static_cast<quint64>(download->size()));
+}
+
+void DownloadWidget::updatePauseButton()
+{
+	switch (m_segmentedDownload->state()) {
+	case SegmentedDownload::InProgress:
+		m_buttonPause->setText(tr("Pause"));
+		m_buttonPause->show();
+		break;
+	case SegmentedDownload::Paused:
+	case SegmentedDownload::Failed:
+		m_buttonPause->setText(tr("Resume"));
+		m_buttonPause->setVisible(m_segmentedDownload->canResume());
+		break;
+	case SegmentedDownload::Completed:
+	case SegmentedDownload::Cancelled:
+		m_buttonPause->hide();
+		break;
+	}
+}
+
 void DownloadWidget::updateInfoLabel()
 {
 	quint64 byteTotal{static_cast<quint64>(m_progress->maximum())};
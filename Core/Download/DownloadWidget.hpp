@@ -46,6 +46,7 @@
 
 namespace Sn {
 class DownloadManager;
+class SegmentedDownload;
 
 class EllipseLabel;
 
@@ -54,6 +55,7 @@ Q_OBJECT
 
 public:
 	DownloadWidget(Engine::DownloadItem* download, QWidget* parent = nullptr);
+	DownloadWidget(SegmentedDownload* download, QWidget* parent = nullptr);
 
 	bool downloading() const;
 	bool downloadedSuccessfully() const;
@@ -68,6 +70,7 @@ signals:
 private slots:
 	void stop();
 	void open();
+	void pauseOrResume();
 
 	void downloadProgress(quint64 byteReceived, quint64 bytesTotal);
 	void finished();
@@ -75,6 +78,10 @@ private slots:
 private:
 	void setupUI();
 
+	// Replaces the web engine download, the widget takes the ownership of download
+	void setSegmentedDownload(SegmentedDownload* download);
+	void updatePauseButton();
+
 	void updateInfoLabel();
 	QString dataString(int size) const;
 
@@ -85,6 +92,7 @@ private:
 	bool m_stopped{};
 
 	QScopedPointer<Engine::DownloadItem> m_download;
+	SegmentedDownload* m_segmentedDownload{nullptr};
 
 	QHBoxLayout* m_layout{nullptr};
 	QVBoxLayout* m_layoutProgress{nullptr};
@@ -94,6 +102,7 @@ private:
 	QLabel* m_fileIcon{nullptr};
 	EllipseLabel* m_downloadInfoLabel{nullptr};
 	QSpacerItem* m_spacerTop{nullptr};
+	QPushButton* m_buttonPause{nullptr};
 	QPushButton* m_buttonStop{nullptr};
 	QPushButton* m_buttonOpen{nullptr};
 	QSpacerItem* m_spacerBottom{nullptr};
@@ -118,14 +118,14 @@ void History::addHistoryEntry(const QUrl& url, QString title)
 	QSqlQuery query(SqlDatabase::instance()->database());
 	query.prepare("SELECT id, count, date, title FROM history WHERE url=?");
 	query.bindValue(0, url);
-	query.exec();
+	SqlDatabase::exec(query);
 
 	if (!query.next()) {
 		query.prepare("INSERT INTO history (count, date, url, title) VALUES (1,?,?,?)");
 		query.bindValue(0, QDateTime::currentMSecsSinceEpoch());
 		query.bindValue(1, url);
 		query.bindValue(2, title);
-		query.exec();
+		SqlDatabase::exec(query);
 
 		int id = query.lastInsertId().toInt();
 		HistoryEntry entry;
@@ -147,7 +147,7 @@ void History::addHistoryEntry(const QUrl& url, QString title)
 		query.bindValue(0, QDateTime::currentMSecsSinceEpoch());
 		query.bindValue(1, title);
 		query.bindValue(2, url);
-		query.exec();
+		SqlDatabase::exec(query);
 
 		HistoryEntry before;
 		before.id = id;
@@ -185,7 +185,7 @@ void History::deleteHistoryEntry(const QList<int>& list)
 		QSqlQuery query{SqlDatabase::instance()->database()};
 		query.prepare("SELECT count, date, url, title FROM history WHERE id=?");
 		query.addBindValue(index);
-		query.exec();
+		SqlDatabase::exec(query);
 
 		if (!query.isActive() || !query.next())
 			continue;
@@ -200,11 +200,11 @@ void History::deleteHistoryEntry(const QList<int>& list)
 
 		query.prepare("DELETE FROM history WHERE id=?");
 		query.addBindValue(index);
-		query.exec();
+		SqlDatabase::exec(query);
 
 		query.prepare("DELETE FROM icons WHERE url=?");
 		query.addBindValue(entry.url.toEncoded(QUrl::RemoveFragment));
-		query.exec();
+		SqlDatabase::exec(query);
 
 		urls.append(entry.url);
 		emit historyEntryDeleted(entry);
@@ -221,7 +221,7 @@ void History::deleteHistoryEntry(const QString& url, const QString& title)
 	query.prepare("SELECT id FROM history WHERE url=? AND title=?");
 	query.bindValue(0, url);
 	query.bindValue(1, title);
-	query.exec();
+	SqlDatabase::exec(query);
 
 	if (query.next()) {
 		const int id{query.value(0).toInt()};
@@ -241,7 +241,7 @@ QList<int> History::indexesFromTimeRange(qint64 start, qint64 end)
 	query.prepare("SELECT id FROM history WHERE date BETWEEN ? AND ?");
 	query.addBindValue(end);
 	query.addBindValue(start);
-	query.exec();
+	SqlDatabase::exec(query);
 
 	while (query.next())
 		list.append(query.value(0).toInt());
@@ -254,7 +254,7 @@ bool History::urlIsStored(const QString& url)
 	QSqlQuery query{SqlDatabase::instance()->database()};
 	query.prepare("SELECT id FROM history WHERE url=?");
 	query.bindValue(0, url);
-	query.exec();
+	SqlDatabase::exec(query);
 
 	return query.next();
 }
@@ -265,7 +265,7 @@ QVector<History::HistoryEntry> History::mostVisited(int count)
 
 	QSqlQuery query{SqlDatabase::instance()->database()};
 	query.prepare(QString("SELECT count, date, id, title, url FROM history ORDER BY count DESC LIMIT %1").arg(count));
-	query.exec();
+	SqlDatabase::exec(query);
 
 	while (query.next()) {
 		HistoryEntry entry{};
@@ -31,6 +31,8 @@
 #include "History/History.hpp"
 #include "History/HistoryTreeView.hpp"
 
+#include "Utils/ThumbnailService.hpp"
+
 #include "Web/Tab/TabbedWebView.hpp"
 
 #include "Widgets/Tab/TabWidget.hpp"
@@ -170,6 +172,7 @@ void HistoryManager::clearHistory()
 		return;
 
 	Application::instance()->history()->clearHistory();
+	Application::instance()->thumbnailService()->clear();
 }
 
 void HistoryManager::keyPressEvent(QKeyEvent* event)
@@ -187,7 +187,7 @@ void HistoryMenu::aboutToShowClosedTabs()
 		return;
 
 	int i{0};
-	const QLinkedList<ClosedTabsManager::Tab> closedTabs = m_tabWidget->closedTabsManager()->allClosedTab();
+	const QVector<ClosedTabsManager::Tab> closedTabs = m_tabWidget->closedTabsManager()->allClosedTab();
 
 	foreach(const ClosedTabsManager::Tab& tab, closedTabs)
 	{
@@ -106,6 +106,7 @@ MaquetteGridTabsList *MaquetteGridManager::createTabsList(TabsSpaceSplitter::Sav
 		static_cast<Qt::ItemFlags>(Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled | Qt::
 		ItemIsDropEnabled));*/
 		list->addItem(item);
+		list->loadThumbnail(item);
 	}
 
 	m_tabsLists.append(list);
@@ -27,6 +27,7 @@
 #include <QMimeData>
 
 #include "Utils/AutoSaver.hpp"
+#include "Utils/ThumbnailService.hpp"
 
 #include "MaquetteGrid/MaquetteGridManager.hpp"
 
@@ -48,6 +49,7 @@ MaquetteGridTabsList::MaquetteGridTabsList(MaquetteGridManager* manager, QWidget
 	setDefaultDropAction(Qt::MoveAction);
 	setDragDropMode(QAbstractItemView::DragDrop);
 	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+	setIconSize(ThumbnailService::thumbnailSize() / 4);
 
 	m_deleteButton = new QPushButton("X", this);
 	m_deleteButton->setObjectName(QLatin1String("maquettegrid-tabslist-btn-delete-tabsspace"));
@@ -78,6 +80,18 @@ TabsSpaceSplitter::SavedTabsSpace MaquetteGridTabsList::tabsSpace()
 	return tabsSpace;
 }
 
+void MaquetteGridTabsList::loadThumbnail(QListWidgetItem* item)
+{
+	const QPersistentModelIndex index{indexFromItem(item)};
+
+	Application::instance()->thumbnailService()->thumbnail(item->data(MaquetteGridManager::UrlRole).toUrl(), this,
+														   [this, index](const QImage& image)
+	{
+		if (!image.isNull() && index.isValid())
+			itemFromIndex(index)->setIcon(QIcon(QPixmap::fromImage(image)));
+	});
+}
+
 void MaquetteGridTabsList::deleteItem()
 {
 	if (!currentItem())
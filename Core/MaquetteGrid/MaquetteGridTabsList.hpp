@@ -56,6 +56,9 @@ public:
 
 	MaquetteGridManager* manager() const { return m_maquetteGridManager; }
 
+	// Shows the preview of the page as icon of the item, if there is one
+	void loadThumbnail(QListWidgetItem* item);
+
 private slots:
 	void deleteItem();
 	void addTab();
@@ -29,17 +29,43 @@
 #include "SharedDefines.hpp"
 
 #include <QObject>
+#include <QStringList>
 
 #include <QWebEngine/UrlRequestInfo.hpp>
 
 namespace Sn {
 
+/*
+ * Interceptors are called on the network IO thread, in decreasing priority order, until one of them blocks or
+ * redirects the request. Priority, resource types, schemes and name are read once, when the interceptor is installed.
+ */
 class SIELO_SHAREDLIB BaseUrlInterceptor: public QObject {
 public:
+	enum Priority {
+		LowPriority = -100,
+		NormalPriority = 0,
+		HighPriority = 100
+	};
+
+	static const quint32 AllResourceTypes = 0xffffffff;
+
 	BaseUrlInterceptor(QObject* parent = nullptr) :
 		QObject(parent) {}
 
 	virtual void interceptRequest(Engine::UrlRequestInfo& info) = 0;
+
+	virtual int priority() const { return NormalPriority; }
+	// Mask of resourceTypeBit() values, requests of other types are not given to the interceptor
+	virtual quint32 resourceTypes() const { return AllResourceTypes; }
+	// Lowercase schemes of the requests given to the interceptor, all schemes if empty
+	virtual QStringList schemes() const { return QStringList(); }
+	// Shown with the interceptor timings on sielo:performance
+	virtual QString name() const { return QString::fromLatin1(metaObject()->className()); }
+
+	static quint32 resourceTypeBit(Engine::UrlRequestInfo::ResourceType type)
+	{
+		return type < 31 ? 1u << type : 1u << 31;
+	}
 };
 
 }
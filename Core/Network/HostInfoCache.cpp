@@ -0,0 +1,180 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/HostInfoCache.hpp"
+
+#include <QDateTime>
+
+#include "Utils/Settings.hpp"
+
+namespace Sn
+{
+// Hosts kept at most, expired entries are dropped first
+static const int MaximumEntries = 512;
+
+HostInfoCache::HostInfoCache(QObject* parent) :
+	QObject(parent)
+{
+	setResolver(Resolver());
+	loadSettings();
+}
+
+HostInfoCache::~HostInfoCache()
+{
+	// Empty
+}
+
+void HostInfoCache::loadSettings()
+{
+	Settings settings{};
+
+	m_prefetchEnabled = settings.value(QLatin1String("Web-Settings/dnsPrefetch"), false).toBool();
+}
+
+void HostInfoCache::lookup(const QString& host, QObject* context, const Callback& callback)
+{
+	const QString key{host.toLower()};
+	const qint64 now{QDateTime::currentMSecsSinceEpoch()};
+	const auto entry = m_entries.constFind(key);
+
+	if (entry != m_entries.constEnd() && entry->expiration > now) {
+		++m_hits;
+		callback(entry->info);
+		return;
+	}
+
+	Waiter waiter{};
+	waiter.context = context;
+	waiter.callback = callback;
+
+	// A running lookup, possibly started by prefetch() with no waiter, answers this one too
+	const bool running{m_pending.contains(key)};
+
+	m_pending[key].append(waiter);
+
+	if (!running)
+		resolve(key);
+}
+
+void HostInfoCache::prefetch(const QString& host)
+{
+	if (!m_prefetchEnabled || host.isEmpty())
+		return;
+
+	const QString key{host.toLower()};
+
+	if (m_pending.contains(key) || contains(key))
+		return;
+
+	++m_prefetches;
+
+	m_pending.insert(key, QVector<Waiter>());
+	resolve(key);
+}
+
+bool HostInfoCache::contains(const QString& host) const
+{
+	const auto entry = m_entries.constFind(host.toLower());
+
+	return entry != m_entries.constEnd() && entry->expiration > QDateTime::currentMSecsSinceEpoch();
+}
+
+void HostInfoCache::setResolver(const Resolver& resolver)
+{
+	if (resolver) {
+		m_resolver = resolver;
+		return;
+	}
+
+	m_resolver = [this](const QString& host, const Callback& callback)
+	{
+		QHostInfo::lookupHost(host, this, callback);
+	};
+}
+
+void HostInfoCache::setTimeToLive(qint64 milliseconds, qint64 failureMilliseconds)
+{
+	m_timeToLive = milliseconds;
+	m_failureTimeToLive = failureMilliseconds;
+}
+
+void HostInfoCache::clear()
+{
+	m_entries.clear();
+}
+
+void HostInfoCache::resolve(const QString& host)
+{
+	++m_lookups;
+
+	m_resolver(host, [this, host](const QHostInfo& info)
+	{
+		lookupFinished(host, info);
+	});
+}
+
+void HostInfoCache::lookupFinished(const QString& host, const QHostInfo& info)
+{
+	const qint64 now{QDateTime::currentMSecsSinceEpoch()};
+	const bool failed{info.error() != QHostInfo::NoError || info.addresses().isEmpty()};
+
+	if (m_entries.count() >= MaximumEntries && !m_entries.contains(host))
+		evictExpired(now);
+
+	Entry entry{};
+	entry.info = info;
+	entry.expiration = now + (failed ? m_failureTimeToLive : m_timeToLive);
+
+	m_entries.insert(host, entry);
+
+	const QVector<Waiter> waiters{m_pending.take(host)};
+
+	foreach (const Waiter& waiter, waiters) {
+		if (waiter.context)
+			waiter.callback(info);
+	}
+}
+
+void HostInfoCache::evictExpired(qint64 now)
+{
+	for (auto it = m_entries.begin(); it != m_entries.end();) {
+		if (it->expiration <= now)
+			it = m_entries.erase(it);
+		else
+			++it;
+	}
+
+	// Still full of live entries: the one expiring first makes room
+	if (m_entries.count() >= MaximumEntries) {
+		auto oldest = m_entries.begin();
+
+		for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+			if (it->expiration < oldest->expiration)
+				oldest = it;
+		}
+
+		m_entries.erase(oldest);
+	}
+}
+}
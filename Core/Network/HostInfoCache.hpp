@@ -0,0 +1,111 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_HOSTINFOCACHE_HPP
+#define SIELOBROWSER_HOSTINFOCACHE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+#include <QPointer>
+
+#include <QHostInfo>
+
+#include <QHash>
+#include <QVector>
+
+#include <functional>
+
+namespace Sn
+{
+/*
+ * Host name lookups shared by the whole browser. Each host is resolved once, its result is kept for a fixed time to
+ * live (QHostInfo doesn't give the one of the DNS record) and every caller asking for it meanwhile, or while the
+ * lookup is running, gets the same result.
+ *
+ * When enabled, prefetch() resolves hosts the user is likely to visit soon, links hovered and top address bar
+ * suggestions, so the system resolver cache is warm when the web engine asks for them.
+ *
+ * The resolver can be replaced, to run the cache against a local stub instead of the network.
+ */
+class SIELO_SHAREDLIB HostInfoCache: public QObject {
+Q_OBJECT
+
+public:
+	typedef std::function<void(const QHostInfo&)> Callback;
+	// Must call the callback exactly once, on the GUI thread
+	typedef std::function<void(const QString& host, const Callback& callback)> Resolver;
+
+	HostInfoCache(QObject* parent = nullptr);
+	~HostInfoCache();
+
+	void loadSettings();
+
+	// The callback is called right away if the host is cached, and not at all if context is destroyed before
+	void lookup(const QString& host, QObject* context, const Callback& callback);
+	void prefetch(const QString& host);
+
+	bool contains(const QString& host) const;
+	bool isPrefetchEnabled() const { return m_prefetchEnabled; }
+
+	void setResolver(const Resolver& resolver);
+	void setTimeToLive(qint64 milliseconds, qint64 failureMilliseconds);
+	void clear();
+
+	qint64 hitCount() const { return m_hits; }
+	qint64 lookupCount() const { return m_lookups; }
+	qint64 prefetchCount() const { return m_prefetches; }
+
+private:
+	struct Entry {
+		QHostInfo info{};
+		qint64 expiration{0};
+	};
+
+	struct Waiter {
+		QPointer<QObject> context{};
+		Callback callback{};
+	};
+
+	void resolve(const QString& host);
+	void lookupFinished(const QString& host, const QHostInfo& info);
+	void evictExpired(qint64 now);
+
+	Resolver m_resolver{};
+
+	QHash<QString, Entry> m_entries{};
+	QHash<QString, QVector<Waiter>> m_pending{};
+
+	qint64 m_timeToLive{60 * 1000};
+	qint64 m_failureTimeToLive{10 * 1000};
+	bool m_prefetchEnabled{false};
+
+	qint64 m_hits{0};
+	qint64 m_lookups{0};
+	qint64 m_prefetches{0};
+};
+}
+
+#endif //SIELOBROWSER_HOSTINFOCACHE_HPP
@@ -212,15 +212,13 @@ void NetworkManager::installUrlInterceptor(BaseUrlInterceptor* interceptor)
 	m_urlInterceptor->installUrlInterceptor(interceptor);
 }
 
-void NetworkManager::removeUrlInterceptor(BaseUrlInterceptor* interceptor)
+bool NetworkManager::removeUrlInterceptor(BaseUrlInterceptor* interceptor)
 {
-	m_urlInterceptor->removeUrlInterceptor(interceptor);
+	return m_urlInterceptor->removeUrlInterceptor(interceptor);
 }
 
 void NetworkManager::loadSettings()
 {
-	m_urlInterceptor->loadSettings();
-
 	Settings settings{};
 
 	settings.beginGroup("Proxy-Settings");
@@ -48,7 +48,8 @@ public:
 	void proxyAuthentication(const QString& proxyHost, QAuthenticator* auth, QWidget* parent = nullptr);
 
 	void installUrlInterceptor(BaseUrlInterceptor* interceptor);
-	void removeUrlInterceptor(BaseUrlInterceptor* interceptor);
+	bool removeUrlInterceptor(BaseUrlInterceptor* interceptor);
+	NetworkUrlInterceptor* urlInterceptor() const { return m_urlInterceptor; }
 
 	void loadSettings();
 
@@ -24,49 +24,183 @@
 
 #include "Network/NetworkUrlInterceptor.hpp"
 
-#include <QList>
+#include <QMutexLocker>
+#include <QElapsedTimer>
 
-#include "Utils/Settings.hpp"
+#include <QDebug>
+
+#include "Utils/SettingsSnapshot.hpp"
 
 #include "Network/BaseUrlInterceptor.hpp"
+#include "Network/RequestAccounting.hpp"
 
 namespace Sn {
 
+// Interceptor whose chain is running on this thread, to refuse removals made from inside interceptRequest()
+static thread_local const NetworkUrlInterceptor* s_runningInterceptor{nullptr};
+
 NetworkUrlInterceptor::NetworkUrlInterceptor(QObject* parent) :
 	Engine::UrlRequestInterceptor(parent),
-	m_sendDNT(false)
+	m_chain(std::make_shared<const Chain>())
 {
 	// Empty
 }
 
 void NetworkUrlInterceptor::interceptUrlRequest(Engine::UrlRequestInfo& info)
 {
-	if (m_sendDNT)
+	if (SettingsSnapshot::current()->sendDoNotTrack)
 		info.setHttpHeader(QByteArrayLiteral("DNT"), QByteArrayLiteral("1"));
 
-		foreach (BaseUrlInterceptor* interceptor, m_interceptors) interceptor->interceptRequest(info);
+	const std::shared_ptr<const Chain> interceptors{acquireChain()};
+	const quint32 resourceType{BaseUrlInterceptor::resourceTypeBit(info.resourceType())};
+	const NetworkUrlInterceptor* outerInterceptor{s_runningInterceptor};
+	QElapsedTimer timer{};
+
+	s_runningInterceptor = this;
+
+	for (const Entry& entry : interceptors->entries) {
+		if (!(entry.resourceTypes & resourceType))
+			continue;
+		if (!entry.schemes.isEmpty() && !entry.schemes.contains(info.scheme()))
+			continue;
+
+		timer.start();
+		entry.interceptor->interceptRequest(info);
+		entry.timing->record(timer.nsecsElapsed());
+
+		if (info.isBlocked() || info.isRedirected())
+			break;
+	}
+
+	s_runningInterceptor = outerInterceptor;
+	releaseChain(interceptors.get());
+
+	RequestAccounting::record(info);
 }
 
 void NetworkUrlInterceptor::installUrlInterceptor(BaseUrlInterceptor* interceptor)
 {
-	if (!m_interceptors.contains(interceptor))
-		m_interceptors.append(interceptor);
+	QMutexLocker locker{&m_writeMutex};
+
+	QVector<Entry> interceptors{chain()->entries};
+
+	for (const Entry& entry : interceptors) {
+		if (entry.interceptor == interceptor)
+			return;
+	}
+
+	Entry entry{};
+	entry.interceptor = interceptor;
+	entry.priority = interceptor->priority();
+	entry.resourceTypes = interceptor->resourceTypes();
+	entry.schemes = interceptor->schemes();
+	entry.name = interceptor->name();
+	entry.timing = std::make_shared<TimingHistogram>();
+
+	// Interceptors of a same priority keep their installation order
+	int index{0};
+
+	while (index < interceptors.count() && interceptors[index].priority >= entry.priority)
+		++index;
+
+	interceptors.insert(index, entry);
+
+	publishChain(interceptors);
+}
+
+bool NetworkUrlInterceptor::removeUrlInterceptor(BaseUrlInterceptor* interceptor)
+{
+	// The running chain holds the interceptor we would wait for: this would never return
+	if (s_runningInterceptor == this) {
+		qWarning() << "NetworkUrlInterceptor: can't remove an interceptor while a request is being intercepted";
+		return false;
+	}
+
+	std::shared_ptr<const Chain> previous{};
+
+	{
+		QMutexLocker locker{&m_writeMutex};
+
+		QVector<Entry> interceptors{chain()->entries};
+		bool removed{false};
+
+		for (int i{0}; i < interceptors.count(); ++i) {
+			if (interceptors[i].interceptor == interceptor) {
+				interceptors.remove(i);
+				removed = true;
+				break;
+			}
+		}
+
+		if (!removed)
+			return false;
+
+		previous = chain();
+		publishChain(interceptors);
+	}
+
+	// Requests started before the new chain was published may still be calling the interceptor
+	QMutexLocker locker{&m_quiescentMutex};
+
+	while (previous->users.load() > 0)
+		m_quiescent.wait(&m_quiescentMutex);
+
+	return true;
+}
+
+QVector<NetworkUrlInterceptor::InterceptorTiming> NetworkUrlInterceptor::timings() const
+{
+	QVector<InterceptorTiming> timings{};
+	const std::shared_ptr<const Chain> interceptors{chain()};
+
+	for (const Entry& entry : interceptors->entries) {
+		InterceptorTiming timing{};
+		timing.name = entry.name;
+		timing.priority = entry.priority;
+		timing.summary = entry.timing->summary();
+
+		timings.append(timing);
+	}
+
+	return timings;
 }
 
-void NetworkUrlInterceptor::removeUrlInterceptor(BaseUrlInterceptor* interceptor)
+std::shared_ptr<const NetworkUrlInterceptor::Chain> NetworkUrlInterceptor::chain() const
 {
-	m_interceptors.removeOne(interceptor);
+	return std::atomic_load(&m_chain);
 }
 
-void NetworkUrlInterceptor::loadSettings()
+std::shared_ptr<const NetworkUrlInterceptor::Chain> NetworkUrlInterceptor::acquireChain()
 {
-	Settings settings{};
+	// Registering as a user and checking the chain wasn't retired in the meantime pairs with publishChain() retiring
+	// it then counting its users, so either the request moves to the newer chain or the remover waits for it
+	forever {
+		std::shared_ptr<const Chain> current{chain()};
+
+		current->users.fetch_add(1);
+
+		if (!current->retired.load())
+			return current;
 
-	settings.beginGroup("Web-Settings");
+		releaseChain(current.get());
+	}
+}
 
-	m_sendDNT = settings.value("DoNotTrack", false).toBool();
+void NetworkUrlInterceptor::releaseChain(const Chain* chain)
+{
+	if (chain->users.fetch_sub(1) == 1 && chain->retired.load()) {
+		QMutexLocker locker{&m_quiescentMutex};
+		m_quiescent.wakeAll();
+	}
+}
+
+void NetworkUrlInterceptor::publishChain(const QVector<Entry>& entries)
+{
+	auto next = std::make_shared<Chain>();
+	next->entries = entries;
 
-	settings.endGroup();
+	const std::shared_ptr<const Chain> previous{std::atomic_exchange(&m_chain, std::shared_ptr<const Chain>(next))};
+	previous->retired.store(true);
 }
 
 }
\ No newline at end of file
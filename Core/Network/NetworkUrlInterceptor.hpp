@@ -29,27 +29,75 @@
 #include "SharedDefines.hpp"
 
 #include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QStringList>
 
 #include <QWebEngine/UrlRequestInterceptor.hpp>
 #include <QWebEngine/UrlRequestInfo.hpp>
 
+#include <atomic>
+#include <memory>
+
+#include "Utils/Metrics.hpp"
+
 namespace Sn {
 class BaseUrlInterceptor;
 
+/*
+ * Runs the installed interceptors on each request. The chain is copy-on-write: the IO thread takes a reference on the
+ * current chain for the duration of a request, while installing or removing an interceptor publishes a new chain.
+ * Removing waits until the requests still running on the previous chain are done, so the interceptor can be deleted
+ * right after. An interceptor can't remove itself, or any other, from inside interceptRequest(): this is refused and
+ * removeUrlInterceptor() returns false. Interceptors must not wait on the GUI thread either, as removing one from
+ * there would wait on them in turn.
+ */
 class SIELO_SHAREDLIB NetworkUrlInterceptor: public Engine::UrlRequestInterceptor {
 public:
+	struct InterceptorTiming {
+		QString name{};
+		int priority{0};
+		Metrics::TimingSummary summary{};
+	};
+
 	NetworkUrlInterceptor(QObject* parent = nullptr);
 
 	void interceptUrlRequest(Engine::UrlRequestInfo& info) Q_DECL_OVERRIDE;
 
 	void installUrlInterceptor(BaseUrlInterceptor* interceptor);
-	void removeUrlInterceptor(BaseUrlInterceptor* interceptor);
+	bool removeUrlInterceptor(BaseUrlInterceptor* interceptor);
 
-	void loadSettings();
+	QVector<InterceptorTiming> timings() const;
 
 private:
-	QList<BaseUrlInterceptor*> m_interceptors;
-	bool m_sendDNT{false};
+	struct Entry {
+		BaseUrlInterceptor* interceptor{nullptr};
+		int priority{0};
+		quint32 resourceTypes{0};
+		QStringList schemes{};
+		QString name{};
+		std::shared_ptr<TimingHistogram> timing{};
+	};
+
+	struct Chain {
+		QVector<Entry> entries{};
+
+		// Requests currently running on this chain, and whether a newer chain replaced it
+		mutable std::atomic<int> users{0};
+		mutable std::atomic<bool> retired{false};
+	};
+
+	std::shared_ptr<const Chain> chain() const;
+	std::shared_ptr<const Chain> acquireChain();
+	void releaseChain(const Chain* chain);
+	void publishChain(const QVector<Entry>& entries);
+
+	QMutex m_writeMutex{};
+	std::shared_ptr<const Chain> m_chain{};
+
+	QMutex m_quiescentMutex{};
+	QWaitCondition m_quiescent{};
 };
 }
 
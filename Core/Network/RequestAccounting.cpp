@@ -0,0 +1,235 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/RequestAccounting.hpp"
+
+#include <QObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+#include <atomic>
+
+namespace Sn
+{
+namespace
+{
+const int SlotCount = 2048;
+
+struct HostSlot {
+	// 0 while the slot is free, written last when the owning thread claims the slot
+	std::atomic<uint> hash{0};
+	QString host{};
+
+	std::atomic<qint64> requests{0};
+	std::atomic<qint64> blocked{0};
+	std::atomic<qint64> categories[RequestAccounting::CategoryCount]{};
+};
+
+struct ThreadTable {
+	HostSlot hosts[SlotCount];
+	HostSlot overflow{};
+};
+
+struct Registry {
+	QMutex mutex{};
+	QVector<ThreadTable*> tables{};
+};
+
+Q_GLOBAL_STATIC(Registry, registry)
+
+// Tables are never freed, so what finished threads counted is still reported
+ThreadTable* threadTable()
+{
+	thread_local ThreadTable* table{nullptr};
+
+	if (!table) {
+		table = new ThreadTable();
+
+		QMutexLocker locker(&registry()->mutex);
+		registry()->tables.append(table);
+	}
+
+	return table;
+}
+
+uint slotHash(const QString& host)
+{
+	// 0 marks free slots
+	return qMax(1u, qHash(host));
+}
+
+HostSlot* findSlot(ThreadTable* table, const QString& host)
+{
+	const uint hash{slotHash(host)};
+
+	for (int i{0}; i < SlotCount; ++i) {
+		HostSlot& slot{table->hosts[(hash + i) % SlotCount]};
+		const uint slotHash{slot.hash.load(std::memory_order_relaxed)};
+
+		if (slotHash == 0) {
+			slot.host = host;
+			slot.hash.store(hash, std::memory_order_release);
+			return &slot;
+		}
+
+		if (slotHash == hash && slot.host == host)
+			return &slot;
+	}
+
+	return &table->overflow;
+}
+
+void addSlot(const HostSlot& slot, RequestAccounting::Usage& usage)
+{
+	usage.requests += slot.requests.load(std::memory_order_relaxed);
+	usage.blocked += slot.blocked.load(std::memory_order_relaxed);
+
+	for (int i{0}; i < RequestAccounting::CategoryCount; ++i)
+		usage.categories[i] += slot.categories[i].load(std::memory_order_relaxed);
+}
+
+QVector<ThreadTable*> tables()
+{
+	QMutexLocker locker(&registry()->mutex);
+	return registry()->tables;
+}
+}
+
+RequestAccounting::Usage& RequestAccounting::Usage::operator+=(const Usage& other)
+{
+	requests += other.requests;
+	blocked += other.blocked;
+
+	for (int i{0}; i < CategoryCount; ++i)
+		categories[i] += other.categories[i];
+
+	return *this;
+}
+
+void RequestAccounting::record(const Engine::UrlRequestInfo& info)
+{
+	HostSlot* slot{findSlot(threadTable(), info.firstPartyHost())};
+
+	slot->requests.fetch_add(1, std::memory_order_relaxed);
+	slot->categories[category(info.resourceType())].fetch_add(1, std::memory_order_relaxed);
+
+	if (info.isBlocked())
+		slot->blocked.fetch_add(1, std::memory_order_relaxed);
+}
+
+RequestAccounting::Usage RequestAccounting::usage(const QString& firstPartyHost)
+{
+	Usage usage{};
+	const uint hash{slotHash(firstPartyHost)};
+
+	foreach (ThreadTable* table, tables()) {
+		for (int i{0}; i < SlotCount; ++i) {
+			const HostSlot& slot{table->hosts[(hash + i) % SlotCount]};
+			const uint slotHash{slot.hash.load(std::memory_order_acquire)};
+
+			if (slotHash == 0)
+				break;
+
+			if (slotHash == hash && slot.host == firstPartyHost) {
+				addSlot(slot, usage);
+				break;
+			}
+		}
+	}
+
+	return usage;
+}
+
+QHash<QString, RequestAccounting::Usage> RequestAccounting::allUsage()
+{
+	QHash<QString, Usage> usages{};
+
+	foreach (ThreadTable* table, tables()) {
+		for (int i{0}; i < SlotCount; ++i) {
+			const HostSlot& slot{table->hosts[i]};
+
+			if (slot.hash.load(std::memory_order_acquire) != 0)
+				addSlot(slot, usages[slot.host]);
+		}
+
+		Usage overflow{};
+		addSlot(table->overflow, overflow);
+
+		if (overflow.requests > 0)
+			usages[QString()] += overflow;
+	}
+
+	return usages;
+}
+
+RequestAccounting::ResourceCategory RequestAccounting::category(Engine::UrlRequestInfo::ResourceType type)
+{
+	switch (type) {
+	case Engine::UrlRequestInfo::ResourceTypeMainFrame:
+	case Engine::UrlRequestInfo::ResourceTypeSubFrame:
+		return Documents;
+	case Engine::UrlRequestInfo::ResourceTypeScript:
+	case Engine::UrlRequestInfo::ResourceTypeWorker:
+	case Engine::UrlRequestInfo::ResourceTypeSharedWorker:
+	case Engine::UrlRequestInfo::ResourceTypeServiceWorker:
+		return Scripts;
+	case Engine::UrlRequestInfo::ResourceTypeStylesheet:
+		return Stylesheets;
+	case Engine::UrlRequestInfo::ResourceTypeImage:
+	case Engine::UrlRequestInfo::ResourceTypeFavicon:
+		return Images;
+	case Engine::UrlRequestInfo::ResourceTypeFontResource:
+		return Fonts;
+	case Engine::UrlRequestInfo::ResourceTypeMedia:
+		return Media;
+	case Engine::UrlRequestInfo::ResourceTypeXhr:
+		return Xhr;
+	default:
+		return OtherResources;
+	}
+}
+
+QString RequestAccounting::categoryName(ResourceCategory category)
+{
+	switch (category) {
+	case Documents:
+		return QObject::tr("Documents");
+	case Scripts:
+		return QObject::tr("Scripts");
+	case Stylesheets:
+		return QObject::tr("Stylesheets");
+	case Images:
+		return QObject::tr("Images");
+	case Fonts:
+		return QObject::tr("Fonts");
+	case Media:
+		return QObject::tr("Media");
+	case Xhr:
+		return QObject::tr("XHR");
+	default:
+		return QObject::tr("Other");
+	}
+}
+}
@@ -0,0 +1,77 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_REQUESTACCOUNTING_HPP
+#define SIELOBROWSER_REQUESTACCOUNTING_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QString>
+#include <QHash>
+
+#include <QWebEngine/UrlRequestInfo.hpp>
+
+namespace Sn
+{
+/*
+ * Requests seen by the url interceptor, counted per first party host. Counting happens on the network IO thread:
+ * each thread owns a fixed table of hosts that only it inserts into, so recording a request is a probe in that table
+ * and a few relaxed atomic increments. Readers merge the tables of every thread. Once a table is full, new hosts are
+ * counted under an empty host name.
+ */
+class SIELO_SHAREDLIB RequestAccounting {
+public:
+	enum ResourceCategory {
+		Documents,
+		Scripts,
+		Stylesheets,
+		Images,
+		Fonts,
+		Media,
+		Xhr,
+		OtherResources,
+		CategoryCount
+	};
+
+	struct Usage {
+		qint64 requests{0};
+		qint64 blocked{0};
+		qint64 categories[CategoryCount]{};
+
+		Usage& operator+=(const Usage& other);
+	};
+
+	// Must be called once every interceptor had the opportunity to block the request
+	static void record(const Engine::UrlRequestInfo& info);
+
+	static Usage usage(const QString& firstPartyHost);
+	static QHash<QString, Usage> allUsage();
+
+	static ResourceCategory category(Engine::UrlRequestInfo::ResourceType type);
+	static QString categoryName(ResourceCategory category);
+};
+}
+
+#endif //SIELOBROWSER_REQUESTACCOUNTING_HPP
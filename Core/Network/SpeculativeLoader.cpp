@@ -0,0 +1,238 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/SpeculativeLoader.hpp"
+
+#include <QTimer>
+
+#include "Network/HostInfoCache.hpp"
+
+#include "Utils/Metrics.hpp"
+#include "Utils/ProcessMemory.hpp"
+#include "Utils/Settings.hpp"
+
+#include "Web/WebPage.hpp"
+#include "Web/Tab/TabLifecycleManager.hpp"
+
+#include "Application.hpp"
+
+namespace Sn
+{
+// A prediction the user didn't commit meanwhile is dropped after this delay
+static const int ExpirationDelay = 30 * 1000;
+
+SpeculativeLoader::SpeculativeLoader(QObject* parent) :
+	QObject(parent),
+	m_expireTimer(new QTimer(this))
+{
+	m_expireTimer->setSingleShot(true);
+	m_expireTimer->setInterval(ExpirationDelay);
+	m_clock.start();
+
+	connect(m_expireTimer, &QTimer::timeout, this, &SpeculativeLoader::discard);
+
+	loadSettings();
+}
+
+SpeculativeLoader::~SpeculativeLoader()
+{
+	reset();
+}
+
+void SpeculativeLoader::loadSettings()
+{
+	Settings settings{};
+
+	settings.beginGroup("Web-Settings");
+
+	m_enabled = settings.value(QLatin1String("speculativeLoading"), true).toBool();
+	m_prerenderEnabled = settings.value(QLatin1String("speculativePrerender"), false).toBool();
+	m_actionsPerMinute = settings.value(QLatin1String("speculativeLoadingPerMinute"), 6).toInt();
+	m_prerenderMemory = settings.value(QLatin1String("speculativePrerenderMemory"), 256).toLongLong() * 1024 * 1024;
+
+	settings.endGroup();
+
+	if (!m_enabled)
+		cancel();
+	else if (!m_prerenderEnabled && m_page) {
+		m_page->deleteLater();
+		m_page = nullptr;
+	}
+}
+
+void SpeculativeLoader::predict(const QUrl& url, double confidence)
+{
+	if (!m_enabled || !url.isValid() || url.host().isEmpty() || confidence < m_preconnectThreshold)
+		return;
+
+	const QString key{matchKey(url)};
+
+	if (key == m_key) {
+		// The prediction got more likely while the user kept typing
+		if (!m_page && confidence >= m_prerenderThreshold)
+			prerender();
+
+		m_expireTimer->start();
+		return;
+	}
+
+	discard();
+
+	if (!spendBudget())
+		return;
+
+	m_url = url;
+	m_key = key;
+	m_expireTimer->start();
+
+	Metrics::increment(Metrics::SpeculativePredictions);
+
+	// The result only has to land in the system resolver cache, the web engine will ask it again. Like hovered links,
+	// this is left out unless DNS prefetching is enabled
+	Application::instance()->hostInfoCache()->prefetch(url.host());
+
+	if (confidence >= m_prerenderThreshold)
+		prerender();
+}
+
+void SpeculativeLoader::textChanged(const QString& text)
+{
+	if (m_key.isEmpty())
+		return;
+
+	const QString typed{text.trimmed()};
+
+	if (typed.isEmpty() || !m_url.toString().contains(typed, Qt::CaseInsensitive))
+		discard();
+}
+
+void SpeculativeLoader::cancel()
+{
+	discard();
+}
+
+WebPage* SpeculativeLoader::commit(const QUrl& url, bool canSwap)
+{
+	if (m_key.isEmpty())
+		return nullptr;
+
+	WebPage* page{nullptr};
+
+	if (matchKey(url) == m_key) {
+		Metrics::increment(Metrics::SpeculativeHits);
+
+		if (canSwap && m_page) {
+			page = m_page;
+			page->setParent(nullptr);
+			page->setPrerendering(false);
+			m_page = nullptr;
+		}
+	}
+	else {
+		Metrics::increment(Metrics::SpeculativeWasted);
+	}
+
+	reset();
+
+	return page;
+}
+
+void SpeculativeLoader::prerender()
+{
+	if (!m_prerenderEnabled || !hasMemoryForPrerender() || !spendBudget())
+		return;
+
+	m_page = new WebPage(this);
+	m_page->setPrerendering(true);
+	m_page->load(m_url);
+
+	Metrics::increment(Metrics::SpeculativePrerenders);
+}
+
+void SpeculativeLoader::discard()
+{
+	if (m_key.isEmpty())
+		return;
+
+	Metrics::increment(Metrics::SpeculativeWasted);
+
+	reset();
+}
+
+void SpeculativeLoader::reset()
+{
+	m_url = QUrl();
+	m_key.clear();
+	m_expireTimer->stop();
+
+	if (m_page) {
+		m_page->deleteLater();
+		m_page = nullptr;
+	}
+}
+
+bool SpeculativeLoader::spendBudget()
+{
+	const qint64 now{m_clock.elapsed()};
+
+	while (!m_recentActions.isEmpty() && now - m_recentActions.first() >= 60 * 1000)
+		m_recentActions.removeFirst();
+
+	if (m_recentActions.count() >= m_actionsPerMinute)
+		return false;
+
+	m_recentActions.append(now);
+	return true;
+}
+
+bool SpeculativeLoader::hasMemoryForPrerender() const
+{
+	const qint64 used{ProcessMemory::totalResidentBytes()};
+
+	// Unknown usage, one hidden page at most is still a bounded cost
+	if (used == 0)
+		return true;
+
+	return used + m_prerenderMemory <= Application::instance()->tabLifecycleManager()->memoryBudget();
+}
+
+QString SpeculativeLoader::matchKey(const QUrl& url)
+{
+	// Typed urls have no scheme yet, and "www." or a trailing slash don't make another page
+	const QUrl normalized{url.scheme().isEmpty() ? QUrl::fromUserInput(url.toString()) : url};
+	QString host{normalized.host().toLower()};
+	QString path{normalized.path()};
+
+	if (host.startsWith(QLatin1String("www.")))
+		host.remove(0, 4);
+
+	while (path.endsWith(QLatin1Char('/')))
+		path.chop(1);
+
+	if (normalized.hasQuery())
+		path += QLatin1Char('?') + normalized.query();
+
+	return host + path;
+}
+}
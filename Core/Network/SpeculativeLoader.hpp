@@ -0,0 +1,104 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_SPECULATIVELOADER_HPP
+#define SIELOBROWSER_SPECULATIVELOADER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+#include <QUrl>
+#include <QVector>
+
+#include <QElapsedTimer>
+
+class QTimer;
+
+namespace Sn
+{
+class WebPage;
+
+/*
+ * Prepares the navigation the user is the most likely to commit from the address bar. Once the top suggestion is
+ * likely enough, its host is resolved ahead of time when DNS prefetching is enabled. Above a second threshold, and
+ * only if enabled, the page is also loaded in a hidden WebPage which replaces the page of the tab when the user opens
+ * it, or just leaves the connections and the HTTP cache of the profile warm otherwise.
+ *
+ * Only one navigation is prepared at a time, a few per minute at most, and nothing is prerendered when the
+ * browser is already close to the memory budget of the tabs. A prediction is dropped as soon as the address bar
+ * text doesn't match it anymore.
+ */
+class SIELO_SHAREDLIB SpeculativeLoader: public QObject {
+Q_OBJECT
+
+public:
+	SpeculativeLoader(QObject* parent = nullptr);
+	~SpeculativeLoader();
+
+	void loadSettings();
+
+	// Confidence goes from 0 to 1, how likely the user is to open url
+	void predict(const QUrl& url, double confidence);
+	void textChanged(const QString& text);
+	void cancel();
+
+	/*
+	 * The user navigates to url. Returns the page prerendered for it, owned by the caller from now on, or nullptr.
+	 * When the caller can't swap its page the prerendered one is dropped.
+	 */
+	WebPage* commit(const QUrl& url, bool canSwap);
+
+	bool isEnabled() const { return m_enabled; }
+	bool isPrerenderEnabled() const { return m_prerenderEnabled; }
+
+private:
+	void prerender();
+	void discard();
+	void reset();
+
+	bool spendBudget();
+	bool hasMemoryForPrerender() const;
+
+	static QString matchKey(const QUrl& url);
+
+	QUrl m_url{};
+	QString m_key{};
+	WebPage* m_page{nullptr};
+
+	QTimer* m_expireTimer{nullptr};
+	QElapsedTimer m_clock{};
+	QVector<qint64> m_recentActions{};
+
+	bool m_enabled{true};
+	bool m_prerenderEnabled{false};
+	double m_preconnectThreshold{0.3};
+	double m_prerenderThreshold{0.6};
+	int m_actionsPerMinute{6};
+	qint64 m_prerenderMemory{0};
+};
+}
+
+#endif //SIELOBROWSER_SPECULATIVELOADER_HPP
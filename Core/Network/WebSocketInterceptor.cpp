@@ -0,0 +1,59 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/WebSocketInterceptor.hpp"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+namespace Sn {
+
+WebSocketInterceptor::WebSocketInterceptor(QObject* parent) :
+	BaseUrlInterceptor(parent)
+{
+	// Empty
+}
+
+void WebSocketInterceptor::interceptRequest(Engine::UrlRequestInfo& info)
+{
+	const QString& host{info.firstPartyHost()};
+
+	{
+		QReadLocker locker{&m_lock};
+
+		if (m_hosts.contains(host))
+			return;
+	}
+
+	QWriteLocker locker{&m_lock};
+	m_hosts.insert(host);
+}
+
+bool WebSocketInterceptor::hasOpenedWebSockets(const QString& host) const
+{
+	QReadLocker locker{&m_lock};
+
+	return m_hosts.contains(host.toLower());
+}
+}
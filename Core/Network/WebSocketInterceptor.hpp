@@ -0,0 +1,61 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_WEBSOCKETINTERCEPTOR_HPP
+#define SIELOBROWSER_WEBSOCKETINTERCEPTOR_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QSet>
+#include <QReadWriteLock>
+
+#include "Network/BaseUrlInterceptor.hpp"
+
+namespace Sn {
+/*
+ * Remembers the first party hosts whose pages opened a WebSocket. The handshake goes through the url interceptors,
+ * so nothing has to run in the page to know it. Hosts are kept for the whole session.
+ */
+class SIELO_SHAREDLIB WebSocketInterceptor: public BaseUrlInterceptor {
+public:
+	WebSocketInterceptor(QObject* parent = nullptr);
+
+	void interceptRequest(Engine::UrlRequestInfo& info);
+
+	// Sockets blocked by another interceptor never reach it
+	int priority() const { return LowPriority; }
+	QStringList schemes() const { return QStringList() << QStringLiteral("ws") << QStringLiteral("wss"); }
+	QString name() const { return QStringLiteral("WebSockets"); }
+
+	// Thread safe
+	bool hasOpenedWebSockets(const QString& host) const;
+
+private:
+	QSet<QString> m_hosts{};
+	mutable QReadWriteLock m_lock{};
+};
+}
+
+#endif //SIELOBROWSER_WEBSOCKETINTERCEPTOR_HPP
@@ -0,0 +1,249 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "BackgroundCompositor.hpp"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <QCryptographicHash>
+#include <QMutexLocker>
+#include <QVector>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#include "Utils/DataPaths.hpp"
+
+namespace Sn
+{
+// Number of cached blurred images, one per window size and wallpaper in practice
+static const int CACHE_SIZE = 8;
+// Number of lines blurred by a single task
+static const int TILE_SIZE = 32;
+// Radius above which the image is blurred at a lower resolution
+static const int DOWNSCALE_RADIUS = 16;
+// Number of blurred wallpapers kept on disk, the least recently written are removed first
+static const int DISK_CACHE_SIZE = 8;
+
+Q_GLOBAL_STATIC(BackgroundCompositor, sn_background_compositor);
+
+BackgroundCompositor::BackgroundCompositor(QObject* parent) :
+	QObject(parent),
+	m_cache(CACHE_SIZE)
+{
+	// Empty
+}
+
+BackgroundCompositor::~BackgroundCompositor()
+{
+	// Empty
+}
+
+BackgroundCompositor* BackgroundCompositor::instance()
+{
+	return sn_background_compositor();
+}
+
+QString BackgroundCompositor::blurredImagePath(const QString& imagePath, int radius)
+{
+	QFile file{imagePath};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return QString();
+
+	const QByteArray data{file.readAll()};
+	file.close();
+
+	const QString hash{QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex())};
+	const QString cachePath{DataPaths::path(DataPaths::Cache) + QLatin1String("/backgrounds")};
+	const QString blurredPath{QString("%1/%2-%3.png").arg(cachePath, hash, QString::number(radius))};
+
+	if (QFileInfo::exists(blurredPath))
+		return blurredPath;
+
+	QImage image{};
+
+	if (!image.loadFromData(data))
+		return QString();
+
+	QDir().mkpath(cachePath);
+
+	if (!blur(image, radius).save(blurredPath, "PNG"))
+		return QString();
+
+	pruneDiskCache(cachePath);
+
+	return blurredPath;
+}
+
+QImage BackgroundCompositor::blurred(const QImage& image, int radius)
+{
+	const quint64 key{imageKey(image, radius)};
+
+	{
+		QMutexLocker locker{&m_cacheMutex};
+
+		if (QImage* cached = m_cache.object(key))
+			return *cached;
+	}
+
+	const QImage result{blur(image, radius)};
+
+	QMutexLocker locker{&m_cacheMutex};
+	m_cache.insert(key, new QImage(result));
+
+	return result;
+}
+
+QImage BackgroundCompositor::blur(const QImage& image, int radius)
+{
+	if (image.isNull() || radius < 1)
+		return image;
+
+	QImage result{image.convertToFormat(QImage::Format_ARGB32_Premultiplied)};
+
+	// A box blur of a large radius loses all details anyway, so it's done on a smaller copy of the image
+	int factor{1};
+
+	if (radius > DOWNSCALE_RADIUS)
+		factor = qMin(radius / (DOWNSCALE_RADIUS / 2), qMin(result.width(), result.height()) / 16);
+
+	if (factor > 1) {
+		const QSize originalSize{result.size()};
+
+		result = result.scaled(originalSize / factor, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+		boxBlur(result, radius / factor);
+
+		return result.scaled(originalSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	}
+
+	boxBlur(result, radius);
+
+	return result;
+}
+
+void BackgroundCompositor::boxBlur(QImage& image, int radius)
+{
+	const int width{image.width()};
+	const int height{image.height()};
+	const int stride{image.bytesPerLine() / 4};
+	quint32* pixels{reinterpret_cast<quint32*>(image.bits())};
+
+	QVector<int> rowTiles{};
+	QVector<int> columnTiles{};
+
+	for (int row{0}; row < height; row += TILE_SIZE)
+		rowTiles.append(row);
+
+	for (int column{0}; column < width; column += TILE_SIZE)
+		columnTiles.append(column);
+
+	// Three box blurs are close enough to a gaussian blur
+	for (int pass{0}; pass < 3; ++pass) {
+		QtConcurrent::blockingMap(rowTiles, [=](int first)
+		{
+			QVector<quint32> buffer(width);
+
+			for (int row{first}; row < qMin(first + TILE_SIZE, height); ++row)
+				boxBlurLine(pixels + row * stride, 1, width, qMin(radius, width / 2), buffer.data());
+		});
+
+		QtConcurrent::blockingMap(columnTiles, [=](int first)
+		{
+			QVector<quint32> buffer(height);
+
+			for (int column{first}; column < qMin(first + TILE_SIZE, width); ++column)
+				boxBlurLine(pixels + column, stride, height, qMin(radius, height / 2), buffer.data());
+		});
+	}
+}
+
+void BackgroundCompositor::boxBlurLine(quint32* line, int stride, int length, int radius, quint32* buffer)
+{
+	if (radius < 1 || length < 2)
+		return;
+
+	// Running sums of each channel, the edges of the line are extended
+	const quint32 multiplier{(1u << 16) / static_cast<quint32>(radius * 2 + 1)};
+	quint32 sums[4]{0, 0, 0, 0};
+
+	auto addPixel = [&sums](quint32 pixel)
+	{
+		for (int channel{0}; channel < 4; ++channel)
+			sums[channel] += (pixel >> (channel * 8)) & 0xff;
+	};
+	auto removePixel = [&sums](quint32 pixel)
+	{
+		for (int channel{0}; channel < 4; ++channel)
+			sums[channel] -= (pixel >> (channel * 8)) & 0xff;
+	};
+
+	for (int i{-radius}; i <= radius; ++i)
+		addPixel(line[qBound(0, i, length - 1) * stride]);
+
+	for (int i{0}; i < length; ++i) {
+		quint32 pixel{0};
+
+		for (int channel{0}; channel < 4; ++channel)
+			pixel |= qMin<quint32>((sums[channel] * multiplier + (1u << 15)) >> 16, 0xff) << (channel * 8);
+
+		buffer[i] = pixel;
+
+		addPixel(line[qMin(i + radius + 1, length - 1) * stride]);
+		removePixel(line[qMax(i - radius, 0) * stride]);
+	}
+
+	for (int i{0}; i < length; ++i)
+		line[i * stride] = buffer[i];
+}
+
+void BackgroundCompositor::pruneDiskCache(const QString& cachePath)
+{
+	// Previous wallpapers and radii are never asked again once the settings changed
+	const QFileInfoList files{
+		QDir(cachePath).entryInfoList(QStringList() << QLatin1String("*.png"), QDir::Files, QDir::Time)
+	};
+
+	for (int i{DISK_CACHE_SIZE}; i < files.count(); ++i)
+		QFile::remove(files[i].absoluteFilePath());
+}
+
+quint64 BackgroundCompositor::imageKey(const QImage& image, int radius)
+{
+	// Window shots are new images every time, so they are identified by their content
+	QCryptographicHash hash{QCryptographicHash::Md5};
+
+	hash.addData(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+	hash.addData(reinterpret_cast<const char*>(&radius), sizeof(radius));
+
+	const QByteArray result{hash.result()};
+	quint64 key{0};
+
+	for (int i{0}; i < 8; ++i)
+		key = (key << 8) | static_cast<quint8>(result.at(i));
+
+	return key;
+}
+}
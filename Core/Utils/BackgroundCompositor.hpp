@@ -0,0 +1,77 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_BACKGROUNDCOMPOSITOR_HPP
+#define SIELOBROWSER_BACKGROUNDCOMPOSITOR_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+#include <QImage>
+#include <QString>
+#include <QCache>
+#include <QMutex>
+
+namespace Sn
+{
+/*
+ * Blurs backgrounds for the transparent theme effects. Images are blurred with three separable box blur passes
+ * (an approximation of a gaussian blur whose cost doesn't depend on the radius), split in tiles of lines
+ * processed by the global thread pool. Large radii are applied on a downscaled copy of the image.
+ *
+ * Results are cached in memory by content and radius, and wallpapers are also cached on disk so warm starts
+ * don't blur them again.
+ */
+class SIELO_SHAREDLIB BackgroundCompositor: public QObject {
+	Q_OBJECT
+
+public:
+	BackgroundCompositor(QObject* parent = nullptr);
+	~BackgroundCompositor();
+
+	static BackgroundCompositor* instance();
+
+	// Path of the blurred version of the wallpaper at "imagePath", blurring it only if it's not in the disk cache
+	QString blurredImagePath(const QString& imagePath, int radius);
+
+	// Thread safe, may be called from a worker thread
+	QImage blurred(const QImage& image, int radius);
+
+	static QImage blur(const QImage& image, int radius);
+
+private:
+	static void boxBlur(QImage& image, int radius);
+	static void boxBlurLine(quint32* line, int stride, int length, int radius, quint32* buffer);
+
+	static void pruneDiskCache(const QString& cachePath);
+	static quint64 imageKey(const QImage& image, int radius);
+
+	QCache<quint64, QImage> m_cache;
+	QMutex m_cacheMutex{};
+};
+}
+
+#endif //SIELOBROWSER_BACKGROUNDCOMPOSITOR_HPP
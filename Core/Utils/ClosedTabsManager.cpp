@@ -24,72 +24,289 @@
 
 #include "Utils/ClosedTabsManager.hpp"
 
+#include <QFile>
+#include <QDataStream>
+#include <QtEndian>
+
 #include <QWebEngine/WebHistory.hpp>
 
 #include "Application.hpp"
 
+#include "Utils/DataPaths.hpp"
+#include "Utils/IconProvider.hpp"
+#include "Utils/Settings.hpp"
+
 #include "Web/Tab/WebTab.hpp"
 
 namespace Sn {
 
-ClosedTabsManager::ClosedTabsManager()
+static const int CLOSED_TAB_VERSION = 1;
+
+// Above this size, the oldest half of the spill file is dropped
+static const qint64 MaxSpillFileSize = 4 * 1024 * 1024;
+
+ClosedTabsManager::ClosedTabsManager(QObject* parent) :
+	QObject(parent)
 {
-	// Empty
+	Settings settings{};
+	const int capacity{settings.value("Web-Settings/closedTabsCount", 20).toInt()};
+
+	m_entries.resize(qMax(1, capacity));
+
+	// The spill file is shared by the whole profile, only this manager uses it
+	m_spillEnabled = !Application::instance()->privateBrowsing();
+
+	if (m_spillEnabled)
+		refill();
+}
+
+ClosedTabsManager::~ClosedTabsManager()
+{
+	if (!m_spillEnabled)
+		return;
+
+	// Oldest first, so the most recently closed tab is at the end of the file
+	for (int i{m_count - 1}; i >= 0; --i)
+		spillEntry(entryAt(i));
 }
 
 void ClosedTabsManager::saveTab(WebTab* tab, int position)
 {
-	if (Application::instance()->privateBrowsing())
+	if (!m_spillEnabled)
 		return;
 
 	if (tab->url().isEmpty() && tab->history()->itemCount() == 0)
 		return;
 
-	Tab closedTab;
-	closedTab.url = tab->url();
-	closedTab.title = tab->title();
-	closedTab.icon = tab->icon();
-	closedTab.position = position;
-	closedTab.history = tab->historyData();
-	closedTab.zoomLevel = tab->zoomLevel();
+	Entry entry{};
+	entry.url = tab->url();
+	entry.title = tab->title();
+	entry.position = position;
+	entry.compressedHistory = qCompress(tab->historyData());
+	entry.zoomLevel = tab->zoomLevel();
+
+	const int capacity{m_entries.count()};
 
-	m_closedTabs.prepend(closedTab);
+	m_first = (m_first + capacity - 1) % capacity;
 
+	// The slot of the new first entry holds the oldest one when the buffer is full
+	if (m_count == capacity)
+		spillEntry(m_entries[m_first]);
+	else
+		++m_count;
+
+	m_entries[m_first] = entry;
+
+	emit changed();
 }
 
 ClosedTabsManager::Tab ClosedTabsManager::takeLastClosedTab()
+{
+	return takeTabAt(0);
+}
+
+ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
 {
 	Tab tab;
 	tab.position = -1;
 
-	if (m_closedTabs.count() > 0)
-		tab = m_closedTabs.takeFirst();
+	if (index < 0 || index >= m_count)
+		return tab;
+
+	tab = tabFromEntry(entryAt(index), true);
+
+	for (int i{index}; i < m_count - 1; ++i)
+		entryAt(i) = entryAt(i + 1);
+
+	entryAt(m_count - 1) = Entry();
+	--m_count;
+
+	if (m_spillEnabled)
+		refill();
+
+	emit changed();
 
 	return tab;
 }
 
-ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
+QVector<ClosedTabsManager::Tab> ClosedTabsManager::allClosedTab() const
 {
-	Tab tab;
-	tab.position = -1;
+	QVector<Tab> tabs{};
+	tabs.reserve(m_count);
 
-	QLinkedList<Tab>::iterator it;
-	int i = 0;
+	for (int i{0}; i < m_count; ++i)
+		tabs.append(tabFromEntry(entryAt(i), false));
 
-	for (it = m_closedTabs.begin(); it != m_closedTabs.end(); ++it, ++i) {
-		if (i == index) {
-			tab = *it;
-			m_closedTabs.erase(it);
-			break;
-		}
-	}
+	return tabs;
+}
+
+void ClosedTabsManager::clearList()
+{
+	m_entries.fill(Entry());
+	m_first = 0;
+	m_count = 0;
+
+	if (m_spillEnabled)
+		QFile::remove(spillFilePath());
+
+	emit changed();
+}
+
+ClosedTabsManager::Entry& ClosedTabsManager::entryAt(int index)
+{
+	return m_entries[(m_first + index) % m_entries.count()];
+}
+
+const ClosedTabsManager::Entry& ClosedTabsManager::entryAt(int index) const
+{
+	return m_entries[(m_first + index) % m_entries.count()];
+}
+
+ClosedTabsManager::Tab ClosedTabsManager::tabFromEntry(const Entry& entry, bool withHistory) const
+{
+	Tab tab{};
+	tab.url = entry.url;
+	tab.title = entry.title;
+	tab.icon = IconProvider::iconForUrl(entry.url);
+	tab.position = entry.position;
+	tab.zoomLevel = entry.zoomLevel;
+
+	if (withHistory)
+		tab.history = qUncompress(entry.compressedHistory);
 
 	return tab;
 }
 
-void ClosedTabsManager::clearList()
+void ClosedTabsManager::append(const Entry& entry)
+{
+	Q_ASSERT(m_count < m_entries.count());
+
+	m_entries[(m_first + m_count) % m_entries.count()] = entry;
+	++m_count;
+}
+
+void ClosedTabsManager::refill()
 {
-	m_closedTabs.clear();
+	Entry entry{};
+
+	while (m_count < m_entries.count() && takeSpilledEntry(entry))
+		append(entry);
 }
 
-}
\ No newline at end of file
+QString ClosedTabsManager::spillFilePath()
+{
+	return DataPaths::currentProfilePath() + QLatin1String("/closedtabs.dat");
+}
+
+/*
+ * The spill file is a sequence of records, each one followed by its size so the most recent record can be read from
+ * the end of the file and removed by truncating it.
+ */
+void ClosedTabsManager::spillEntry(const Entry& entry)
+{
+	QByteArray record{};
+	QDataStream stream{&record, QIODevice::WriteOnly};
+
+	stream << CLOSED_TAB_VERSION;
+	stream << entry.url;
+	stream << entry.title;
+	stream << entry.position;
+	stream << entry.zoomLevel;
+	stream << entry.compressedHistory;
+
+	uchar size[4];
+	qToBigEndian<quint32>(static_cast<quint32>(record.size()), size);
+	record.append(reinterpret_cast<const char*>(size), 4);
+
+	QFile file{spillFilePath()};
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+		return;
+
+	file.write(record);
+	file.close();
+
+	if (file.size() > MaxSpillFileSize)
+		compactSpillFile();
+}
+
+bool ClosedTabsManager::takeSpilledEntry(Entry& entry)
+{
+	QFile file{spillFilePath()};
+
+	if (!file.exists() || !file.open(QIODevice::ReadWrite))
+		return false;
+
+	const qint64 fileSize{file.size()};
+
+	if (fileSize < 4) {
+		file.remove();
+		return false;
+	}
+
+	file.seek(fileSize - 4);
+	const QByteArray size{file.read(4)};
+	const qint64 recordSize{qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(size.constData()))};
+
+	if (recordSize > fileSize - 4) {
+		file.remove();
+		return false;
+	}
+
+	const qint64 recordStart{fileSize - 4 - recordSize};
+
+	file.seek(recordStart);
+	const QByteArray record{file.read(recordSize)};
+
+	if (recordStart == 0)
+		file.remove();
+	else
+		file.resize(recordStart);
+
+	QDataStream stream{record};
+	int version{0};
+
+	stream >> version;
+
+	if (version < 1)
+		return false;
+
+	stream >> entry.url;
+	stream >> entry.title;
+	stream >> entry.position;
+	stream >> entry.zoomLevel;
+	stream >> entry.compressedHistory;
+
+	return stream.status() == QDataStream::Ok;
+}
+
+void ClosedTabsManager::compactSpillFile()
+{
+	QFile file{spillFilePath()};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	const QByteArray data{file.readAll()};
+	file.close();
+
+	// Walk the records from the end until half of the maximum size is kept
+	qint64 start{data.size()};
+
+	while (start >= 4) {
+		const qint64 recordSize{qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(data.constData() + start - 4))};
+		const qint64 recordStart{start - 4 - recordSize};
+
+		if (recordStart < 0 || data.size() - recordStart > MaxSpillFileSize / 2)
+			break;
+
+		start = recordStart;
+	}
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return;
+
+	file.write(data.constData() + start, data.size() - start);
+}
+
+}
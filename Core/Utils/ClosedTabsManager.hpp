@@ -28,14 +28,24 @@
 
 #include "SharedDefines.hpp"
 
+#include <QObject>
+
 #include <QUrl>
 #include <QIcon>
-#include <QLinkedList>
+#include <QVector>
 
 namespace Sn {
 class WebTab;
 
-class SIELO_SHAREDLIB ClosedTabsManager {
+/*
+ * Keeps the most recently closed tabs of every tabs space in a ring buffer of "Web-Settings/closedTabsCount" entries,
+ * with their navigation history compressed. Older entries are appended to a file in the profile, from which they are
+ * taken back when tabs are restored, and the remaining entries are written there when the manager is destroyed so
+ * the list survives restarts. There is a single manager, owned by the application, so the file has one owner.
+ */
+class SIELO_SHAREDLIB ClosedTabsManager: public QObject {
+Q_OBJECT
+
 public:
 	struct Tab {
 		QUrl url{};
@@ -52,19 +62,50 @@ public:
 		}
 	};
 
-	ClosedTabsManager();
+	ClosedTabsManager(QObject* parent = nullptr);
+	~ClosedTabsManager();
 
 	void saveTab(WebTab* tab, int position);
-	bool isClosedTabAvailable() { return !m_closedTabs.isEmpty(); }
+	bool isClosedTabAvailable() { return m_count > 0; }
+	int count() const { return m_count; }
 
 	Tab takeLastClosedTab();
 	Tab takeTabAt(int index);
 
-	QLinkedList<Tab> allClosedTab() { return m_closedTabs; }
+	// Closed tabs in memory, most recent first. Their history is not decompressed, take them to restore it
+	QVector<Tab> allClosedTab() const;
 	void clearList();
 
+signals:
+	void changed();
+
 private:
-	QLinkedList<Tab> m_closedTabs;
+	struct Entry {
+		QUrl url{};
+		QString title{};
+		QByteArray compressedHistory{};
+
+		int position{};
+		int zoomLevel{};
+	};
+
+	Entry& entryAt(int index);
+	const Entry& entryAt(int index) const;
+	Tab tabFromEntry(const Entry& entry, bool withHistory) const;
+
+	void append(const Entry& entry);
+	void refill();
+
+	static QString spillFilePath();
+	static void spillEntry(const Entry& entry);
+	static bool takeSpilledEntry(Entry& entry);
+	static void compactSpillFile();
+
+	QVector<Entry> m_entries{};
+	int m_first{0};
+	int m_count{0};
+
+	bool m_spillEnabled{true};
 };
 }
 Q_DECLARE_TYPEINFO(Sn::ClosedTabsManager::Tab, Q_MOVABLE_TYPE);
@@ -70,6 +70,10 @@ void CommandLineOption::parseActions()
 	openWindowOption.setValueName(QStringLiteral("URL"));
 	openWindowOption.setDescription(QStringLiteral("Opens URL in new window."));
 
+	QCommandLineOption traceStartupOption{QStringLiteral("trace-startup")};
+	traceStartupOption.setValueName(QStringLiteral("file"));
+	traceStartupOption.setDescription(QStringLiteral("Writes a Chrome trace of the startup in file."));
+
 	QCommandLineParser parser{};
 	parser.setApplicationDescription(QStringLiteral("A fast web browser in C++ with Qt"));
 
@@ -84,6 +88,7 @@ void CommandLineOption::parseActions()
 	parser.addOption(profileOption);
 	parser.addOption(currentTabOption);
 	parser.addOption(openWindowOption);
+	parser.addOption(traceStartupOption);
 
 	parser.addPositionalArgument(QStringLiteral("URL"), QStringLiteral("URLs to open"), QStringLiteral("[URL...]"));
 
@@ -101,6 +106,14 @@ void CommandLineOption::parseActions()
 		return;
 	}
 
+	if (parser.isSet(traceStartupOption)) {
+		ActionPair pair;
+		pair.action = Application::CL_TraceStartup;
+		pair.text = QFileInfo(parser.value(traceStartupOption)).absoluteFilePath();
+
+		m_actions.append(pair);
+	}
+
 	if (parser.isSet(privateBrowsingOption)) {
 		ActionPair pair;
 		pair.action = Application::CL_StartPrivateBrowsing;
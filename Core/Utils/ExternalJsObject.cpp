@@ -28,6 +28,7 @@
 #include "Web/WebPage.hpp"
 
 #include "Utils/AutoFillJsObject.hpp"
+#include "Utils/HoveredLinkJsObject.hpp"
 
 namespace Sn {
 static QHash<QString, QObject*> s_extraObjects;
@@ -53,7 +54,8 @@ void ExternalJsObject::unregisterExtraObject(const QString& id)
 ExternalJsObject::ExternalJsObject(WebPage* page) :
 	QObject(page),
 	m_page(page),
-	m_autoFill(new AutoFillJsObject(this))
+	m_autoFill(new AutoFillJsObject(this)),
+	m_hoveredLink(new HoveredLinkJsObject(this))
 {
 	// Empty
 }
@@ -68,4 +70,9 @@ QObject* ExternalJsObject::autoFill() const
 	return m_autoFill;
 }
 
+QObject* ExternalJsObject::hoveredLink() const
+{
+	return m_hoveredLink;
+}
+
 }
@@ -36,6 +36,7 @@
 
 namespace Sn {
 class AutoFillJsObject;
+class HoveredLinkJsObject;
 
 class SIELO_SHAREDLIB ExternalJsObject: public QObject {
 Q_OBJECT
@@ -43,6 +44,7 @@ Q_OBJECT
 				   READ
 					   autoFill
 				   CONSTANT)
+	Q_PROPERTY(QObject* hoveredLink READ hoveredLink CONSTANT)
 
 public:
 	explicit ExternalJsObject(WebPage* page);
@@ -56,9 +58,11 @@ public:
 
 private:
 	QObject* autoFill() const;
+	QObject* hoveredLink() const;
 
 	WebPage* m_page;
 	AutoFillJsObject* m_autoFill;
+	HoveredLinkJsObject* m_hoveredLink;
 };
 }
 #endif //SIELO_BROWSER_EXTERNALJSOBJECT_HPP
@@ -0,0 +1,52 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELO_BROWSER_HOVEREDLINKJSOBJECT_HPP
+#define SIELO_BROWSER_HOVEREDLINKJSOBJECT_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+namespace Sn {
+
+class ExternalJsObject;
+
+class SIELO_SHAREDLIB HoveredLinkJsObject: public QObject {
+Q_OBJECT
+public:
+	explicit HoveredLinkJsObject(ExternalJsObject* parent);
+
+public slots:
+	// Called by the hovered link reporter script with the link viewport rectangle, or an empty url
+	void update(const QString& url, double x, double y, double width, double height);
+
+private:
+	ExternalJsObject* m_jsObject;
+};
+
+}
+
+#endif //SIELO_BROWSER_HOVEREDLINKJSOBJECT_HPP
@@ -31,6 +31,7 @@
 #include "Database/SqlDatabase.hpp"
 
 #include "Utils/AutoSaver.hpp"
+#include "Utils/Metrics.hpp"
 
 #include "Web/WebView.hpp"
 
@@ -109,10 +110,14 @@ QImage IconProvider::imageForUrl(const QUrl& url, bool allowNull)
 	// Check if we aleady have the image loaded in the buffer
 	foreach(const BufferedIcon &ic, instance()->m_iconBuffer)
 	{
-		if (encodeUrl(ic.first) == encodedUrl)
+		if (encodeUrl(ic.first) == encodedUrl) {
+			Metrics::increment(Metrics::FaviconCacheHits);
 			return ic.second;
+		}
 	}
 
+	Metrics::increment(Metrics::FaviconCacheMisses);
+
 	QString urlString{QString::fromUtf8(encodedUrl)};
 	urlString.replace(QLatin1Char('['), QStringLiteral("[["));
 	urlString.replace(QLatin1Char(']'), QStringLiteral("[]]"));
@@ -123,7 +128,7 @@ QImage IconProvider::imageForUrl(const QUrl& url, bool allowNull)
 	QSqlQuery query{SqlDatabase::instance()->database()};
 	query.prepare("SELECT icon FROM icons WHERE url GLOB ? LIMIT 1");
 	query.addBindValue(QString("%1*").arg(urlString));
-	query.exec();
+	SqlDatabase::exec(query);
 
 	if (query.next())
 		return QImage::fromData(query.value(0).toByteArray());
@@ -157,7 +162,7 @@ QImage IconProvider::imageForDomain(const QUrl& url, bool allowNull)
 	QSqlQuery query{SqlDatabase::instance()->database()};
 	query.prepare("SELECT icon FROM icons WHERE url GLOB ? LIMIT 1");
 	query.addBindValue(QString("*%1*").arg(urlString));
-	query.exec();
+	SqlDatabase::exec(query);
 
 	if (query.next())
 		return QImage::fromData(query.value(0).toByteArray());
@@ -177,7 +182,7 @@ void IconProvider::save()
 		QSqlQuery query{SqlDatabase::instance()->database()};
 		query.prepare("SELECT id FROM icons WHERE url = ?");
 		query.bindValue(0, encodeUrl(ic.first));
-		query.exec();
+		SqlDatabase::exec(query);
 
 		if (query.next())
 			query.prepare("UPDATE icons SET icon = ? WHERE url = ?");
@@ -192,7 +197,7 @@ void IconProvider::save()
 
 		query.bindValue(0, buffer.data());
 		query.bindValue(1, QString::fromUtf8(encodeUrl(ic.first)));
-		query.exec();
+		SqlDatabase::exec(query);
 	}
 
 	m_iconBuffer.clear();
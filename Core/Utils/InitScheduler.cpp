@@ -0,0 +1,234 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/InitScheduler.hpp"
+
+#include <QTimer>
+
+#include <QDebug>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "Utils/Trace.hpp"
+
+namespace Sn
+{
+InitScheduler::InitScheduler(QObject* parent) :
+	QObject(parent)
+{
+	// Empty
+}
+
+InitScheduler::~InitScheduler()
+{
+	// Worker tasks use the application, they can't outlive it
+	foreach (const Task& task, m_tasks) {
+		if (task.watcher)
+			task.watcher->waitForFinished();
+	}
+}
+
+void InitScheduler::addTask(const QString& name, Thread thread, const std::function<void()>& work,
+							const QStringList& dependencies, Priority priority)
+{
+	Q_ASSERT(!m_tasks.contains(name));
+
+	Task task{};
+	task.traceName = name.toUtf8();
+	task.thread = thread;
+	task.priority = priority;
+	task.work = work;
+
+	foreach (const QString& dependency, dependencies) {
+		Q_ASSERT_X(m_tasks.contains(dependency), "InitScheduler::addTask", "unknown dependency");
+
+		if (m_tasks.contains(dependency))
+			task.dependencies.append(dependency);
+	}
+
+	m_tasks.insert(name, task);
+	m_order.append(name);
+
+	// GUI tasks are never run from addTask itself, the caller may not expect it
+	QTimer::singleShot(0, this, &InitScheduler::startReadyTasks);
+
+	if (thread == WorkerThread && isReady(m_tasks[name]))
+		start(name);
+}
+
+bool InitScheduler::isFinished(const QString& name) const
+{
+	return m_tasks.value(name).state == Finished;
+}
+
+bool InitScheduler::isIdle() const
+{
+	if (!m_deferredReleased)
+		return false;
+
+	foreach (const Task& task, m_tasks) {
+		if (task.state != Finished)
+			return false;
+	}
+
+	return true;
+}
+
+void InitScheduler::waitFor(const QString& name)
+{
+	if (!m_tasks.contains(name) || m_tasks[name].state == Finished)
+		return;
+
+	foreach (const QString& dependency, m_tasks[name].dependencies) waitFor(dependency);
+
+	Task& task{m_tasks[name]};
+
+	if (task.thread == GuiThread) {
+		// A running GUI task is on the stack below us: it can't finish before we return
+		if (task.state == Running) {
+			qWarning() << "InitScheduler: task" << name << "waited for from its own work, it is not finished yet";
+			Q_ASSERT_X(false, "InitScheduler::waitFor", "re-entered for a running GUI thread task");
+			return;
+		}
+
+		runGuiTask(name);
+		return;
+	}
+
+	if (task.state == Pending)
+		start(name);
+
+	m_tasks[name].watcher->waitForFinished();
+	finish(name);
+}
+
+void InitScheduler::releaseDeferred()
+{
+	if (m_deferredReleased)
+		return;
+
+	m_deferredReleased = true;
+	startReadyTasks();
+
+	if (isIdle())
+		emit idle();
+}
+
+void InitScheduler::workerFinished()
+{
+	QFutureWatcher<void>* watcher{static_cast<QFutureWatcher<void>*>(sender())};
+
+	foreach (const QString& name, m_order) {
+		if (m_tasks[name].watcher == watcher) {
+			finish(name);
+			break;
+		}
+	}
+}
+
+bool InitScheduler::isReady(const Task& task) const
+{
+	if (task.state != Pending || (task.priority == Deferred && !m_deferredReleased))
+		return false;
+
+	foreach (const QString& dependency, task.dependencies) {
+		if (m_tasks[dependency].state != Finished)
+			return false;
+	}
+
+	return true;
+}
+
+void InitScheduler::startReadyTasks()
+{
+	// Tasks are started in the order they were added, which keeps GUI tasks deterministic
+	foreach (const QString& name, m_order) {
+		if (isReady(m_tasks[name]))
+			start(name);
+	}
+}
+
+void InitScheduler::start(const QString& name)
+{
+	Task& task{m_tasks[name]};
+
+	if (task.thread == GuiThread) {
+		runGuiTask(name);
+		return;
+	}
+
+	task.state = Running;
+	task.watcher = new QFutureWatcher<void>(this);
+	connect(task.watcher, &QFutureWatcher<void>::finished, this, &InitScheduler::workerFinished);
+
+	const std::function<void()> work{task.work};
+	const QByteArray traceName{task.traceName};
+
+	task.watcher->setFuture(QtConcurrent::run([work, traceName]()
+	{
+#ifdef SIELO_TRACING
+		TraceSpan span{traceName.constData()};
+#else
+		Q_UNUSED(traceName);
+#endif
+		work();
+	}));
+}
+
+void InitScheduler::runGuiTask(const QString& name)
+{
+	m_tasks[name].state = Running;
+
+	// The task can add other tasks, which may move it inside the hash
+	const std::function<void()> work{m_tasks[name].work};
+
+	{
+#ifdef SIELO_TRACING
+		TraceSpan span{m_tasks[name].traceName.constData()};
+#endif
+		work();
+	}
+
+	finish(name);
+}
+
+void InitScheduler::finish(const QString& name)
+{
+	Task& task{m_tasks[name]};
+
+	// A worker waited for with waitFor() still reports through its watcher
+	if (task.state == Finished)
+		return;
+
+	task.state = Finished;
+	task.work = nullptr;
+
+	emit taskFinished(name);
+
+	startReadyTasks();
+
+	if (isIdle())
+		emit idle();
+}
+}
@@ -0,0 +1,118 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_INITSCHEDULER_HPP
+#define SIELOBROWSER_INITSCHEDULER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+
+#include <QFutureWatcher>
+
+#include <functional>
+
+namespace Sn
+{
+/*
+ * Runs the initialization work of the application as a graph of named tasks. A task starts once all of its
+ * dependencies finished, either on the GUI thread or on a worker of the global thread pool. Worker tasks must only do
+ * file or CPU work: they can't use Settings nor any QObject of the GUI thread, a GUI task depending on them does that.
+ *
+ * Deferred tasks also wait for releaseDeferred(), which the application calls once the first window painted.
+ * Dependencies must be added before the tasks depending on them, so the graph can't have cycles.
+ */
+class SIELO_SHAREDLIB InitScheduler: public QObject {
+Q_OBJECT
+
+public:
+	enum Thread {
+		GuiThread,
+		WorkerThread
+	};
+
+	enum Priority {
+		Critical,
+		Deferred
+	};
+
+	InitScheduler(QObject* parent = nullptr);
+	~InitScheduler();
+
+	void addTask(const QString& name, Thread thread, const std::function<void()>& work,
+				 const QStringList& dependencies = QStringList(), Priority priority = Critical);
+
+	bool contains(const QString& name) const { return m_tasks.contains(name); }
+	bool isFinished(const QString& name) const;
+	bool isDeferredReleased() const { return m_deferredReleased; }
+	bool isIdle() const;
+
+	// Blocks the GUI thread until the task finished, starting it and its dependencies right away if needed.
+	// A GUI thread task must not wait for itself, directly or through the tasks it runs: this asserts.
+	void waitFor(const QString& name);
+
+signals:
+	void taskFinished(const QString& name);
+	// Every task added so far finished, deferred ones included
+	void idle();
+
+public slots:
+	void releaseDeferred();
+
+private slots:
+	void workerFinished();
+
+private:
+	enum State {
+		Pending,
+		Running,
+		Finished
+	};
+
+	struct Task {
+		QByteArray traceName{};
+		Thread thread{GuiThread};
+		Priority priority{Critical};
+		State state{Pending};
+		std::function<void()> work{};
+		QStringList dependencies{};
+		QFutureWatcher<void>* watcher{nullptr};
+	};
+
+	bool isReady(const Task& task) const;
+	void startReadyTasks();
+	void start(const QString& name);
+	void runGuiTask(const QString& name);
+	void finish(const QString& name);
+
+	QHash<QString, Task> m_tasks{};
+	QStringList m_order{};
+	bool m_deferredReleased{false};
+};
+}
+
+#endif //SIELOBROWSER_INITSCHEDULER_HPP
@@ -0,0 +1,247 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/Metrics.hpp"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <QtAlgorithms>
+
+#include <atomic>
+#include <cmath>
+
+namespace Sn
+{
+namespace
+{
+const int BucketCount = Metrics::HistogramBucketCount;
+
+struct ThreadMetrics {
+	std::atomic<qint64> counters[Metrics::CounterCount];
+	std::atomic<qint64> timingCounts[Metrics::TimingCount];
+	std::atomic<qint64> timingTotals[Metrics::TimingCount];
+	std::atomic<qint64> timingBuckets[Metrics::TimingCount][BucketCount];
+};
+
+struct Registry {
+	QMutex mutex{};
+	QVector<ThreadMetrics*> threads{};
+	QVector<QPair<QString, qint64>> startupPhases{};
+};
+
+Q_GLOBAL_STATIC(Registry, registry)
+
+// Blocks are never freed, so what finished threads recorded is still counted
+ThreadMetrics* threadMetrics()
+{
+	thread_local ThreadMetrics* metrics{nullptr};
+
+	if (!metrics) {
+		metrics = new ThreadMetrics();
+
+		QMutexLocker locker{&registry()->mutex};
+		registry()->threads.append(metrics);
+	}
+
+	return metrics;
+}
+
+// Only the owning thread writes to its block, a plain load and store is enough
+void add(std::atomic<qint64>& value, qint64 amount)
+{
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+int bucket(qint64 nanoseconds)
+{
+	if (nanoseconds <= 1)
+		return 0;
+
+	const int power{63 - qCountLeadingZeroBits(static_cast<quint64>(nanoseconds))};
+	const int upperHalf{static_cast<int>((nanoseconds >> (power - 1)) & 1)};
+
+	return qMin(BucketCount - 1, 2 * power + upperHalf);
+}
+
+qint64 bucketUpperBound(int bucket)
+{
+	const int next{bucket + 1};
+	const int power{next / 2};
+
+	if (power == 0)
+		return 1;
+
+	return (Q_INT64_C(1) << power) + (next % 2) * (Q_INT64_C(1) << (power - 1));
+}
+
+void fillPercentiles(Metrics::TimingSummary& summary, const qint64* buckets)
+{
+	if (summary.count == 0)
+		return;
+
+	const qint64 p50Rank{static_cast<qint64>(std::ceil(summary.count * 0.50))};
+	const qint64 p99Rank{static_cast<qint64>(std::ceil(summary.count * 0.99))};
+	qint64 seen{0};
+
+	for (int i{0}; i < BucketCount; ++i) {
+		seen += buckets[i];
+
+		if (summary.p50 == 0 && seen >= p50Rank)
+			summary.p50 = bucketUpperBound(i);
+
+		if (seen >= p99Rank) {
+			summary.p99 = bucketUpperBound(i);
+			break;
+		}
+	}
+}
+}
+
+void Metrics::increment(Counter counter, qint64 value)
+{
+	add(threadMetrics()->counters[counter], value);
+}
+
+void Metrics::record(Timing timing, qint64 nanoseconds)
+{
+	ThreadMetrics* metrics{threadMetrics()};
+
+	add(metrics->timingCounts[timing], 1);
+	add(metrics->timingTotals[timing], nanoseconds);
+	add(metrics->timingBuckets[timing][bucket(nanoseconds)], 1);
+}
+
+void Metrics::recordStartupPhase(const QString& name, qint64 milliseconds)
+{
+	QMutexLocker locker{&registry()->mutex};
+	registry()->startupPhases.append(qMakePair(name, milliseconds));
+}
+
+qint64 Metrics::counter(Counter counter)
+{
+	QMutexLocker locker{&registry()->mutex};
+	qint64 value{0};
+
+	foreach (ThreadMetrics* metrics, registry()->threads)
+		value += metrics->counters[counter].load(std::memory_order_relaxed);
+
+	return value;
+}
+
+Metrics::TimingSummary Metrics::timing(Timing timing)
+{
+	QMutexLocker locker{&registry()->mutex};
+	TimingSummary summary{};
+	qint64 buckets[BucketCount]{};
+
+	foreach (ThreadMetrics* metrics, registry()->threads) {
+		summary.count += metrics->timingCounts[timing].load(std::memory_order_relaxed);
+		summary.total += metrics->timingTotals[timing].load(std::memory_order_relaxed);
+
+		for (int i{0}; i < BucketCount; ++i)
+			buckets[i] += metrics->timingBuckets[timing][i].load(std::memory_order_relaxed);
+	}
+
+	fillPercentiles(summary, buckets);
+
+	return summary;
+}
+
+QVector<QPair<QString, qint64>> Metrics::startupPhases()
+{
+	QMutexLocker locker{&registry()->mutex};
+
+	return registry()->startupPhases;
+}
+
+QString Metrics::counterName(Counter counter)
+{
+	switch (counter) {
+	case AdBlockRequests:
+		return QStringLiteral("AdBlock requests inspected");
+	case AdBlockBlocked:
+		return QStringLiteral("AdBlock requests blocked");
+	case FaviconCacheHits:
+		return QStringLiteral("Favicon cache hits");
+	case FaviconCacheMisses:
+		return QStringLiteral("Favicon cache misses");
+	case SpeculativePredictions:
+		return QStringLiteral("Speculative navigations prepared");
+	case SpeculativePrerenders:
+		return QStringLiteral("Speculative navigations prerendered");
+	case SpeculativeHits:
+		return QStringLiteral("Speculative navigations used");
+	case SpeculativeWasted:
+		return QStringLiteral("Speculative navigations wasted");
+	default:
+		break;
+	}
+
+	return QString();
+}
+
+QString Metrics::timingName(Timing timing)
+{
+	switch (timing) {
+	case AdBlockMatch:
+		return QStringLiteral("AdBlock rule matching");
+	case SqlStatement:
+		return QStringLiteral("SQLite statements");
+	case SessionSave:
+		return QStringLiteral("Session save");
+	case ThemeLoad:
+		return QStringLiteral("Theme stylesheet load");
+	case LinkClickNavigation:
+		return QStringLiteral("Link click to navigation request");
+	default:
+		break;
+	}
+
+	return QString();
+}
+
+void TimingHistogram::record(qint64 nanoseconds)
+{
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+	m_buckets[bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+Metrics::TimingSummary TimingHistogram::summary() const
+{
+	Metrics::TimingSummary summary{};
+	qint64 buckets[BucketCount]{};
+
+	summary.count = m_count.load(std::memory_order_relaxed);
+	summary.total = m_total.load(std::memory_order_relaxed);
+
+	for (int i{0}; i < BucketCount; ++i)
+		buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+
+	fillPercentiles(summary, buckets);
+
+	return summary;
+}
+}
@@ -0,0 +1,127 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_METRICS_HPP
+#define SIELOBROWSER_METRICS_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QString>
+#include <QVector>
+#include <QPair>
+
+#include <QElapsedTimer>
+
+#include <atomic>
+
+namespace Sn
+{
+/*
+ * Runtime counters and timings shown on sielo:performance. Each thread writes to its own block of counters without
+ * locking, so recording from the network IO thread costs a couple of relaxed atomic operations. Reading sums the
+ * blocks of every thread that ever recorded something.
+ */
+class SIELO_SHAREDLIB Metrics {
+public:
+	enum Counter {
+		AdBlockRequests,
+		AdBlockBlocked,
+		FaviconCacheHits,
+		FaviconCacheMisses,
+		SpeculativePredictions,
+		SpeculativePrerenders,
+		SpeculativeHits,
+		SpeculativeWasted,
+		CounterCount
+	};
+
+	enum Timing {
+		AdBlockMatch,
+		SqlStatement,
+		SessionSave,
+		ThemeLoad,
+		LinkClickNavigation,
+		TimingCount
+	};
+
+	// Two buckets per power of two, from 1 ns to about 18 minutes
+	enum {
+		HistogramBucketCount = 80
+	};
+
+	// Durations are in nanoseconds, percentiles are approximated by a logarithmic histogram
+	struct TimingSummary {
+		qint64 count{0};
+		qint64 total{0};
+		qint64 p50{0};
+		qint64 p99{0};
+	};
+
+	static void increment(Counter counter, qint64 value = 1);
+	static void record(Timing timing, qint64 nanoseconds);
+	static void recordStartupPhase(const QString& name, qint64 milliseconds);
+
+	static qint64 counter(Counter counter);
+	static TimingSummary timing(Timing timing);
+	static QVector<QPair<QString, qint64>> startupPhases();
+
+	static QString counterName(Counter counter);
+	static QString timingName(Timing timing);
+};
+
+// Timing histogram for durations not known at build time, like the time spent in each url interceptor. It can be
+// recorded from any thread
+class SIELO_SHAREDLIB TimingHistogram {
+public:
+	void record(qint64 nanoseconds);
+	Metrics::TimingSummary summary() const;
+
+private:
+	std::atomic<qint64> m_count{0};
+	std::atomic<qint64> m_total{0};
+	std::atomic<qint64> m_buckets[Metrics::HistogramBucketCount]{};
+};
+
+// Records the time spent in its scope
+class SIELO_SHAREDLIB ScopedTiming {
+public:
+	explicit ScopedTiming(Metrics::Timing timing) :
+		m_timing(timing)
+	{
+		m_timer.start();
+	}
+
+	~ScopedTiming()
+	{
+		Metrics::record(m_timing, m_timer.nsecsElapsed());
+	}
+
+private:
+	Metrics::Timing m_timing{};
+	QElapsedTimer m_timer{};
+};
+}
+
+#endif //SIELOBROWSER_METRICS_HPP
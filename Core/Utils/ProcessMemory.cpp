@@ -0,0 +1,142 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "ProcessMemory.hpp"
+
+#include <QCoreApplication>
+
+#include <QDir>
+#include <QFile>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace Sn
+{
+bool ProcessMemory::isAvailable()
+{
+#ifdef Q_OS_LINUX
+	return QFile::exists(QLatin1String("/proc/self/stat"));
+#else
+	return false;
+#endif
+}
+
+QVector<ProcessMemory::ProcessInfo> ProcessMemory::browserProcesses()
+{
+	QVector<ProcessInfo> processes{};
+
+	if (!isAvailable())
+		return processes;
+
+	// Parent links of every process, to find the descendants of Sielo (web engine and renderer processes)
+	QHash<qint64, QVector<ProcessInfo>> children{};
+	const QStringList entries{QDir(QLatin1String("/proc")).entryList(QDir::Dirs | QDir::NoDotAndDotDot)};
+
+	foreach (const QString& entry, entries) {
+		bool isPid{false};
+		const qint64 pid{entry.toLongLong(&isPid)};
+		ProcessInfo info{};
+
+		if (isPid && readProcessInfo(pid, info))
+			children[info.parentPid].append(info);
+	}
+
+	ProcessInfo self{};
+
+	if (!readProcessInfo(QCoreApplication::applicationPid(), self))
+		return processes;
+
+	processes.append(self);
+
+	for (int i{0}; i < processes.size(); ++i)
+		processes += children.value(processes[i].pid);
+
+	return processes;
+}
+
+qint64 ProcessMemory::totalResidentBytes()
+{
+	qint64 total{0};
+
+	foreach (const ProcessInfo& info, browserProcesses())
+		total += info.residentBytes;
+
+	return total;
+}
+
+ProcessMemory::ProcessInfo ProcessMemory::processInfo(qint64 pid)
+{
+	ProcessInfo info{};
+	readProcessInfo(pid, info);
+
+	return info;
+}
+
+qint64 ProcessMemory::clockTicksPerSecond()
+{
+#ifdef Q_OS_LINUX
+	return sysconf(_SC_CLK_TCK);
+#else
+	return 100;
+#endif
+}
+
+bool ProcessMemory::readProcessInfo(qint64 pid, ProcessInfo& info)
+{
+#ifdef Q_OS_LINUX
+	QFile file{QString("/proc/%1/stat").arg(pid)};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	const QByteArray stat{file.readAll()};
+
+	// The process name is between parentheses and may contain spaces, fields are counted after it
+	const int nameEnd{stat.lastIndexOf(')')};
+
+	if (nameEnd < 0)
+		return false;
+
+	const QList<QByteArray> fields{stat.mid(nameEnd + 2).split(' ')};
+
+	// Fields 4 (ppid), 14 (utime), 15 (stime) and 24 (rss) of proc(5), the 3rd one being the first after the name
+	if (fields.size() < 22)
+		return false;
+
+	info.pid = pid;
+	info.parentPid = fields[1].toLongLong();
+	info.cpuTicks = fields[11].toLongLong() + fields[12].toLongLong();
+	info.residentBytes = fields[21].toLongLong() * sysconf(_SC_PAGESIZE);
+
+	return true;
+#else
+	Q_UNUSED(pid);
+	Q_UNUSED(info);
+
+	return false;
+#endif
+}
+}
@@ -0,0 +1,63 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_PROCESSMEMORY_HPP
+#define SIELOBROWSER_PROCESSMEMORY_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QHash>
+#include <QVector>
+
+namespace Sn
+{
+/*
+ * Memory and CPU usage of Sielo and of the web engine processes it spawned, read from /proc. On systems without
+ * /proc every value is 0, which callers must treat as "unknown".
+ */
+class SIELO_SHAREDLIB ProcessMemory {
+public:
+	struct ProcessInfo {
+		qint64 pid{0};
+		qint64 parentPid{0};
+		qint64 residentBytes{0};
+		qint64 cpuTicks{0}; // user + system time, in clock ticks
+	};
+
+	static bool isAvailable();
+
+	// The browser process and all of its descendants, the renderer processes among them
+	static QVector<ProcessInfo> browserProcesses();
+	static qint64 totalResidentBytes();
+
+	static ProcessInfo processInfo(qint64 pid);
+	static qint64 clockTicksPerSecond();
+
+private:
+	static bool readProcessInfo(qint64 pid, ProcessInfo& info);
+};
+}
+
+#endif //SIELOBROWSER_PROCESSMEMORY_HPP
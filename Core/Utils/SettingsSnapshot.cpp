@@ -0,0 +1,73 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/SettingsSnapshot.hpp"
+
+#include <atomic>
+
+#include "Utils/Settings.hpp"
+
+#include "Web/WebView.hpp"
+
+namespace Sn
+{
+namespace
+{
+// Replaced snapshots live as long as a reader holds them
+Q_GLOBAL_STATIC(std::shared_ptr<const SettingsSnapshot>, publishedSnapshot)
+}
+
+std::shared_ptr<const SettingsSnapshot> SettingsSnapshot::current()
+{
+	static const std::shared_ptr<const SettingsSnapshot> defaults{std::make_shared<SettingsSnapshot>()};
+
+	std::shared_ptr<const SettingsSnapshot> snapshot{std::atomic_load(publishedSnapshot())};
+
+	return snapshot ? snapshot : defaults;
+}
+
+void SettingsSnapshot::rebuild()
+{
+	auto snapshot = std::make_shared<SettingsSnapshot>();
+
+	Settings settings{};
+
+	settings.beginGroup("Web-Settings");
+
+	snapshot->defaultZoomLevel = settings.value("defaultZoomLevel", defaultZoom()).toInt();
+	snapshot->loadTabsOnActivation = settings.value("LoadTabsOnActivation", true).toBool();
+	snapshot->sendDoNotTrack = settings.value("DoNotTrack", false).toBool();
+	snapshot->automaticallyOpenProtocols = settings.value("AutomaticallyOpenProtocols", QStringList()).toStringList();
+	snapshot->blockedProtocols = settings.value("BlockedProtocols", QStringList()).toStringList();
+
+	settings.endGroup();
+
+	std::atomic_store(publishedSnapshot(), std::shared_ptr<const SettingsSnapshot>(std::move(snapshot)));
+}
+
+int SettingsSnapshot::defaultZoom()
+{
+	return WebView::zoomLevels().indexOf(100);
+}
+}
@@ -0,0 +1,61 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_SETTINGSSNAPSHOT_HPP
+#define SIELOBROWSER_SETTINGSSNAPSHOT_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QStringList>
+
+#include <memory>
+
+namespace Sn
+{
+/*
+ * Parsed copy of the settings read on hot paths. A snapshot is never modified once published, so it can be read from
+ * any thread, the request interceptor included, without locking and without going through QSettings. It is rebuilt on
+ * the GUI thread each time the preferences are saved, and freed once the last reader released it.
+ */
+struct SIELO_SHAREDLIB SettingsSnapshot {
+	// Web-Settings
+	int defaultZoomLevel{defaultZoom()};
+	bool loadTabsOnActivation{true};
+	bool sendDoNotTrack{false};
+	QStringList automaticallyOpenProtocols{};
+	QStringList blockedProtocols{};
+
+	// Returns the last published snapshot, or the default values if none has been published yet
+	static std::shared_ptr<const SettingsSnapshot> current();
+
+	// Reads the settings again and publishes a new snapshot. Must be called from the GUI thread
+	static void rebuild();
+
+private:
+	static int defaultZoom();
+};
+}
+
+#endif //SIELOBROWSER_SETTINGSSNAPSHOT_HPP
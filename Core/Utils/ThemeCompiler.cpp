@@ -0,0 +1,413 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/ThemeCompiler.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QCryptographicHash>
+
+#include "Utils/DataPaths.hpp"
+#include "Utils/Metrics.hpp"
+#include "Utils/Settings.hpp"
+#include "Utils/Trace.hpp"
+
+#include "Widgets/Preferences/Appearance.hpp"
+
+#include "Application.hpp"
+
+namespace Sn
+{
+namespace
+{
+// Must be increased when the output of compile() changes, so old cache entries are ignored
+const quint32 CompilerVersion = 1;
+const quint32 CacheMagic = 0x53535343; // "SSSC"
+
+const char* const ColorNames[] = {"main", "second", "accent", "text"};
+const char* const ColorShades[] = {"normal", "light", "dark"};
+
+bool startsWith(const QString& string, int position, QLatin1String token)
+{
+	return QStringRef(&string, position, qMin(token.size(), string.size() - position)) == token;
+}
+
+int skipSpaces(const QString& string, int position)
+{
+	while (position < string.size() && string[position].isSpace())
+		++position;
+
+	return position;
+}
+
+// Reads one of "words" at position, returns its index or -1
+int readWord(const QString& string, int& position, const char* const* words, int count)
+{
+	for (int i{0}; i < count; ++i) {
+		const QLatin1String word{words[i]};
+
+		if (startsWith(string, position, word)) {
+			position += word.size();
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Parses "scolor(name[, shade[, alpha]])" at position. The alpha is 1 to 3 digits with a value up to 255 and is
+ * copied as written. Returns false, leaving the text untouched, for anything else.
+ */
+bool readColor(const QString& sss, int& position, QString& color, QStringRef& alpha, QString& shade)
+{
+	int i{skipSpaces(sss, position + 6)};
+
+	if (i >= sss.size() || sss[i] != QLatin1Char('('))
+		return false;
+
+	i = skipSpaces(sss, i + 1);
+
+	const int name{readWord(sss, i, ColorNames, 4)};
+
+	if (name < 0)
+		return false;
+
+	color = QLatin1String(ColorNames[name]);
+	shade = QLatin1String("normal");
+	alpha = QStringRef();
+
+	i = skipSpaces(sss, i);
+
+	if (i < sss.size() && sss[i] == QLatin1Char(',')) {
+		i = skipSpaces(sss, i + 1);
+
+		const int shadeIndex{readWord(sss, i, ColorShades, 3)};
+
+		if (shadeIndex < 0)
+			return false;
+
+		shade = QLatin1String(ColorShades[shadeIndex]);
+		i = skipSpaces(sss, i);
+
+		if (i < sss.size() && sss[i] == QLatin1Char(',')) {
+			i = skipSpaces(sss, i + 1);
+
+			const int alphaStart{i};
+
+			while (i < sss.size() && i - alphaStart < 3 && sss[i].isDigit())
+				++i;
+
+			alpha = QStringRef(&sss, alphaStart, i - alphaStart);
+
+			if (alpha.isEmpty() || alpha.toInt() > 255)
+				return false;
+
+			i = skipSpaces(sss, i);
+		}
+	}
+
+	if (i >= sss.size() || sss[i] != QLatin1Char(')'))
+		return false;
+
+	position = i + 1;
+
+	return true;
+}
+
+// Parses "url(path)" at position, path can't contain '*', ':', ')' nor ';'. Returns the start of the path
+int readUrl(const QString& sss, int position)
+{
+	int i{skipSpaces(sss, position + 3)};
+
+	if (i >= sss.size() || sss[i] != QLatin1Char('('))
+		return -1;
+
+	i = skipSpaces(sss, i + 1);
+
+	const int pathStart{i};
+
+	while (i < sss.size() && sss[i] != QLatin1Char('*') && sss[i] != QLatin1Char(':') && sss[i] != QLatin1Char(')')
+		   && sss[i] != QLatin1Char(';'))
+		++i;
+
+	if (i == pathStart || i >= sss.size() || sss[i] != QLatin1Char(')'))
+		return -1;
+
+	return pathStart;
+}
+}
+
+ThemeCompiler::ThemeCompiler(const QString& themePath, const QString& lightness) :
+	m_themePath(themePath),
+	m_lightness(lightness),
+	m_colors(userColors())
+{
+	// Empty
+}
+
+QString ThemeCompiler::styleSheet()
+{
+	SN_TRACE_SCOPE("ThemeCompiler::styleSheet");
+	ScopedTiming timing{Metrics::ThemeLoad};
+
+	const QString cachePath{cacheFilePath(cacheKey())};
+	QString result{};
+
+	m_fromCache = readCache(cachePath, result);
+
+	if (m_fromCache)
+		return result;
+
+	QString sss{};
+
+	foreach (const QString& filePath, sourceFiles()) sss.append(Application::instance()->readFile(filePath));
+
+	Context context{};
+	context.relativePath = QDir::current().relativeFilePath(m_themePath);
+	context.lightness = m_lightness;
+	context.backgroundPath = Application::instance()->getBlurredBackgroundPath("images/background.png", 15);
+	context.colors = m_colors;
+
+	result = compile(sss, context);
+
+	writeCache(cachePath, result, context.backgroundPath);
+
+	return result;
+}
+
+QString ThemeCompiler::compile(const QString& sss, const Context& context)
+{
+	QString result{};
+	result.reserve(sss.size() + sss.size() / 4);
+
+	int position{0};
+
+	while (position < sss.size()) {
+		const QChar c{sss[position]};
+
+		// Every token starts with one of these, anything else is copied as is
+		if (c != QLatin1Char('u') && c != QLatin1Char('s') && c != QLatin1Char('$')) {
+			result.append(c);
+			++position;
+			continue;
+		}
+
+		if ((context.substitutions & Urls) && startsWith(sss, position, QLatin1String("url"))) {
+			const int pathStart{readUrl(sss, position)};
+
+			// The path itself goes through the other substitutions, like "$ulightness/icon.png"
+			if (pathStart >= 0) {
+				result.append(QLatin1String("url(") + context.relativePath + QLatin1Char('/'));
+				position = pathStart;
+				continue;
+			}
+		}
+
+		if (context.substitutions & Properties) {
+			if (startsWith(sss, position, QLatin1String("sproperty"))) {
+				result.append(QLatin1String("qproperty"));
+				position += 9;
+				continue;
+			}
+
+			if (startsWith(sss, position, QLatin1String("slineargradient"))) {
+				result.append(QLatin1String("qlineargradient"));
+				position += 15;
+				continue;
+			}
+		}
+
+		if ((context.substitutions & Background) && !context.backgroundPath.isEmpty()
+			&& startsWith(sss, position, QLatin1String("sbackground()"))) {
+			result.append(QLatin1String("url(") + context.backgroundPath + QLatin1Char(')'));
+			position += 13;
+			continue;
+		}
+
+		if (context.substitutions & Colors) {
+			if (startsWith(sss, position, QLatin1String("scolor"))) {
+				QString color{};
+				QString shade{};
+				QStringRef alpha{};
+				int end{position};
+
+				if (readColor(sss, end, color, alpha, shade)) {
+					result.append(QLatin1String("rgba(") + context.colors.value(color + shade) + QLatin1String(", "));
+
+					if (alpha.isEmpty())
+						result.append(QLatin1String("255"));
+					else
+						result.append(alpha);
+
+					result.append(QLatin1Char(')'));
+					position = end;
+					continue;
+				}
+			}
+
+			if (startsWith(sss, position, QLatin1String("$ulightness"))) {
+				result.append(context.lightness);
+				position += 11;
+				continue;
+			}
+
+			if (startsWith(sss, position, QLatin1String("$color"))) {
+				int end{position + 6};
+				const int name{readWord(sss, end, ColorNames, 4)};
+				const int shade{name < 0 ? -1 : readWord(sss, end, ColorShades, 3)};
+
+				if (shade >= 0) {
+					result.append(context.colors.value(QLatin1String(ColorNames[name])
+													   + QLatin1String(ColorShades[shade])));
+					position = end;
+					continue;
+				}
+			}
+		}
+
+		result.append(c);
+		++position;
+	}
+
+	return result;
+}
+
+QHash<QString, QString> ThemeCompiler::userColors()
+{
+	QHash<QString, QString> colors{};
+
+	for (const char* name : ColorNames) {
+		for (const char* shade : ColorShades) {
+			const QString id{QLatin1String(name) + QLatin1String(shade)};
+			colors.insert(id, AppearancePage::colorString(id));
+		}
+	}
+
+	return colors;
+}
+
+QStringList ThemeCompiler::sourceFiles() const
+{
+	QStringList files{m_themePath + QLatin1String("/main.sss")};
+
+#if defined(Q_OS_MAC)
+	files.append(m_themePath + QLatin1String("/mac.sss"));
+#elif defined(Q_OS_LINUX)
+	files.append(m_themePath + QLatin1String("/linux.sss"));
+#elif defined(Q_OS_WIN)
+	files.append(m_themePath + QLatin1String("/windows.sss"));
+#endif
+
+	return files;
+}
+
+QByteArray ThemeCompiler::cacheKey() const
+{
+	QCryptographicHash hash{QCryptographicHash::Sha1};
+
+	auto addFile = [&hash](const QString& filePath)
+	{
+		const QFileInfo info{filePath};
+
+		hash.addData(info.absoluteFilePath().toUtf8());
+		hash.addData(QByteArray::number(info.exists() ? info.size() : -1));
+		hash.addData(QByteArray::number(info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0));
+	};
+
+	hash.addData(QByteArray::number(CompilerVersion));
+	hash.addData(QDir::current().relativeFilePath(m_themePath).toUtf8());
+	hash.addData(m_lightness.toUtf8());
+
+	foreach (const QString& filePath, sourceFiles()) addFile(filePath);
+
+	// The blurred background only depends on the image, which is checked without reading it
+	Settings settings{};
+	addFile(settings.value(QLatin1String("Settings/backgroundPath"), QLatin1String("images/background.png")).toString());
+
+	for (const char* name : ColorNames) {
+		for (const char* shade : ColorShades)
+			hash.addData(m_colors.value(QLatin1String(name) + QLatin1String(shade)).toUtf8());
+	}
+
+	return hash.result().toHex();
+}
+
+QString ThemeCompiler::cacheFilePath(const QByteArray& key) const
+{
+	return QString("%1/themes/%2-%3.sssc").arg(DataPaths::path(DataPaths::Cache), QFileInfo(m_themePath).fileName(),
+											   QString::fromLatin1(key));
+}
+
+bool ThemeCompiler::readCache(const QString& filePath, QString& styleSheet) const
+{
+	QFile file{filePath};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream stream{&file};
+	quint32 magic{0};
+	quint32 version{0};
+	QString backgroundPath{};
+
+	stream >> magic >> version >> backgroundPath >> styleSheet;
+
+	if (stream.status() != QDataStream::Ok || magic != CacheMagic || version != CompilerVersion)
+		return false;
+
+	// The blurred background lives in another cache which may have been cleared
+	return backgroundPath.isEmpty() || QFileInfo::exists(backgroundPath);
+}
+
+void ThemeCompiler::writeCache(const QString& filePath, const QString& styleSheet, const QString& backgroundPath) const
+{
+	const QFileInfo info{filePath};
+	QDir directory{info.absolutePath()};
+
+	directory.mkpath(directory.absolutePath());
+
+	// Only the last compilation of each theme is kept
+	const QString themePrefix{QFileInfo(m_themePath).fileName() + QLatin1Char('-')};
+
+	foreach (const QString& fileName, directory.entryList(QStringList(themePrefix + "*.sssc"), QDir::Files)) {
+		if (fileName != info.fileName())
+			directory.remove(fileName);
+	}
+
+	QSaveFile file{filePath};
+
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	QDataStream stream{&file};
+	stream << CacheMagic << CompilerVersion << backgroundPath << styleSheet;
+
+	file.commit();
+}
+}
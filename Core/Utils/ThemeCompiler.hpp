@@ -0,0 +1,88 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_THEMECOMPILER_HPP
+#define SIELOBROWSER_THEMECOMPILER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+namespace Sn
+{
+/*
+ * Turns the SSS files of a theme into the Qt stylesheet given to the application. Sielo specific syntax (relative
+ * urls, sproperty, sbackground(), scolor() and the $color or $ulightness variables) is replaced in a single pass
+ * over the source.
+ *
+ * Compiled stylesheets are cached on disk, keyed by the theme files, the lightness, the user colors and the
+ * background, so a warm start doesn't parse the theme nor blur the background again.
+ */
+class SIELO_SHAREDLIB ThemeCompiler {
+public:
+	enum Substitution {
+		Urls = 0x1,
+		Properties = 0x2,
+		Background = 0x4,
+		Colors = 0x8,
+		AllSubstitutions = Urls | Properties | Background | Colors
+	};
+
+	struct Context {
+		QString relativePath{};
+		QString lightness{};
+		QString backgroundPath{}; // Blurred background, sbackground() is kept as is when empty
+		QHash<QString, QString> colors{}; // "mainnormal" -> "30, 30, 30"
+		int substitutions{AllSubstitutions};
+	};
+
+	ThemeCompiler(const QString& themePath, const QString& lightness);
+
+	QString styleSheet();
+	bool isFromCache() const { return m_fromCache; }
+
+	static QString compile(const QString& sss, const Context& context);
+
+	// The 12 colors of the appearance settings, as "r, g, b" strings
+	static QHash<QString, QString> userColors();
+
+private:
+	QStringList sourceFiles() const;
+	QByteArray cacheKey() const;
+	QString cacheFilePath(const QByteArray& key) const;
+
+	bool readCache(const QString& filePath, QString& styleSheet) const;
+	void writeCache(const QString& filePath, const QString& styleSheet, const QString& backgroundPath) const;
+
+	QString m_themePath{};
+	QString m_lightness{};
+	QHash<QString, QString> m_colors{};
+	bool m_fromCache{false};
+};
+}
+
+#endif //SIELOBROWSER_THEMECOMPILER_HPP
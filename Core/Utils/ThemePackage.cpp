@@ -0,0 +1,474 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/ThemePackage.hpp"
+
+#include <QObject>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QSaveFile>
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+
+namespace Sn
+{
+namespace
+{
+const quint32 PackageMagic = 0x534E5448; // "SNTH"
+const quint16 PackageVersion = 2;
+
+// Fixed so packages don't depend on the Qt version they were written with
+const QDataStream::Version StreamVersion = QDataStream::Qt_5_11;
+
+// magic, version, flags, entry count, data offset, index checksum
+const qint64 HeaderSize = 4 + 2 + 2 + 4 + 8 + 4;
+
+struct CompressedFile {
+	ThemePackage::Entry entry{};
+	QByteArray data{};
+	QString error{};
+};
+
+CompressedFile compressFile(const QString& sourceFolder, const QString& path)
+{
+	CompressedFile result{};
+	QFile file{sourceFolder + QLatin1Char('/') + path};
+
+	if (!file.open(QIODevice::ReadOnly)) {
+		result.error = QObject::tr("Failed to read %1").arg(path);
+		return result;
+	}
+
+	const QByteArray content{file.readAll()};
+	const QByteArray compressed{qCompress(content, 9)};
+
+	result.entry.path = path;
+	result.entry.size = static_cast<quint64>(content.size());
+	result.entry.checksum = ThemePackage::crc32(content.constData(), content.size());
+
+	// Images are usually compressed already
+	if (compressed.size() < content.size()) {
+		result.entry.method = ThemePackage::Deflate;
+		result.data = compressed;
+	}
+	else {
+		result.entry.method = ThemePackage::Stored;
+		result.data = content;
+	}
+
+	result.entry.compressedSize = static_cast<quint64>(result.data.size());
+
+	return result;
+}
+
+struct FileCompressor {
+	typedef CompressedFile result_type;
+
+	QString sourceFolder{};
+
+	CompressedFile operator()(const QString& path) const
+	{
+		return compressFile(sourceFolder, path);
+	}
+};
+}
+
+ThemePackage::ThemePackage(const QString& filePath) :
+	m_file(filePath)
+{
+	// Empty
+}
+
+ThemePackage::~ThemePackage()
+{
+	close();
+}
+
+bool ThemePackage::open()
+{
+	close();
+
+	if (!m_file.open(QIODevice::ReadOnly)) {
+		m_errorString = QObject::tr("Failed to read compiled file.");
+		return false;
+	}
+
+	const qint64 fileSize{m_file.size()};
+
+	QDataStream header{&m_file};
+	header.setVersion(StreamVersion);
+
+	quint32 magic{0};
+	header >> magic;
+
+	if (magic != PackageMagic)
+		return openLegacy();
+
+	quint16 version{0};
+	quint16 flags{0};
+	quint32 count{0};
+	quint64 dataOffset{0};
+	quint32 indexChecksum{0};
+
+	header >> version >> flags >> count >> dataOffset >> indexChecksum;
+
+	if (header.status() != QDataStream::Ok || version != PackageVersion || dataOffset < HeaderSize
+		|| dataOffset > static_cast<quint64>(fileSize)) {
+		m_errorString = QObject::tr("Unsupported or corrupted theme package.");
+		close();
+		return false;
+	}
+
+	m_data = m_file.map(0, fileSize);
+
+	if (!m_data) {
+		m_errorString = QObject::tr("Failed to map the theme package.");
+		close();
+		return false;
+	}
+
+	const QByteArray index{
+		QByteArray::fromRawData(reinterpret_cast<const char*>(m_data) + HeaderSize,
+								static_cast<int>(dataOffset - HeaderSize))
+	};
+
+	if (crc32(index.constData(), index.size()) != indexChecksum) {
+		m_errorString = QObject::tr("The theme package index is corrupted.");
+		close();
+		return false;
+	}
+
+	QDataStream stream{index};
+	stream.setVersion(StreamVersion);
+
+	const quint64 dataSize{static_cast<quint64>(fileSize) - dataOffset};
+
+	for (quint32 i{0}; i < count; ++i) {
+		Entry entry{};
+		QByteArray path{};
+		quint8 method{0};
+
+		stream >> path >> method >> entry.offset >> entry.compressedSize >> entry.size >> entry.checksum;
+
+		entry.path = QString::fromUtf8(path);
+		entry.method = static_cast<Method>(method);
+
+		if (stream.status() != QDataStream::Ok || method > Deflate || entry.offset > dataSize
+			|| entry.compressedSize > dataSize - entry.offset || !isSafePath(entry.path)) {
+			m_errorString = QObject::tr("The theme package index is corrupted.");
+			close();
+			return false;
+		}
+
+		m_entries.append(entry);
+	}
+
+	m_dataOffset = static_cast<qint64>(dataOffset);
+	m_version = PackageVersion;
+
+	return true;
+}
+
+void ThemePackage::close()
+{
+	if (m_data)
+		m_file.unmap(const_cast<uchar*>(m_data));
+
+	m_file.close();
+
+	m_data = nullptr;
+	m_dataOffset = 0;
+	m_version = 0;
+	m_entries.clear();
+	m_legacyData.clear();
+}
+
+bool ThemePackage::contains(const QString& path) const
+{
+	return indexOf(path) >= 0;
+}
+
+QByteArray ThemePackage::read(const QString& path)
+{
+	const int i{indexOf(path)};
+
+	if (i < 0) {
+		m_errorString = QObject::tr("%1 isn't in the theme package.").arg(path);
+		return QByteArray();
+	}
+
+	if (m_version == 1) {
+		const QByteArray content{qUncompress(m_legacyData.value(path))};
+
+		// Version 1 has no checksum, only the size stored by qCompress can be checked
+		if (static_cast<quint64>(content.size()) != m_entries[i].size) {
+			m_errorString = QObject::tr("%1 is corrupted in the theme package.").arg(path);
+			return QByteArray();
+		}
+
+		return content;
+	}
+
+	const Entry& entry{m_entries[i]};
+	const QByteArray raw{
+		QByteArray::fromRawData(reinterpret_cast<const char*>(m_data) + m_dataOffset + entry.offset,
+								static_cast<int>(entry.compressedSize))
+	};
+
+	// A deep copy for stored entries, the mapping goes away with the package
+	const QByteArray content{entry.method == Deflate ? qUncompress(raw) : QByteArray(raw.constData(), raw.size())};
+
+	if (static_cast<quint64>(content.size()) != entry.size
+		|| crc32(content.constData(), content.size()) != entry.checksum) {
+		m_errorString = QObject::tr("%1 is corrupted in the theme package.").arg(path);
+		return QByteArray();
+	}
+
+	return content;
+}
+
+bool ThemePackage::extract(const QString& destination)
+{
+	QDir dir{};
+
+	if (!dir.mkpath(destination)) {
+		m_errorString = QObject::tr("Can't create folder to receive decompiled files");
+		return false;
+	}
+
+	const QString root{QDir::cleanPath(QDir(destination).absolutePath()) + QLatin1Char('/')};
+
+	foreach (const Entry& entry, m_entries) {
+		const QString filePath{QDir::cleanPath(root + entry.path)};
+
+		// open() already rejected these paths, this is the last line of defense
+		if (!filePath.startsWith(root)) {
+			m_errorString = QObject::tr("%1 is outside of the theme folder.").arg(entry.path);
+			return false;
+		}
+
+		const QByteArray content{read(entry.path)};
+
+		if (content.isEmpty() && entry.size > 0)
+			return false;
+
+		dir.mkpath(QFileInfo(filePath).absolutePath());
+
+		QFile file{filePath};
+
+		if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+			m_errorString = QObject::tr("Failed to write decompiled files.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ThemePackage::write(const QString& sourceFolder, const QString& filePath, QString* errorString)
+{
+	QStringList paths{};
+	const QDir source{sourceFolder};
+	QDirIterator iterator{sourceFolder, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories};
+
+	while (iterator.hasNext())
+		paths.append(source.relativeFilePath(iterator.next()));
+
+	// Sorted by their UTF-8 bytes, the order readers binary search in
+	std::sort(paths.begin(), paths.end(), [](const QString& first, const QString& second)
+	{
+		return first.toUtf8() < second.toUtf8();
+	});
+
+	// Entries are compressed in parallel, but stay in the order of their paths
+	FileCompressor compressor{};
+	compressor.sourceFolder = sourceFolder;
+
+	const QVector<CompressedFile> files{
+		QtConcurrent::blockingMapped<QVector<CompressedFile>>(paths.toVector(), compressor)
+	};
+
+	QByteArray index{};
+	QDataStream indexStream{&index, QIODevice::WriteOnly};
+	indexStream.setVersion(StreamVersion);
+
+	quint64 offset{0};
+
+	foreach (const CompressedFile& file, files) {
+		if (!file.error.isEmpty()) {
+			if (errorString)
+				*errorString = file.error;
+
+			return false;
+		}
+
+		indexStream << file.entry.path.toUtf8() << static_cast<quint8>(file.entry.method) << offset
+			<< file.entry.compressedSize << file.entry.size << file.entry.checksum;
+
+		offset += file.entry.compressedSize;
+	}
+
+	QSaveFile output{filePath};
+
+	if (!output.open(QIODevice::WriteOnly)) {
+		if (errorString)
+			*errorString = QObject::tr("The destination file can't be open.");
+
+		return false;
+	}
+
+	QDataStream header{&output};
+	header.setVersion(StreamVersion);
+
+	header << PackageMagic << PackageVersion << static_cast<quint16>(0) << static_cast<quint32>(files.count())
+		<< static_cast<quint64>(HeaderSize + index.size()) << crc32(index.constData(), index.size());
+
+	output.write(index);
+
+	foreach (const CompressedFile& file, files) output.write(file.data);
+
+	if (!output.commit()) {
+		if (errorString)
+			*errorString = QObject::tr("The destination file can't be written.");
+
+		return false;
+	}
+
+	return true;
+}
+
+quint32 ThemePackage::crc32(const char* data, qint64 size)
+{
+	static const QVector<quint32> table{[]()
+	{
+		QVector<quint32> values(256);
+
+		for (quint32 i{0}; i < 256; ++i) {
+			quint32 value{i};
+
+			for (int bit{0}; bit < 8; ++bit)
+				value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+
+			values[static_cast<int>(i)] = value;
+		}
+
+		return values;
+	}()};
+
+	quint32 crc{0xFFFFFFFF};
+
+	for (qint64 i{0}; i < size; ++i)
+		crc = table[static_cast<int>((crc ^ static_cast<quint8>(data[i])) & 0xFF)] ^ (crc >> 8);
+
+	return crc ^ 0xFFFFFFFF;
+}
+
+bool ThemePackage::openLegacy()
+{
+	m_file.seek(0);
+
+	QDataStream stream{&m_file};
+
+	while (!stream.atEnd()) {
+		QString path{};
+		QByteArray data{};
+
+		stream >> path >> data;
+
+		if (stream.status() != QDataStream::Ok) {
+			m_errorString = QObject::tr("Unsupported or corrupted theme package.");
+			close();
+			return false;
+		}
+
+		// Version 1 paths start with a separator
+		while (path.startsWith(QLatin1Char('/')) || path.startsWith(QLatin1Char('\\')))
+			path.remove(0, 1);
+
+		path.replace(QLatin1Char('\\'), QLatin1Char('/'));
+
+		if (!isSafePath(path)) {
+			m_errorString = QObject::tr("Unsupported or corrupted theme package.");
+			close();
+			return false;
+		}
+
+		Entry entry{};
+		entry.path = path;
+		entry.method = Deflate;
+		entry.compressedSize = static_cast<quint64>(data.size());
+
+		// Version 1 has no checksum, qCompress stores the uncompressed size first
+		if (data.size() >= 4)
+			entry.size = (static_cast<quint64>(static_cast<quint8>(data[0])) << 24)
+						 | (static_cast<quint64>(static_cast<quint8>(data[1])) << 16)
+						 | (static_cast<quint64>(static_cast<quint8>(data[2])) << 8)
+						 | static_cast<quint64>(static_cast<quint8>(data[3]));
+
+		m_entries.append(entry);
+		m_legacyData.insert(path, data);
+	}
+
+	std::sort(m_entries.begin(), m_entries.end(), [](const Entry& first, const Entry& second)
+	{
+		return first.path.toUtf8() < second.path.toUtf8();
+	});
+
+	m_version = 1;
+
+	return true;
+}
+
+bool ThemePackage::isSafePath(const QString& path)
+{
+	if (path.isEmpty() || path.contains(QLatin1Char('\\')) || path.contains(QLatin1Char(':'))
+		|| QDir::isAbsolutePath(path))
+		return false;
+
+	const QString cleanPath{QDir::cleanPath(path)};
+
+	return !cleanPath.startsWith(QLatin1Char('/')) && cleanPath != QLatin1String(".")
+		   && cleanPath != QLatin1String("..") && !cleanPath.startsWith(QLatin1String("../"));
+}
+
+int ThemePackage::indexOf(const QString& path) const
+{
+	const QByteArray key{path.toUtf8()};
+
+	auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), key, [](const Entry& entry, const QByteArray& value)
+	{
+		return entry.path.toUtf8() < value;
+	});
+
+	if (it == m_entries.cend() || it->path != path)
+		return -1;
+
+	return static_cast<int>(it - m_entries.cbegin());
+}
+}
@@ -0,0 +1,107 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_THEMEPACKAGE_HPP
+#define SIELOBROWSER_THEMEPACKAGE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QFile>
+
+/*
+ * .snthm theme packages. This file is also built into sielo-compiler, so it only depends on Qt.
+ *
+ * Version 2 layout, integers in QDataStream (big endian) order:
+ *  - header: magic "SNTH", version, flags, entry count, data offset, CRC-32 of the index
+ *  - index: entries sorted by path, each with its compression method, offset in the data section, compressed and
+ *    uncompressed sizes and the CRC-32 of the uncompressed content
+ *  - data: the entries, one after the other
+ *
+ * The package is memory mapped and entries are only inflated when read. Version 1 packages, a plain stream of
+ * (path, qCompress'ed content) pairs, can still be read.
+ */
+namespace Sn
+{
+class SIELO_SHAREDLIB ThemePackage {
+public:
+	enum Method {
+		Stored = 0,
+		Deflate = 1
+	};
+
+	struct Entry {
+		QString path{};
+		Method method{Stored};
+		quint64 offset{0};
+		quint64 compressedSize{0};
+		quint64 size{0};
+		quint32 checksum{0};
+	};
+
+	ThemePackage(const QString& filePath);
+	~ThemePackage();
+
+	bool open();
+	void close();
+
+	int version() const { return m_version; }
+	QString errorString() const { return m_errorString; }
+
+	QVector<Entry> entries() const { return m_entries; }
+	bool contains(const QString& path) const;
+
+	// Content of the entry at "path", empty and with errorString() set if the entry is corrupted
+	QByteArray read(const QString& path);
+	bool extract(const QString& destination);
+
+	// Writes a version 2 package of every file in "sourceFolder". The output only depends on the files content
+	static bool write(const QString& sourceFolder, const QString& filePath, QString* errorString = nullptr);
+
+	static quint32 crc32(const char* data, qint64 size);
+
+private:
+	bool openLegacy();
+	int indexOf(const QString& path) const;
+
+	// Relative paths staying inside the folder a package is extracted to
+	static bool isSafePath(const QString& path);
+
+	QFile m_file;
+	const uchar* m_data{nullptr};
+	qint64 m_dataOffset{0};
+
+	int m_version{0};
+	QString m_errorString{};
+
+	QVector<Entry> m_entries{};
+	QHash<QString, QByteArray> m_legacyData{};
+};
+}
+
+#endif //SIELOBROWSER_THEMEPACKAGE_HPP
@@ -0,0 +1,404 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/ThumbnailService.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QPointer>
+#include <QFutureWatcher>
+#include <QCryptographicHash>
+#include <QImageWriter>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+#include "Utils/AutoSaver.hpp"
+#include "Utils/DataPaths.hpp"
+#include "Utils/Settings.hpp"
+
+#include "Application.hpp"
+
+namespace Sn
+{
+static const int INDEX_VERSION = 1;
+
+// Decoded previews kept in memory
+static const int MaximumImagesInMemory = 64;
+
+ThumbnailService::ThumbnailService(QObject* parent) :
+	QObject(parent),
+	m_cachePath(DataPaths::path(DataPaths::Cache) + QLatin1String("/thumbnails")),
+	m_images(MaximumImagesInMemory),
+	m_saver(new AutoSaver(this)),
+	m_privateBrowsing(Application::instance()->privateBrowsing())
+{
+	// WebP previews are a lot smaller, but its image format plugin is not always installed
+	m_format = QImageWriter::supportedImageFormats().contains("webp") ? QByteArray("webp") : QByteArray("png");
+
+	loadSettings();
+
+	if (m_diskCacheEnabled) {
+		loadIndex();
+		removeOrphanFiles();
+	}
+	else if (!m_privateBrowsing) {
+		// History is disabled, previews a previous session left on disk go away too
+		clear();
+	}
+}
+
+ThumbnailService::~ThumbnailService()
+{
+	m_saver->saveIfNeccessary();
+}
+
+QSize ThumbnailService::thumbnailSize()
+{
+	return QSize(256, 160);
+}
+
+void ThumbnailService::loadSettings()
+{
+	Settings settings{};
+
+	m_maximumSize = settings.value(QLatin1String("Web-Settings/thumbnailCacheSize"), 64).toLongLong() * 1024 * 1024;
+
+	// Previews tell which pages were visited, they are only written to disk when the history is
+	const bool diskCacheEnabled{
+		!m_privateBrowsing && settings.value(QLatin1String("Web-Settings/allowHistory"), true).toBool()
+	};
+
+	if (m_diskCacheEnabled && !diskCacheEnabled)
+		clear();
+
+	m_diskCacheEnabled = diskCacheEnabled;
+
+	evict();
+}
+
+void ThumbnailService::store(const QUrl& url, const QImage& screenshot)
+{
+	if (url.isEmpty() || screenshot.isNull())
+		return;
+
+	const QString key{urlKey(url)};
+	const QString cachePath{m_diskCacheEnabled ? m_cachePath : QString()};
+	const QByteArray format{m_format};
+	QFutureWatcher<StoredThumbnail>* watcher{new QFutureWatcher<StoredThumbnail>(this)};
+
+	connect(watcher, &QFutureWatcher<StoredThumbnail>::finished, this, [this, watcher, key]()
+	{
+		watcher->deleteLater();
+		thumbnailCreated(key, watcher->result());
+	});
+
+	watcher->setFuture(QtConcurrent::run(&ThumbnailService::createThumbnail, screenshot, cachePath, format));
+}
+
+void ThumbnailService::thumbnail(const QUrl& url, QObject* context, const Callback& callback)
+{
+	const QString key{urlKey(url)};
+	const auto entry = m_entries.find(key);
+
+	if (QImage* image = m_images.object(key)) {
+		if (entry != m_entries.end())
+			entry->lastUsed = QDateTime::currentMSecsSinceEpoch();
+
+		callback(*image);
+		return;
+	}
+
+	if (entry == m_entries.end()) {
+		callback(QImage());
+		return;
+	}
+
+	entry->lastUsed = QDateTime::currentMSecsSinceEpoch();
+	m_saver->changeOccurred();
+
+	const QString filePath{m_cachePath + QLatin1Char('/') + entry->fileName};
+	const QPointer<QObject> guard{context};
+	QFutureWatcher<QImage>* watcher{new QFutureWatcher<QImage>(this)};
+
+	connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, guard, callback]()
+	{
+		watcher->deleteLater();
+
+		const QImage image{watcher->result()};
+
+		if (image.isNull())
+			removeEntry(key);
+		else
+			m_images.insert(key, new QImage(image));
+
+		if (guard)
+			callback(image);
+	});
+
+	watcher->setFuture(QtConcurrent::run([filePath]()
+	{
+		return QImage(filePath);
+	}));
+}
+
+bool ThumbnailService::contains(const QUrl& url) const
+{
+	const QString key{urlKey(url)};
+
+	return m_images.contains(key) || m_entries.contains(key);
+}
+
+void ThumbnailService::clear()
+{
+	// The disk cache of the profile is not the one of private windows
+	if (!m_privateBrowsing) {
+		const QDir directory{m_cachePath};
+
+		foreach (const QString& fileName, directory.entryList(QDir::Files))
+			QFile::remove(directory.filePath(fileName));
+	}
+
+	m_entries.clear();
+	m_fileReferences.clear();
+	m_fileSizes.clear();
+	m_images.clear();
+	m_totalSize = 0;
+
+	m_saver->changeOccurred();
+}
+
+void ThumbnailService::save()
+{
+	if (!m_diskCacheEnabled)
+		return;
+
+	QDir().mkpath(m_cachePath);
+
+	QSaveFile file{m_cachePath + QLatin1String("/index")};
+
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	QDataStream stream{&file};
+
+	stream << INDEX_VERSION;
+	stream << m_entries.count();
+
+	for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+		stream << it.key() << it->fileName << it->lastUsed;
+
+	file.commit();
+}
+
+QString ThumbnailService::urlKey(const QUrl& url)
+{
+	return url.toString(QUrl::RemoveFragment | QUrl::StripTrailingSlash);
+}
+
+ThumbnailService::StoredThumbnail ThumbnailService::createThumbnail(const QImage& screenshot, const QString& cachePath,
+																	const QByteArray& format)
+{
+	const QSize size{thumbnailSize()};
+
+	// Only the top of the page, with the shape of the preview, is kept
+	const int height{qMin(screenshot.height(), screenshot.width() * size.height() / size.width())};
+
+	// Smooth scaling averages every source pixel, which is what large downscales need to stay sharp
+	StoredThumbnail thumbnail{};
+	thumbnail.image = screenshot.copy(0, 0, screenshot.width(), height)
+		.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+		.convertToFormat(QImage::Format_RGB32);
+
+	if (cachePath.isEmpty())
+		return thumbnail;
+
+	QByteArray data{};
+	QBuffer buffer{&data};
+
+	if (!buffer.open(QIODevice::WriteOnly) || !thumbnail.image.save(&buffer, format.constData(), 80))
+		return thumbnail;
+
+	const QString hash{QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex())};
+	const QString fileName{hash + QLatin1Char('.') + QString::fromLatin1(format)};
+	const QString filePath{cachePath + QLatin1Char('/') + fileName};
+
+	// The same data has the same name, an existing file doesn't have to be written again
+	if (!QFileInfo::exists(filePath)) {
+		QDir().mkpath(cachePath);
+
+		QSaveFile file{filePath};
+
+		if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+			return thumbnail;
+	}
+
+	thumbnail.fileName = fileName;
+	thumbnail.size = data.size();
+
+	return thumbnail;
+}
+
+void ThumbnailService::thumbnailCreated(const QString& key, const StoredThumbnail& thumbnail)
+{
+	if (thumbnail.image.isNull())
+		return;
+
+	m_images.insert(key, new QImage(thumbnail.image));
+
+	if (thumbnail.fileName.isEmpty())
+		return;
+
+	// Written while the disk cache was being disabled
+	if (!m_diskCacheEnabled) {
+		if (!m_fileReferences.contains(thumbnail.fileName))
+			QFile::remove(m_cachePath + QLatin1Char('/') + thumbnail.fileName);
+
+		return;
+	}
+
+	const auto entry = m_entries.constFind(key);
+
+	if (entry != m_entries.constEnd() && entry->fileName == thumbnail.fileName) {
+		m_entries[key].lastUsed = QDateTime::currentMSecsSinceEpoch();
+		m_saver->changeOccurred();
+		return;
+	}
+
+	removeEntry(key);
+
+	Entry newEntry{};
+	newEntry.fileName = thumbnail.fileName;
+	newEntry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+
+	m_entries.insert(key, newEntry);
+
+	if (m_fileReferences[thumbnail.fileName]++ == 0) {
+		m_fileSizes.insert(thumbnail.fileName, thumbnail.size);
+		m_totalSize += thumbnail.size;
+	}
+
+	evict();
+
+	m_saver->changeOccurred();
+}
+
+void ThumbnailService::removeEntry(const QString& key)
+{
+	const auto entry = m_entries.find(key);
+
+	if (entry == m_entries.end())
+		return;
+
+	const QString fileName{entry->fileName};
+
+	m_entries.erase(entry);
+
+	if (--m_fileReferences[fileName] > 0)
+		return;
+
+	m_fileReferences.remove(fileName);
+	m_totalSize -= m_fileSizes.take(fileName);
+
+	QFile::remove(m_cachePath + QLatin1Char('/') + fileName);
+}
+
+void ThumbnailService::evict()
+{
+	if (m_maximumSize <= 0 || m_totalSize <= m_maximumSize)
+		return;
+
+	QVector<QPair<qint64, QString>> entries{};
+	entries.reserve(m_entries.count());
+
+	for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+		entries.append(qMakePair(it->lastUsed, it.key()));
+
+	std::sort(entries.begin(), entries.end());
+
+	for (int i{0}; i < entries.count() && m_totalSize > m_maximumSize; ++i) {
+		m_images.remove(entries[i].second);
+		removeEntry(entries[i].second);
+	}
+
+	m_saver->changeOccurred();
+}
+
+void ThumbnailService::loadIndex()
+{
+	QFile file{m_cachePath + QLatin1String("/index")};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	QDataStream stream{&file};
+
+	int version{0};
+	int count{0};
+
+	stream >> version;
+
+	if (version != INDEX_VERSION)
+		return;
+
+	stream >> count;
+
+	for (int i{0}; i < count && stream.status() == QDataStream::Ok; ++i) {
+		QString key{};
+		Entry entry{};
+
+		stream >> key >> entry.fileName >> entry.lastUsed;
+
+		const QFileInfo info{m_cachePath + QLatin1Char('/') + entry.fileName};
+
+		if (stream.status() != QDataStream::Ok || !info.exists())
+			continue;
+
+		m_entries.insert(key, entry);
+
+		if (m_fileReferences[entry.fileName]++ == 0) {
+			m_fileSizes.insert(entry.fileName, info.size());
+			m_totalSize += info.size();
+		}
+	}
+
+	evict();
+}
+
+void ThumbnailService::removeOrphanFiles()
+{
+	const QDir directory{m_cachePath};
+
+	foreach (const QString& fileName, directory.entryList(QDir::Files)) {
+		if (fileName != QLatin1String("index") && !m_fileReferences.contains(fileName))
+			QFile::remove(directory.filePath(fileName));
+	}
+}
+}
@@ -0,0 +1,114 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_THUMBNAILSERVICE_HPP
+#define SIELOBROWSER_THUMBNAILSERVICE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+#include <QImage>
+#include <QUrl>
+#include <QHash>
+#include <QCache>
+
+#include <functional>
+
+namespace Sn
+{
+class AutoSaver;
+
+/*
+ * Small previews of the pages shown in tabs, so tab overviews like the Maquette Grid manager don't have to load
+ * the pages again. Screenshots are cropped and downscaled on a worker thread, then written in a content addressed
+ * disk cache: files are named by the hash of their data and shared by every url with the same preview. Least
+ * recently used previews are evicted once the cache is bigger than its budget.
+ *
+ * Previews of private windows, or taken while the history is disabled, are only kept in memory.
+ */
+class SIELO_SHAREDLIB ThumbnailService: public QObject {
+Q_OBJECT
+
+public:
+	typedef std::function<void(const QImage&)> Callback;
+
+	ThumbnailService(QObject* parent = nullptr);
+	~ThumbnailService();
+
+	static QSize thumbnailSize();
+
+	void loadSettings();
+
+	void store(const QUrl& url, const QImage& screenshot);
+	// The callback gets a null image if there is no preview for url, it is not called if context is destroyed before
+	void thumbnail(const QUrl& url, QObject* context, const Callback& callback);
+
+	bool contains(const QUrl& url) const;
+	void clear();
+
+public slots:
+	void save();
+
+private:
+	struct Entry {
+		QString fileName{};
+		qint64 lastUsed{0};
+	};
+
+	struct StoredThumbnail {
+		QImage image{};
+		QString fileName{};
+		qint64 size{0};
+	};
+
+	static QString urlKey(const QUrl& url);
+	static StoredThumbnail createThumbnail(const QImage& screenshot, const QString& cachePath,
+										   const QByteArray& format);
+
+	void thumbnailCreated(const QString& key, const StoredThumbnail& thumbnail);
+	void removeEntry(const QString& key);
+	void evict();
+
+	void loadIndex();
+	void removeOrphanFiles();
+
+	QString m_cachePath{};
+	QByteArray m_format{};
+	qint64 m_maximumSize{0};
+	qint64 m_totalSize{0};
+
+	QHash<QString, Entry> m_entries{};
+	QHash<QString, int> m_fileReferences{};
+	QHash<QString, qint64> m_fileSizes{};
+	QCache<QString, QImage> m_images;
+
+	AutoSaver* m_saver{nullptr};
+	bool m_privateBrowsing{false};
+	bool m_diskCacheEnabled{false};
+};
+}
+
+#endif //SIELOBROWSER_THUMBNAILSERVICE_HPP
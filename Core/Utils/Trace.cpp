@@ -0,0 +1,209 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/Trace.hpp"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+#include "Utils/Metrics.hpp"
+
+namespace Sn
+{
+#ifdef SIELO_TRACING
+namespace
+{
+const int SpansPerThread = 8192;
+
+struct Span {
+	const char* name{nullptr};
+	qint64 start{0};
+	qint64 duration{0};
+};
+
+// Only the owning thread writes, the count is published after the span so readers never see a partial entry
+struct ThreadBuffer {
+	int threadId{0};
+	QString threadName{};
+	Span spans[SpansPerThread];
+	std::atomic<qint64> count{0};
+};
+
+struct TraceData {
+	QMutex mutex{};
+	QVector<ThreadBuffer*> buffers{};
+	QElapsedTimer clock{};
+
+	TraceData()
+	{
+		clock.start();
+	}
+};
+
+Q_GLOBAL_STATIC(TraceData, traceData)
+
+ThreadBuffer* threadBuffer()
+{
+	thread_local ThreadBuffer* buffer{nullptr};
+
+	if (!buffer) {
+		buffer = new ThreadBuffer();
+
+		QMutexLocker locker{&traceData()->mutex};
+
+		buffer->threadId = traceData()->buffers.count() + 1;
+		buffer->threadName = QThread::currentThread()->objectName();
+
+		if (buffer->threadName.isEmpty() && QCoreApplication::instance()
+			&& QThread::currentThread() == QCoreApplication::instance()->thread())
+			buffer->threadName = QStringLiteral("Main");
+		else if (buffer->threadName.isEmpty())
+			buffer->threadName = QStringLiteral("Thread %1").arg(buffer->threadId);
+
+		traceData()->buffers.append(buffer);
+	}
+
+	return buffer;
+}
+
+QByteArray jsonString(const QString& string)
+{
+	QString escaped{string};
+	escaped.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+	escaped.replace(QLatin1Char('"'), QLatin1String("\\\""));
+
+	return '"' + escaped.toUtf8() + '"';
+}
+}
+
+std::atomic<bool> Trace::s_enabled{false};
+
+void Trace::setEnabled(bool enabled)
+{
+	// Starts the clock before the first span
+	traceData();
+
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 Trace::now()
+{
+	return traceData()->clock.nsecsElapsed() / 1000;
+}
+
+void Trace::addSpan(const char* name, qint64 start, qint64 duration)
+{
+	ThreadBuffer* buffer{threadBuffer()};
+	const qint64 count{buffer->count.load(std::memory_order_relaxed)};
+
+	Span& span{buffer->spans[count % SpansPerThread]};
+	span.name = name;
+	span.start = start;
+	span.duration = duration;
+
+	buffer->count.store(count + 1, std::memory_order_release);
+}
+
+bool Trace::writeJson(const QString& filePath)
+{
+	QFile file{filePath};
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	const QByteArray pid{QByteArray::number(QCoreApplication::applicationPid())};
+	bool first{true};
+
+	auto writeEvent = [&file, &first](const QByteArray& event)
+	{
+		file.write(first ? "\n" : ",\n");
+		file.write(event);
+		first = false;
+	};
+
+	file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	QMutexLocker locker{&traceData()->mutex};
+
+	foreach (ThreadBuffer* buffer, traceData()->buffers) {
+		const QByteArray tid{QByteArray::number(buffer->threadId)};
+
+		writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid
+				   + ",\"args\":{\"name\":" + jsonString(buffer->threadName) + "}}");
+
+		// Only the last spans are kept when the ring buffer wrapped
+		const qint64 count{buffer->count.load(std::memory_order_acquire)};
+
+		for (qint64 i{qMax<qint64>(0, count - SpansPerThread)}; i < count; ++i) {
+			const Span& span{buffer->spans[i % SpansPerThread]};
+
+			writeEvent("{\"name\":" + jsonString(QString::fromUtf8(span.name)) + ",\"cat\":\"sielo\",\"ph\":\"X\""
+					   + ",\"ts\":" + QByteArray::number(span.start) + ",\"dur\":" + QByteArray::number(span.duration)
+					   + ",\"pid\":" + pid + ",\"tid\":" + tid + "}");
+		}
+	}
+
+	file.write("\n]}\n");
+
+	return true;
+}
+#endif
+
+PhaseTimer::~PhaseTimer()
+{
+	finish();
+}
+
+void PhaseTimer::begin(const char* name)
+{
+	finish();
+
+	m_name = name;
+	m_timer.start();
+
+#ifdef SIELO_TRACING
+	m_traceStart = Trace::now();
+#endif
+}
+
+void PhaseTimer::finish()
+{
+	if (!m_name)
+		return;
+
+	Metrics::recordStartupPhase(QString::fromUtf8(m_name), m_timer.elapsed());
+
+#ifdef SIELO_TRACING
+	if (Trace::isEnabled())
+		Trace::addSpan(m_name, m_traceStart, Trace::now() - m_traceStart);
+#endif
+
+	m_name = nullptr;
+}
+}
@@ -0,0 +1,120 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_TRACE_HPP
+#define SIELOBROWSER_TRACE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QString>
+#include <QElapsedTimer>
+
+#include <atomic>
+
+/*
+ * Scoped tracing, written as chrome://tracing JSON with --trace-startup. Spans are recorded in a ring buffer per
+ * thread, without locking. Only the address of names is stored, they must stay valid until the trace is written.
+ *
+ * Without SIELO_TRACING (the CMake option of the same name), the macros expand to nothing.
+ */
+#ifdef SIELO_TRACING
+#define SN_TRACE_CONCAT_IMPL(a, b) a##b
+#define SN_TRACE_CONCAT(a, b) SN_TRACE_CONCAT_IMPL(a, b)
+#define SN_TRACE_SCOPE(name) ::Sn::TraceSpan SN_TRACE_CONCAT(snTraceSpan, __LINE__){name}
+#else
+#define SN_TRACE_SCOPE(name)
+#endif
+
+namespace Sn
+{
+#ifdef SIELO_TRACING
+class SIELO_SHAREDLIB Trace {
+public:
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+	static void setEnabled(bool enabled);
+
+	// Microseconds since the first use of the trace clock
+	static qint64 now();
+
+	static void addSpan(const char* name, qint64 start, qint64 duration);
+	static bool writeJson(const QString& filePath);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+class SIELO_SHAREDLIB TraceSpan {
+public:
+	explicit TraceSpan(const char* name) :
+		m_name(Trace::isEnabled() ? name : nullptr),
+		m_start(m_name ? Trace::now() : 0)
+	{
+		// Empty
+	}
+
+	~TraceSpan()
+	{
+		end();
+	}
+
+	void end()
+	{
+		if (!m_name)
+			return;
+
+		Trace::addSpan(m_name, m_start, Trace::now() - m_start);
+		m_name = nullptr;
+	}
+
+private:
+	const char* m_name{nullptr};
+	qint64 m_start{0};
+};
+#endif
+
+/*
+ * Consecutive phases of a long sequence like the application startup. The duration of each phase is kept in the
+ * startup metrics and, with SIELO_TRACING, recorded as a span.
+ */
+class SIELO_SHAREDLIB PhaseTimer {
+public:
+	PhaseTimer() = default;
+	~PhaseTimer();
+
+	// Ends the current phase, if any, and starts a new one
+	void begin(const char* name);
+	void finish();
+
+private:
+	const char* m_name{nullptr};
+	QElapsedTimer m_timer{};
+
+#ifdef SIELO_TRACING
+	qint64 m_traceStart{0};
+#endif
+};
+}
+
+#endif //SIELOBROWSER_TRACE_HPP
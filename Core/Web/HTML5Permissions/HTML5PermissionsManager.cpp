@@ -26,19 +26,36 @@
 
 #include <QtDebug>
 
+#include <QSqlQuery>
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
 #include "Widgets/HTML5Permissions/HTML5PermissionsNotification.hpp"
 
+#include "Database/SqlDatabase.hpp"
+
 #include "Utils/Settings.hpp"
 
 #include "Web/WebPage.hpp"
 #include "Web/WebView.hpp"
 
+#include "Application.hpp"
 
 namespace Sn {
 
 HTML5PermissionsManager::HTML5PermissionsManager(QObject* parent) :
-	QObject(parent)
+	QObject(parent),
+	m_persistent(!Application::instance()->privateBrowsing())
 {
+	// Private browsing opens the database read only, decisions are only kept in memory
+	if (m_persistent) {
+		QSqlDatabase db{SqlDatabase::instance()->database()};
+
+		if (!db.tables().contains(QLatin1String("html5_permissions")))
+			db.exec("CREATE TABLE html5_permissions (origin TEXT PRIMARY KEY, granted INTEGER, denied INTEGER)");
+	}
+
 	loadSettings();
 }
 
@@ -48,18 +65,15 @@ void HTML5PermissionsManager::requestPermissions(WebPage* page, const QUrl& orig
 	if (!page)
 		return;
 
-	if (!m_granted.contains(feature) || !m_denied.contains(feature)) {
+	if (!featureBit(feature)) {
 		qWarning() << "HTML5PermissionsManager: Unknown feature " << feature;
 		return;
 	}
 
-	if (m_granted[feature].contains(origin.toString())) {
-		page->setFeaturePermission(origin, feature, Engine::WebPage::PermissionGrantedByUser);
-		return;
-	}
+	const Engine::WebPage::PermissionPolicy policy{permission(origin, feature)};
 
-	if (m_denied[feature].contains(origin.toString())) {
-		page->setFeaturePermission(origin, feature, Engine::WebPage::PermissionDeniedByUser);
+	if (policy != Engine::WebPage::PermissionUnknown) {
+		page->setFeaturePermission(origin, feature, policy);
 		return;
 	}
 
@@ -71,76 +85,225 @@ void HTML5PermissionsManager::requestPermissions(WebPage* page, const QUrl& orig
 void HTML5PermissionsManager::rememberPermissions(const QUrl& origin, const Engine::WebPage::Feature& feature,
 												  const Engine::WebPage::PermissionPolicy& policy)
 {
-	if (origin.isEmpty())
+	const QString key{normalizedOrigin(origin)};
+
+	if (key.isEmpty())
 		return;
 
+	Permissions permissions{};
+
+	{
+		QReadLocker locker{&m_lock};
+		permissions = m_permissions.value(key);
+	}
+
+	const quint32 bit{featureBit(feature)};
+
+	permissions.granted &= ~bit;
+	permissions.denied &= ~bit;
+
 	if (policy == Engine::WebPage::PermissionGrantedByUser)
-		m_granted[feature].append(origin.toString());
-	else
-		m_denied[feature].append(origin.toString());
+		permissions.granted |= bit;
+	else if (policy == Engine::WebPage::PermissionDeniedByUser)
+		permissions.denied |= bit;
+
+	setPermissions(key, permissions);
 
-	saveSettings();
+	if (m_persistent && !savePermissions(key, permissions))
+		qWarning() << "HTML5PermissionsManager: Can't save permissions of" << key;
+}
+
+void HTML5PermissionsManager::forgetPermissions(const QUrl& origin, const Engine::WebPage::Feature& feature)
+{
+	rememberPermissions(origin, feature, Engine::WebPage::PermissionUnknown);
+}
+
+Engine::WebPage::PermissionPolicy HTML5PermissionsManager::permission(const QUrl& origin,
+																	  const Engine::WebPage::Feature& feature) const
+{
+	const QString key{normalizedOrigin(origin)};
+	const quint32 bit{featureBit(feature)};
+
+	QReadLocker locker{&m_lock};
+
+	auto it = m_permissions.constFind(key);
+
+	if (it == m_permissions.constEnd())
+		return Engine::WebPage::PermissionUnknown;
+
+	if (it.value().granted & bit)
+		return Engine::WebPage::PermissionGrantedByUser;
+
+	if (it.value().denied & bit)
+		return Engine::WebPage::PermissionDeniedByUser;
+
+	return Engine::WebPage::PermissionUnknown;
+}
+
+QStringList HTML5PermissionsManager::origins(const Engine::WebPage::Feature& feature,
+											 const Engine::WebPage::PermissionPolicy& policy) const
+{
+	const quint32 bit{featureBit(feature)};
+	QStringList origins{};
+
+	QReadLocker locker{&m_lock};
+
+	for (auto it = m_permissions.constBegin(); it != m_permissions.constEnd(); ++it) {
+		const quint32 mask{policy == Engine::WebPage::PermissionGrantedByUser ? it.value().granted : it.value().denied};
+
+		if (mask & bit)
+			origins.append(it.key());
+	}
+
+	return origins;
 }
 
 void HTML5PermissionsManager::loadSettings()
 {
-	Settings settings{};
+	QHash<QString, Permissions> permissions{};
 
-	settings.beginGroup("HTML5-Permissions");
+	QSqlQuery query{SqlDatabase::instance()->database()};
+	query.exec("SELECT origin, granted, denied FROM html5_permissions");
 
-	m_granted[Engine::WebPage::Notifications] = settings.value("NotificationsGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::Notifications] = settings.value("NotificationsDenied", QStringList()).toStringList();
+	while (query.next()) {
+		Permissions entry{};
+		entry.granted = query.value(1).toUInt();
+		entry.denied = query.value(2).toUInt();
 
-	m_granted[Engine::WebPage::Geolocation] = settings.value("GeoLocationGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::Geolocation] = settings.value("GeoLocationDenied", QStringList()).toStringList();
+		permissions.insert(query.value(0).toString(), entry);
+	}
 
-	m_granted[Engine::WebPage::MediaAudioCapture] =
-		settings.value("MediaAudioCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaAudioCapture] =
-		settings.value("MediaAudioCaptureDenied", QStringList()).toStringList();
+	{
+		QWriteLocker locker{&m_lock};
+		m_permissions = permissions;
+	}
 
-	m_granted[Engine::WebPage::MediaVideoCapture] =
-		settings.value("MediaVideoCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaVideoCapture] =
-		settings.value("MediaVideoCaptureDenied", QStringList()).toStringList();
+	importLegacySettings();
+}
 
-	m_granted[Engine::WebPage::MediaAudioVideoCapture] =
-		settings.value("MediaAudioVideoCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaAudioVideoCapture] =
-		settings.value("MediaAudioVideoCaptureDenied", QStringList()).toStringList();
+QString HTML5PermissionsManager::normalizedOrigin(const QUrl& origin)
+{
+	if (origin.isEmpty())
+		return QString();
 
-	m_granted[Engine::WebPage::MouseLock] = settings.value("MouseLockGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MouseLock] = settings.value("MouseLockDenied", QStringList()).toStringList();
+	return origin.adjusted(QUrl::RemoveUserInfo | QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment)
+	             .toString().toLower();
+}
 
-	settings.endGroup();
+quint32 HTML5PermissionsManager::featureBit(const Engine::WebPage::Feature& feature)
+{
+	switch (feature) {
+	case Engine::WebPage::Notifications:
+	case Engine::WebPage::Geolocation:
+	case Engine::WebPage::MediaAudioCapture:
+	case Engine::WebPage::MediaVideoCapture:
+	case Engine::WebPage::MediaAudioVideoCapture:
+	case Engine::WebPage::MouseLock:
+		return 1u << static_cast<int>(feature);
+	default:
+		return 0;
+	}
+}
+
+void HTML5PermissionsManager::setPermissions(const QString& origin, const Permissions& permissions)
+{
+	QWriteLocker locker{&m_lock};
+
+	if (permissions.granted == 0 && permissions.denied == 0)
+		m_permissions.remove(origin);
+	else
+		m_permissions[origin] = permissions;
+}
+
+bool HTML5PermissionsManager::savePermissions(const QString& origin, const Permissions& permissions)
+{
+	QSqlQuery query{SqlDatabase::instance()->database()};
+
+	if (permissions.granted == 0 && permissions.denied == 0) {
+		query.prepare("DELETE FROM html5_permissions WHERE origin=?");
+		query.addBindValue(origin);
+	}
+	else {
+		query.prepare("INSERT OR REPLACE INTO html5_permissions (origin, granted, denied) VALUES (?, ?, ?)");
+		query.addBindValue(origin);
+		query.addBindValue(permissions.granted);
+		query.addBindValue(permissions.denied);
+	}
+
+	return SqlDatabase::exec(query);
 }
 
-void HTML5PermissionsManager::saveSettings()
+void HTML5PermissionsManager::importLegacySettings()
 {
+	// Permissions used to be stored as lists of origins in the settings, they are moved to the database once
 	Settings settings{};
 
 	settings.beginGroup("HTML5-Permissions");
 
-	settings.setValue("NotificationsGranted", m_granted[Engine::WebPage::Notifications]);
-	settings.setValue("NotificationsDenied", m_denied[Engine::WebPage::Notifications]);
+	const QList<QPair<QString, Engine::WebPage::Feature>> keys{
+		{QLatin1String("Notifications"), Engine::WebPage::Notifications},
+		{QLatin1String("GeoLocation"), Engine::WebPage::Geolocation},
+		{QLatin1String("MediaAudioCapture"), Engine::WebPage::MediaAudioCapture},
+		{QLatin1String("MediaVideoCapture"), Engine::WebPage::MediaVideoCapture},
+		{QLatin1String("MediaAudioVideoCapture"), Engine::WebPage::MediaAudioVideoCapture},
+		{QLatin1String("MouseLock"), Engine::WebPage::MouseLock}
+	};
+
+	QHash<QString, Permissions> permissions{};
+	bool found{settings.contains(QLatin1String("NotificationDenied"))};
+
+	for (const auto& key : keys) {
+		const quint32 bit{featureBit(key.second)};
+
+		found = found || settings.contains(key.first + QLatin1String("Granted"))
+			|| settings.contains(key.first + QLatin1String("Denied"));
 
-	settings.setValue("GeoLocationGranted", m_granted[Engine::WebPage::Geolocation]);
-	settings.setValue("GeoLocationDenied", m_denied[Engine::WebPage::Geolocation]);
+		foreach (const QString& origin, settings.value(key.first + QLatin1String("Granted")).toStringList())
+			permissions[normalizedOrigin(QUrl(origin))].granted |= bit;
 
-	settings.setValue("MediaAudioCaptureGranted", m_granted[Engine::WebPage::MediaAudioCapture]);
-	settings.setValue("MediaAudioCaptureDenied", m_denied[Engine::WebPage::MediaAudioCapture]);
+		// The permissions dialog used to save denied notifications under a misspelled key
+		QStringList denied{settings.value(key.first + QLatin1String("Denied")).toStringList()};
 
-	settings.setValue("MediaVideoCaptureGranted", m_granted[Engine::WebPage::MediaVideoCapture]);
-	settings.setValue("MediaVideoCaptureDenied", m_denied[Engine::WebPage::MediaVideoCapture]);
+		if (key.second == Engine::WebPage::Notifications)
+			denied += settings.value(QLatin1String("NotificationDenied")).toStringList();
 
-	settings.setValue("MediaAudioVideoCaptureGranted", m_granted[Engine::WebPage::MediaAudioVideoCapture]);
-	settings.setValue("MediaAudioVideoCaptureDenied", m_denied[Engine::WebPage::MediaAudioVideoCapture]);
+		foreach (const QString& origin, denied) {
+			Permissions& entry = permissions[normalizedOrigin(QUrl(origin))];
 
-	settings.setValue("MouseLockGranted", m_granted[Engine::WebPage::MouseLock]);
-	settings.setValue("MouseLockDenied", m_denied[Engine::WebPage::MouseLock]);
+			if (!(entry.granted & bit))
+				entry.denied |= bit;
+		}
+	}
 
 	settings.endGroup();
 
+	if (!found)
+		return;
+
+	for (auto it = permissions.constBegin(); it != permissions.constEnd(); ++it) {
+		if (!it.key().isEmpty())
+			setPermissions(it.key(), it.value());
+	}
+
+	// The lists stay in the settings until a session can write them to the database
+	if (!m_persistent)
+		return;
+
+	QSqlDatabase db{SqlDatabase::instance()->database()};
+	bool saved{db.transaction()};
+
+	for (auto it = permissions.constBegin(); saved && it != permissions.constEnd(); ++it) {
+		if (!it.key().isEmpty())
+			saved = savePermissions(it.key(), it.value());
+	}
+
+	if (!saved || !db.commit()) {
+		db.rollback();
+		qWarning() << "HTML5PermissionsManager: Can't import permissions from the settings";
+		return;
+	}
+
+	settings.remove("HTML5-Permissions");
 }
 
-}
\ No newline at end of file
+}
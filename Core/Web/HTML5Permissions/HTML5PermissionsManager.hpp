@@ -31,6 +31,7 @@
 #include <QObject>
 
 #include <QHash>
+#include <QReadWriteLock>
 
 #include <QStringList>
 #include <QUrl>
@@ -40,6 +41,11 @@
 namespace Sn {
 class WebPage;
 
+/*
+ * Permissions are stored per origin as two bitmasks of features, in memory and in the "html5_permissions" table of
+ * the profile database. Lookups only take a read lock, so they can be done from any thread, including the IO thread
+ * of the request interceptors.
+ */
 class SIELO_SHAREDLIB HTML5PermissionsManager: public QObject {
 public:
 	HTML5PermissionsManager(QObject* parent);
@@ -47,14 +53,32 @@ public:
 	void requestPermissions(WebPage* page, const QUrl& origin, const Engine::WebPage::Feature& feature);
 	void rememberPermissions(const QUrl& origin, const Engine::WebPage::Feature& feature,
 							 const Engine::WebPage::PermissionPolicy& policy);
+	void forgetPermissions(const QUrl& origin, const Engine::WebPage::Feature& feature);
+
+	// Thread safe
+	Engine::WebPage::PermissionPolicy permission(const QUrl& origin, const Engine::WebPage::Feature& feature) const;
+	QStringList origins(const Engine::WebPage::Feature& feature, const Engine::WebPage::PermissionPolicy& policy) const;
 
 	void loadSettings();
 
+	static QString normalizedOrigin(const QUrl& origin);
+
 private:
-	void saveSettings();
+	struct Permissions {
+		quint32 granted{0};
+		quint32 denied{0};
+	};
+
+	static quint32 featureBit(const Engine::WebPage::Feature& feature);
+
+	void setPermissions(const QString& origin, const Permissions& permissions);
+	bool savePermissions(const QString& origin, const Permissions& permissions);
+	void importLegacySettings();
+
+	QHash<QString, Permissions> m_permissions{};
+	mutable QReadWriteLock m_lock{};
 
-	QHash<Engine::WebPage::Feature, QStringList> m_granted;
-	QHash<Engine::WebPage::Feature, QStringList> m_denied;
+	bool m_persistent{true};
 };
 
 }
@@ -0,0 +1,180 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Web/InternalPages.hpp"
+
+#include <QUrlQuery>
+
+#include <QWebEngine/UrlSchemeHandler.hpp>
+
+#include "Application.hpp"
+
+#include "Network/NetworkManager.hpp"
+#include "Network/NetworkUrlInterceptor.hpp"
+
+#include "Utils/Metrics.hpp"
+
+#include "Web/WebPage.hpp"
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabbedWebView.hpp"
+#include "Web/Tab/TabLifecycleManager.hpp"
+
+namespace Sn
+{
+static QString formatDuration(qint64 nanoseconds)
+{
+	if (nanoseconds < 1000)
+		return QStringLiteral("%1 ns").arg(nanoseconds);
+	if (nanoseconds < 1000 * 1000)
+		return QStringLiteral("%1 us").arg(nanoseconds / 1000.0, 0, 'f', 1);
+
+	return QStringLiteral("%1 ms").arg(nanoseconds / (1000.0 * 1000.0), 0, 'f', 1);
+}
+
+static QString row(const QString& name, const QString& value)
+{
+	return QStringLiteral("<tr><td>%1</td><td>%2</td></tr>").arg(name.toHtmlEscaped(), value.toHtmlEscaped());
+}
+
+void InternalPages::addPages(Engine::UrlSchemeHandler* handler)
+{
+	handler->addPage(QStringLiteral("performance"), &InternalPages::performance);
+	handler->addPage(QStringLiteral("adblock"), &InternalPages::adBlock);
+}
+
+QByteArray InternalPages::performance(const QUrl& url)
+{
+	Q_UNUSED(url);
+
+	QString body{};
+
+	body += QStringLiteral("<h2>Counters</h2><table>");
+
+	for (int i{0}; i < Metrics::CounterCount; ++i) {
+		const Metrics::Counter counter{static_cast<Metrics::Counter>(i)};
+		body += row(Metrics::counterName(counter), QString::number(Metrics::counter(counter)));
+	}
+
+	const qint64 faviconHits{Metrics::counter(Metrics::FaviconCacheHits)};
+	const qint64 faviconLookups{faviconHits + Metrics::counter(Metrics::FaviconCacheMisses)};
+
+	if (faviconLookups > 0)
+		body += row(QStringLiteral("Favicon cache hit rate"),
+					QStringLiteral("%1 %").arg(100.0 * faviconHits / faviconLookups, 0, 'f', 1));
+
+	const qint64 speculativeHits{Metrics::counter(Metrics::SpeculativeHits)};
+	const qint64 speculativeDone{speculativeHits + Metrics::counter(Metrics::SpeculativeWasted)};
+
+	if (speculativeDone > 0)
+		body += row(QStringLiteral("Speculative navigation hit rate"),
+					QStringLiteral("%1 %").arg(100.0 * speculativeHits / speculativeDone, 0, 'f', 1));
+
+	body += QStringLiteral("</table><h2>Timings</h2><table>"
+						   "<tr><th></th><th>Count</th><th>Average</th><th>p50</th><th>p99</th></tr>");
+
+	for (int i{0}; i < Metrics::TimingCount; ++i) {
+		const Metrics::Timing timing{static_cast<Metrics::Timing>(i)};
+		const Metrics::TimingSummary summary{Metrics::timing(timing)};
+
+		body += QStringLiteral("<tr><td>%1</td><td>%2</td><td>%3</td><td>%4</td><td>%5</td></tr>")
+			.arg(Metrics::timingName(timing).toHtmlEscaped())
+			.arg(summary.count)
+			.arg(formatDuration(summary.count > 0 ? summary.total / summary.count : 0),
+				 formatDuration(summary.p50), formatDuration(summary.p99));
+	}
+
+	body += QStringLiteral("</table><h2>Url interceptors</h2><table>"
+						   "<tr><th></th><th>Priority</th><th>Count</th><th>Average</th><th>p50</th><th>p99</th></tr>");
+
+	foreach (const NetworkUrlInterceptor::InterceptorTiming& timing,
+			 Application::instance()->networkManager()->urlInterceptor()->timings()) {
+		const Metrics::TimingSummary& summary{timing.summary};
+
+		body += QStringLiteral("<tr><td>%1</td><td>%2</td><td>%3</td><td>%4</td><td>%5</td><td>%6</td></tr>")
+			.arg(timing.name.toHtmlEscaped())
+			.arg(timing.priority)
+			.arg(summary.count)
+			.arg(formatDuration(summary.count > 0 ? summary.total / summary.count : 0),
+				 formatDuration(summary.p50), formatDuration(summary.p99));
+	}
+
+	int loadedTabs{0};
+	int frozenTabs{0};
+	int unloadedTabs{0};
+	TabLifecycleManager* lifecycleManager{Application::instance()->tabLifecycleManager()};
+
+	foreach (WebTab* tab, lifecycleManager->tabs()) {
+		if (!tab->isRestored())
+			++unloadedTabs;
+		else if (tab->webView()->page()->isFrozen())
+			++frozenTabs;
+		else
+			++loadedTabs;
+	}
+
+	body += QStringLiteral("</table><h2>Tabs</h2><table>");
+	body += row(QStringLiteral("Loaded"), QString::number(loadedTabs));
+	body += row(QStringLiteral("Frozen"), QString::number(frozenTabs));
+	body += row(QStringLiteral("Unloaded"), QString::number(unloadedTabs));
+	body += row(QStringLiteral("Discarded under memory pressure"),
+				QString::number(lifecycleManager->totalDiscardCount()));
+	body += QStringLiteral("</table><h2>Startup</h2><table>");
+
+	typedef QPair<QString, qint64> Phase;
+
+	foreach (const Phase& phase, Metrics::startupPhases())
+		body += row(phase.first, QStringLiteral("%1 ms").arg(phase.second));
+
+	body += QStringLiteral("</table>");
+
+	return page(QStringLiteral("Performance"), body, 2);
+}
+
+QByteArray InternalPages::adBlock(const QUrl& url)
+{
+	const QUrlQuery query{url};
+	QString body{};
+
+	body += QStringLiteral("<h2>%1</h2>").arg(Application::tr("Blocked content").toHtmlEscaped());
+	body += QStringLiteral("<table>");
+	body += row(Application::tr("Rule"), query.queryItemValue(QStringLiteral("rule"), QUrl::FullyDecoded));
+	body += row(Application::tr("Subscription"),
+				query.queryItemValue(QStringLiteral("subscription"), QUrl::FullyDecoded));
+	body += QStringLiteral("</table>");
+
+	return page(Application::tr("AdBlock"), body);
+}
+
+QByteArray InternalPages::page(const QString& title, const QString& body, int refreshInterval)
+{
+	const QString refresh{refreshInterval > 0
+							  ? QStringLiteral("<meta http-equiv=\"refresh\" content=\"%1\">").arg(refreshInterval)
+							  : QString()};
+
+	return QStringLiteral("<!DOCTYPE html><html><head><meta charset=\"utf-8\">%1<title>%2</title>"
+						  "<style>body { font-family: sans-serif; margin: 2em; } td, th { padding: 2px 12px; "
+						  "text-align: left; }</style></head><body><h1>%2</h1>%3</body></html>")
+		.arg(refresh, title.toHtmlEscaped(), body).toUtf8();
+}
+}
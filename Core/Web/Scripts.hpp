@@ -140,6 +140,53 @@ public:
 		return source;
 	}
 
+	// Reports the link under the mouse and its viewport rectangle, so clicks don't need a hit test
+	static QString hoveredLinkReporter()
+	{
+		QString source = QLatin1String("(function() {"
+			"if (self !== top)"
+			"    return;"
+			""
+			"var current = null;"
+			"var scheduled = false;"
+			""
+			"function report() {"
+			"    scheduled = false;"
+			"    if (!window.external || !external.hoveredLink)"
+			"        return;"
+			"    if (!current || typeof current.href != 'string') {"
+			"        external.hoveredLink.update('', 0, 0, 0, 0);"
+			"        return;"
+			"    }"
+			"    var r = current.getBoundingClientRect();"
+			"    external.hoveredLink.update(current.href, r.left, r.top, r.width, r.height);"
+			"}"
+			""
+			"function scheduleReport() {"
+			"    if (scheduled)"
+			"        return;"
+			"    scheduled = true;"
+			"    window.requestAnimationFrame(report);"
+			"}"
+			""
+			"document.addEventListener('mouseover', function(e) {"
+			"    var link = e.target && e.target.closest ? e.target.closest('a[href], area[href]') : null;"
+			"    if (link === current)"
+			"        return;"
+			"    current = link;"
+			"    scheduleReport();"
+			"}, true);"
+			""
+			"window.addEventListener('scroll', function() {"
+			"    if (current)"
+			"        scheduleReport();"
+			"}, true);"
+			""
+			"})()");
+
+		return source;
+	}
+
 	static QString sendPostData(const QUrl& url, const QByteArray& data)
 	{
 		QString source{
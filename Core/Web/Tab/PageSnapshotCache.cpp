@@ -0,0 +1,147 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Web/Tab/PageSnapshotCache.hpp"
+
+#include <QPointer>
+#include <QFutureWatcher>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "Utils/Settings.hpp"
+
+#include "Web/Tab/WebTab.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+
+#include "BrowserWindow.hpp"
+
+namespace Sn
+{
+// Snapshots are only shown while the page loads, they don't need the full resolution
+static const int MaximumSnapshotWidth = 1024;
+
+PageSnapshotCache::PageSnapshotCache(QObject* parent) :
+	QObject(parent)
+{
+	loadSettings();
+}
+
+PageSnapshotCache::~PageSnapshotCache()
+{
+	// Empty
+}
+
+void PageSnapshotCache::loadSettings()
+{
+	Settings settings{};
+
+	m_cache.setMaxCost(settings.value(QLatin1String("Web-Settings/pageSnapshotCacheSize"), 32).toInt() * 1024);
+}
+
+void PageSnapshotCache::insert(WebTab* tab, const QUrl& url, const QImage& screenshot)
+{
+	if (m_cache.maxCost() <= 0 || screenshot.isNull())
+		return;
+
+	const Key snapshotKey{key(tab, url)};
+	const QPointer<WebTab> guard{tab};
+	QFutureWatcher<QImage>* watcher{new QFutureWatcher<QImage>(this)};
+
+	connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, guard, snapshotKey]()
+	{
+		watcher->deleteLater();
+
+		if (guard)
+			store(guard, snapshotKey, watcher->result());
+	});
+
+	watcher->setFuture(QtConcurrent::run(&PageSnapshotCache::scaled, screenshot));
+}
+
+QImage PageSnapshotCache::find(WebTab* tab, const QUrl& url)
+{
+	const QImage* snapshot{m_cache.object(key(tab, url))};
+
+	return snapshot ? *snapshot : QImage();
+}
+
+bool PageSnapshotCache::contains(WebTab* tab, const QUrl& url) const
+{
+	return m_cache.contains(key(tab, url));
+}
+
+void PageSnapshotCache::remove(WebTab* tab)
+{
+	removeSnapshots(reinterpret_cast<quintptr>(tab));
+}
+
+void PageSnapshotCache::clear()
+{
+	m_cache.clear();
+}
+
+PageSnapshotCache::Key PageSnapshotCache::key(WebTab* tab, const QUrl& url)
+{
+	return Key(reinterpret_cast<quintptr>(tab), url.toString(QUrl::RemoveFragment));
+}
+
+QImage PageSnapshotCache::scaled(const QImage& screenshot)
+{
+	QImage snapshot{screenshot.convertToFormat(QImage::Format_RGB32)};
+
+	if (snapshot.width() > MaximumSnapshotWidth)
+		snapshot = snapshot.scaledToWidth(MaximumSnapshotWidth, Qt::SmoothTransformation);
+
+	return snapshot;
+}
+
+void PageSnapshotCache::store(WebTab* tab, const Key& key, const QImage& snapshot)
+{
+	// The tab may have moved to another window while the snapshot was scaled
+	if (snapshot.isNull() || !tab->tabWidget() || tab->tabWidget()->window()->pageSnapshotCache() != this)
+		return;
+
+	if (!m_tabs.contains(key.first)) {
+		m_tabs.insert(key.first);
+
+		// The tab is already partly destroyed, only its address is used
+		connect(tab, &QObject::destroyed, this, [this, id = key.first]()
+		{
+			m_tabs.remove(id);
+			removeSnapshots(id);
+		});
+	}
+
+	m_cache.insert(key, new QImage(snapshot), qMax(1, static_cast<int>(snapshot.sizeInBytes() / 1024)));
+}
+
+void PageSnapshotCache::removeSnapshots(quintptr tabId)
+{
+	foreach (const Key& snapshotKey, m_cache.keys()) {
+		if (snapshotKey.first == tabId)
+			m_cache.remove(snapshotKey);
+	}
+}
+}
@@ -0,0 +1,84 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_PAGESNAPSHOTCACHE_HPP
+#define SIELOBROWSER_PAGESNAPSHOTCACHE_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+
+#include <QImage>
+#include <QUrl>
+#include <QCache>
+#include <QPair>
+#include <QSet>
+
+namespace Sn
+{
+class WebTab;
+
+/*
+ * Downscaled screenshots of the pages last shown in the tabs of a window. A tab restored after being discarded, or
+ * going back and forward in its history, paints the snapshot of the page right away while the real page loads
+ * under it.
+ *
+ * Snapshots are scaled on a worker thread. The cache has a fixed memory budget per window and evicts the least
+ * recently used snapshots, whatever tab they belong to.
+ */
+class SIELO_SHAREDLIB PageSnapshotCache: public QObject {
+Q_OBJECT
+
+public:
+	PageSnapshotCache(QObject* parent = nullptr);
+	~PageSnapshotCache();
+
+	void loadSettings();
+
+	void insert(WebTab* tab, const QUrl& url, const QImage& screenshot);
+	QImage find(WebTab* tab, const QUrl& url);
+	bool contains(WebTab* tab, const QUrl& url) const;
+	void remove(WebTab* tab);
+	void clear();
+
+	// Memory used by the snapshots, in KiB
+	int totalCost() const { return m_cache.totalCost(); }
+	int maxCost() const { return m_cache.maxCost(); }
+
+private:
+	typedef QPair<quintptr, QString> Key;
+
+	static Key key(WebTab* tab, const QUrl& url);
+	static QImage scaled(const QImage& screenshot);
+
+	void store(WebTab* tab, const Key& key, const QImage& snapshot);
+	void removeSnapshots(quintptr tabId);
+
+	QCache<Key, QImage> m_cache;
+	QSet<quintptr> m_tabs{};
+};
+}
+
+#endif //SIELOBROWSER_PAGESNAPSHOTCACHE_HPP
@@ -0,0 +1,341 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "TabLifecycleManager.hpp"
+
+#include <QDateTime>
+#include <QEvent>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+#include "Application.hpp"
+
+#include "Utils/Settings.hpp"
+
+#include "Network/NetworkManager.hpp"
+#include "Network/WebSocketInterceptor.hpp"
+
+#include "Web/WebPage.hpp"
+#include "Web/HTML5Permissions/HTML5PermissionsManager.hpp"
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabbedWebView.hpp"
+
+namespace Sn
+{
+TabLifecycleManager::TabLifecycleManager(QObject* parent) :
+	QObject(parent),
+	m_checkTimer(new QTimer(this)),
+	m_freezeTimer(new QTimer(this)),
+	m_memoryWatcher(new QFutureWatcher<QVector<ProcessMemory::ProcessInfo>>(this))
+{
+	connect(m_checkTimer, &QTimer::timeout, this, &TabLifecycleManager::checkMemory);
+	connect(m_memoryWatcher, &QFutureWatcher<QVector<ProcessMemory::ProcessInfo>>::finished, this,
+			&TabLifecycleManager::memoryChecked);
+	connect(m_freezeTimer, &QTimer::timeout, this, &TabLifecycleManager::checkBackgroundTabs);
+
+	// Owned by the network manager, it is gone with it
+	m_webSocketInterceptor = new WebSocketInterceptor(Application::instance()->networkManager());
+	Application::instance()->networkManager()->installUrlInterceptor(m_webSocketInterceptor);
+
+	loadSettings();
+}
+
+TabLifecycleManager::~TabLifecycleManager()
+{
+	m_memoryWatcher->waitForFinished();
+
+	if (m_webSocketInterceptor) {
+		Application::instance()->networkManager()->removeUrlInterceptor(m_webSocketInterceptor);
+		delete m_webSocketInterceptor;
+	}
+}
+
+void TabLifecycleManager::loadSettings()
+{
+	Settings settings{};
+
+	settings.beginGroup("Web-Settings");
+
+	m_enabled = settings.value(QLatin1String("discardTabsUnderMemoryPressure"), false).toBool();
+	m_memoryBudget = settings.value(QLatin1String("tabsMemoryBudget"), 4096).toLongLong() * 1024 * 1024;
+	const int interval{settings.value(QLatin1String("tabsMemoryCheckInterval"), 30).toInt()};
+	m_freezeDelay = settings.value(QLatin1String("freezeBackgroundTabsAfter"), 5).toLongLong() * 60 * 1000;
+
+	settings.endGroup();
+
+	if (m_enabled && ProcessMemory::isAvailable())
+		m_checkTimer->start(qMax(5, interval) * 1000);
+	else
+		m_checkTimer->stop();
+
+	if (m_freezeDelay > 0) {
+		m_freezeTimer->start(60 * 1000);
+	}
+	else {
+		m_freezeTimer->stop();
+
+		for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it)
+			thawTab(it.key());
+	}
+}
+
+void TabLifecycleManager::addTab(WebTab* tab)
+{
+	if (!tab || m_tabs.contains(tab))
+		return;
+
+	TabState state{};
+	state.lastActivation = QDateTime::currentMSecsSinceEpoch();
+
+	m_tabs.insert(tab, state);
+
+	tab->installEventFilter(this);
+
+	connect(tab, &WebTab::currentTabChanged, this, [this, tab](bool current)
+	{
+		if (current)
+			tabActivated(tab);
+	});
+}
+
+void TabLifecycleManager::removeTab(WebTab* tab)
+{
+	tab->removeEventFilter(this);
+	m_tabs.remove(tab);
+}
+
+bool TabLifecycleManager::canFreeze(WebTab* tab) const
+{
+	if (!tab || !m_tabs.contains(tab) || !tab->isRestored() || tab->application())
+		return false;
+
+	if (tab->webView()->page()->isFrozen() || !isInBackground(tab) || tab->isPlaying() || tab->isLoading())
+		return false;
+
+	const QUrl url{tab->url()};
+
+	if (url.isEmpty() || url.scheme() == QLatin1String("sielo"))
+		return false;
+
+	if (m_webSocketInterceptor && m_webSocketInterceptor->hasOpenedWebSockets(url.host()))
+		return false;
+
+	return Application::instance()->permissionsManager()->permission(url, Engine::WebPage::Notifications)
+		!= Engine::WebPage::PermissionGrantedByUser;
+}
+
+void TabLifecycleManager::freezeTab(WebTab* tab)
+{
+	if (!canFreeze(tab))
+		return;
+
+	WebPage* page{tab->webView()->page()};
+	page->setFrozen(true);
+
+	if (page->isFrozen()) {
+		++m_totalFreezeCount;
+		emit tabFrozen(tab);
+	}
+}
+
+void TabLifecycleManager::thawTab(WebTab* tab)
+{
+	if (tab && tab->webView()->page()->isFrozen())
+		tab->webView()->page()->setFrozen(false);
+}
+
+bool TabLifecycleManager::canDiscard(WebTab* tab) const
+{
+	if (!tab || !m_tabs.contains(tab) || !tab->tabWidget())
+		return false;
+
+	if (!tab->isRestored() || tab->application() || tab->url().isEmpty())
+		return false;
+
+	return !tab->isCurrentTab() && !tab->isPinned() && !tab->isPlaying() && !tab->isLoading();
+}
+
+bool TabLifecycleManager::discardTab(WebTab* tab)
+{
+	if (!canDiscard(tab))
+		return false;
+
+	tab->unload();
+
+	++m_tabs[tab].discardCount;
+	++m_totalDiscardCount;
+
+	emit tabDiscarded(tab);
+
+	return true;
+}
+
+qint64 TabLifecycleManager::memoryEstimate(WebTab* tab) const
+{
+	if (!tab || !tab->isRestored() || tab->application())
+		return 0;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	const qint64 pid{tab->webView()->page()->renderProcessPid()};
+
+	if (pid > 0) {
+		int sharingTabs{0};
+
+		for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
+			if (it.key()->isRestored() && it.key()->webView()->page()->renderProcessPid() == pid)
+				++sharingTabs;
+		}
+
+		return ProcessMemory::processInfo(pid).residentBytes / qMax(1, sharingTabs);
+	}
+#endif
+
+	// Without the renderer pid, the memory of all renderers is split between the tabs having a page
+	return m_rendererBytes / qMax(1, liveTabCount());
+}
+
+qint64 TabLifecycleManager::lastActivation(WebTab* tab) const
+{
+	return m_tabs.value(tab).lastActivation;
+}
+
+int TabLifecycleManager::discardCount(WebTab* tab) const
+{
+	return m_tabs.value(tab).discardCount;
+}
+
+int TabLifecycleManager::frozenTabCount() const
+{
+	int count{0};
+
+	for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
+		if (it.key()->webView()->page()->isFrozen())
+			++count;
+	}
+
+	return count;
+}
+
+void TabLifecycleManager::checkMemory()
+{
+	// Reading /proc for every process takes a while with many renderers, it is kept out of the GUI thread
+	if (!m_memoryWatcher->isRunning())
+		m_memoryWatcher->setFuture(QtConcurrent::run(&ProcessMemory::browserProcesses));
+}
+
+void TabLifecycleManager::memoryChecked()
+{
+	const QVector<ProcessMemory::ProcessInfo> processes{m_memoryWatcher->result()};
+
+	if (processes.isEmpty())
+		return;
+
+	qint64 total{0};
+
+	foreach (const ProcessMemory::ProcessInfo& process, processes)
+		total += process.residentBytes;
+
+	m_rendererBytes = total - processes.first().residentBytes;
+
+	if (!m_enabled || total <= m_memoryBudget)
+		return;
+
+	QList<WebTab*> candidates{};
+
+	for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
+		if (canDiscard(it.key()))
+			candidates.append(it.key());
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [this](WebTab* first, WebTab* second)
+	{
+		return m_tabs.value(first).lastActivation < m_tabs.value(second).lastActivation;
+	});
+
+	// Renderer processes exit asynchronously, so the memory freed is estimated and measured again on next check
+	foreach (WebTab* tab, candidates) {
+		if (total <= m_memoryBudget)
+			break;
+
+		const qint64 estimate{memoryEstimate(tab)};
+
+		if (discardTab(tab))
+			total -= estimate;
+	}
+}
+
+void TabLifecycleManager::checkBackgroundTabs()
+{
+	if (m_freezeDelay <= 0)
+		return;
+
+	const qint64 now{QDateTime::currentMSecsSinceEpoch()};
+
+	for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
+		if (now - it.value().lastActivation >= m_freezeDelay)
+			freezeTab(it.key());
+	}
+}
+
+bool TabLifecycleManager::eventFilter(QObject* watched, QEvent* event)
+{
+	WebTab* tab{qobject_cast<WebTab*>(watched)};
+
+	// A tab stays current in a hidden tabs space, so showing and hiding it counts as an activation too
+	if (tab && (event->type() == QEvent::Show || event->type() == QEvent::Hide))
+		tabActivated(tab);
+
+	return QObject::eventFilter(watched, event);
+}
+
+void TabLifecycleManager::tabActivated(WebTab* tab)
+{
+	auto it = m_tabs.find(tab);
+
+	if (it != m_tabs.end())
+		it.value().lastActivation = QDateTime::currentMSecsSinceEpoch();
+
+	if (!isInBackground(tab))
+		thawTab(tab);
+}
+
+bool TabLifecycleManager::isInBackground(WebTab* tab) const
+{
+	return !tab->isCurrentTab() || !tab->isVisible();
+}
+
+int TabLifecycleManager::liveTabCount() const
+{
+	int count{0};
+
+	for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
+		if (it.key()->isRestored() && !it.key()->application())
+			++count;
+	}
+
+	return count;
+}
+}
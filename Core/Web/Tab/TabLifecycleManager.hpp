@@ -0,0 +1,124 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_TABLIFECYCLEMANAGER_HPP
+#define SIELOBROWSER_TABLIFECYCLEMANAGER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QObject>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QPointer>
+
+#include <QHash>
+#include <QVector>
+
+#include "Utils/ProcessMemory.hpp"
+
+namespace Sn
+{
+class WebTab;
+class WebSocketInterceptor;
+
+/*
+ * When enabled, discards background tabs once Sielo and its web engine processes use more memory than the configured
+ * budget. Processes memory is read from /proc on a worker thread.
+ * Tabs are discarded with WebTab::unload(), least recently activated first, and are reloaded when activated again.
+ * The current tab, pinned tabs, tabs playing audio, loading tabs and application tabs are never discarded.
+ *
+ * Before being discarded, tabs left in background for a few minutes are frozen: their page stops running timers and
+ * animations until the tab is shown again. Tabs playing audio, on a site that opened a WebSocket during the session
+ * or allowed to show notifications keep running.
+ */
+class SIELO_SHAREDLIB TabLifecycleManager: public QObject {
+	Q_OBJECT
+
+public:
+	TabLifecycleManager(QObject* parent = nullptr);
+	~TabLifecycleManager();
+
+	void loadSettings();
+
+	void addTab(WebTab* tab);
+	void removeTab(WebTab* tab);
+
+	bool canDiscard(WebTab* tab) const;
+	bool discardTab(WebTab* tab);
+
+	bool canFreeze(WebTab* tab) const;
+	void freezeTab(WebTab* tab);
+	void thawTab(WebTab* tab);
+
+	// Memory used by the renderer of the tab, shared between the tabs of a same process
+	qint64 memoryEstimate(WebTab* tab) const;
+	qint64 memoryBudget() const { return m_memoryBudget; }
+	qint64 lastActivation(WebTab* tab) const;
+
+	int discardCount(WebTab* tab) const;
+	int totalDiscardCount() const { return m_totalDiscardCount; }
+	int frozenTabCount() const;
+	int totalFreezeCount() const { return m_totalFreezeCount; }
+
+	QList<WebTab*> tabs() const { return m_tabs.keys(); }
+
+signals:
+	void tabDiscarded(WebTab* tab);
+	void tabFrozen(WebTab* tab);
+
+public slots:
+	void checkMemory();
+	void checkBackgroundTabs();
+
+protected:
+	bool eventFilter(QObject* watched, QEvent* event);
+
+private:
+	struct TabState {
+		qint64 lastActivation{0};
+		int discardCount{0};
+	};
+
+	void memoryChecked();
+	void tabActivated(WebTab* tab);
+	bool isInBackground(WebTab* tab) const;
+	int liveTabCount() const;
+
+	QHash<WebTab*, TabState> m_tabs{};
+	QTimer* m_checkTimer{nullptr};
+	QTimer* m_freezeTimer{nullptr};
+	QFutureWatcher<QVector<ProcessMemory::ProcessInfo>>* m_memoryWatcher{nullptr};
+	QPointer<WebSocketInterceptor> m_webSocketInterceptor{};
+
+	bool m_enabled{false};
+	qint64 m_memoryBudget{0};
+	qint64 m_freezeDelay{0};
+	qint64 m_rendererBytes{0};
+	int m_totalDiscardCount{0};
+	int m_totalFreezeCount{0};
+};
+}
+
+#endif //SIELOBROWSER_TABLIFECYCLEMANAGER_HPP
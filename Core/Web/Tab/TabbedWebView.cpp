@@ -27,11 +27,17 @@
 #include <QStatusBar>
 
 #include <QMimeData>
+#include <QPointer>
+
+#include <QWebEngine/WebHistory.hpp>
 
 #include "BrowserWindow.hpp"
 
 #include "History/History.hpp"
 
+#include "Network/HostInfoCache.hpp"
+#include "Network/SpeculativeLoader.hpp"
+
 #include "Widgets/NavigationBar.hpp"
 #include "Widgets/StatusBarMessage.hpp"
 #include "Widgets/AddressBar/AddressBar.hpp"
@@ -66,9 +72,9 @@ void TabbedWebView::setWebPage(WebPage* page)
 	page->setParent(this);
 	setPage(page);
 
-	connect(page, &WebPage::linkHovered, this, &TabbedWebView::linkHovered);
+	connect(page, &WebPage::linkHovered, this, &TabbedWebView::linkHovered, Qt::UniqueConnection);
 #ifdef EXP_TRANSPARENT_BG
-	connect(page, &WebPage::pageRendering, this, &TabbedWebView::sPageRendering);
+	connect(page, &WebPage::pageRendering, this, &TabbedWebView::sPageRendering, Qt::UniqueConnection);
 #endif // EXP_TRANSPARENT_BG
 }
 
@@ -125,6 +131,21 @@ void TabbedWebView::setAsCurrentTab()
 
 void TabbedWebView::userLoadAction(const LoadRequest& request)
 {
+	// The prerendered page has a history of its own, it only replaces a page the user can't go back from
+	const bool canSwap{request.operation() == LoadRequest::GetOp && !history()->canGoBack()};
+
+	if (WebPage* prerendered = Application::instance()->speculativeLoader()->commit(request.url(), canSwap)) {
+		setWebPage(prerendered);
+
+		// A page done loading before the swap won't emit loadFinished for this view
+		if (!prerendered->isLoading()) {
+			Application::instance()->history()->addHistoryEntry(this);
+			sLoadFinished();
+		}
+
+		return;
+	}
+
 	load(request);
 }
 
@@ -133,7 +154,7 @@ void TabbedWebView::userLoadAction(const LoadRequest& request)
 void TabbedWebView::paintEvent(QPaintEvent* event)
 {
 	QPainter painter(this);
-	if (m_tabWidget->window()->background() != nullptr && isTransparent()) {
+	if (m_tabWidget->window()->processedBackground() != nullptr && isTransparent()) {
 		QPoint global_position = mapTo(m_tabWidget->window(), QPoint(0, 0));
 		QRect shot_rect(global_position.x(), global_position.y(), width(), height());
 		painter.drawImage(QPoint(), *m_tabWidget->window()->processedBackground(), shot_rect);
@@ -155,7 +176,17 @@ void TabbedWebView::sLoadProgress(int progress)
 
 void TabbedWebView::sLoadFinished()
 {
-	QHostInfo::lookupHost(url().host(), this, SLOT(setIp(QHostInfo)));
+	const QString host{url().host()};
+
+	if (host.isEmpty())
+		return;
+
+	Application::instance()->hostInfoCache()->lookup(host, this, [this, host](const QHostInfo& info)
+	{
+		// Another page may have been loaded meanwhile
+		if (url().host() == host)
+			setIp(info);
+	});
 }
 
 #ifdef EXP_TRANSPARENT_BG
@@ -191,6 +222,9 @@ void TabbedWebView::urlChanged(const QUrl& url)
 
 void TabbedWebView::linkHovered(const QString& link)
 {
+	if (!link.isEmpty())
+		Application::instance()->hostInfoCache()->prefetch(QUrl(link).host());
+
 	if (m_webTab->isCurrentTab() && m_tabWidget->window()) {
 		if (link.isEmpty()) {
 			m_tabWidget->statusBarMessage()->clearMessage();
@@ -222,23 +256,27 @@ void TabbedWebView::inspectElement()
 
 void TabbedWebView::newContextMenuEvent(QContextMenuEvent* event)
 {
-	m_menu->clear();
-
-	WebHitTestResult hitTest{page()->hitTestContent(event->pos())};
-	createContextMenu(m_menu, hitTest);
-	m_menu->addSeparator();
-	m_menu->addAction(Application::getAppIcon("text-html"), tr("Show so&urce code"), this, &WebView::showSource);
-	m_menu->addAction(tr("Inspect Element"), this, &TabbedWebView::inspectElement);
-
-	if (!m_menu->isEmpty()) {
-		const QPoint pos{event->globalPos()};
-		QPoint p{pos.x(), pos.y() + 1};
+	const QPoint globalPos{event->globalPos()};
+	QPointer<TabbedWebView> view{this};
 
-		m_menu->popup(p);
-		return;
-	}
+	// The menu is shown once the renderer answered, the event loop keeps running meanwhile
+	page()->hitTestContent(event->pos(), [view, globalPos](const WebHitTestResult& result)
+	{
+		if (!view)
+			return;
+
+		WebHitTestResult hitTest{result};
+
+		view->m_menu->clear();
+		view->createContextMenu(view->m_menu, hitTest);
+		view->m_menu->addSeparator();
+		view->m_menu->addAction(Application::getAppIcon("text-html"), tr("Show so&urce code"), view.data(),
+								&WebView::showSource);
+		view->m_menu->addAction(tr("Inspect Element"), view.data(), &TabbedWebView::inspectElement);
+		view->m_menu->popup(QPoint(globalPos.x(), globalPos.y() + 1));
+	});
 
-	WebView::newContextMenuEvent(event);
+	event->accept();
 }
 
 void TabbedWebView::newMousePressEvent(QMouseEvent* event)
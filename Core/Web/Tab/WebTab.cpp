@@ -27,14 +27,19 @@
 #include <QColor>
 #include <QLineEdit>
 
+#include <memory>
+
 #include "BrowserWindow.hpp"
 
-#include "Utils/Settings.hpp"
+#include "Utils/SettingsSnapshot.hpp"
+#include "Utils/ThumbnailService.hpp"
 
 #include "Plugins/PluginProxy.hpp"
 
 #include "Web/WebPage.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
+#include "Web/Tab/TabLifecycleManager.hpp"
+#include "Web/Tab/PageSnapshotCache.hpp"
 
 #include "Widgets/FloatingButton.hpp"
 #include "Widgets/SearchToolBar.hpp"
@@ -45,8 +50,13 @@
 
 namespace Sn
 {
+// A snapshot is hidden after this delay even if the page is still loading, it doesn't react to the user
+static const int SnapshotTimeout = 5 * 1000;
+// Leaves the page some time to paint, or the user to stop scrolling, before taking its snapshot
+static const int SnapshotCaptureDelay = 1000;
+
 
-static const int SAVED_TAB_VERSION = 2;
+static const int SAVED_TAB_VERSION = 3;
 static WebTab::AddChildBehavior s_addChildBehavior = WebTab::AppendChild;
 
 WebTab::AddChildBehavior WebTab::addChildBehavior()
@@ -60,12 +70,10 @@ void WebTab::setAddChildBehavior(AddChildBehavior behavior)
 }
 
 WebTab::SavedTab::SavedTab() :
-	isPinned(false)
+	isPinned(false),
+	zoomLevel(SettingsSnapshot::current()->defaultZoomLevel)
 {
-	Settings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
-
-	zoomLevel = defaultZoomLevel;
+	// Empty
 }
 
 WebTab::SavedTab::SavedTab(WebTab* webTab)
@@ -76,6 +84,8 @@ WebTab::SavedTab::SavedTab(WebTab* webTab)
 	history = webTab->historyData();
 	isPinned = webTab->isPinned();
 	zoomLevel = webTab->zoomLevel();
+	scrollPosition = webTab->isRestored() ? webTab->webView()->page()->scrollPosition()
+										  : webTab->m_savedTab.scrollPosition;
 	parentTab = webTab->parentTab() ? webTab->parentTab()->tabIndex() : -1;
 
 	const auto children = webTab->childTabs();
@@ -94,15 +104,13 @@ bool WebTab::SavedTab::isValide() const
 
 void WebTab::SavedTab::clear()
 {
-	Settings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
-
 	title.clear();
 	url.clear();
 	icon = QIcon();
 	history.clear();
 	isPinned = false;
-	zoomLevel = defaultZoomLevel;
+	zoomLevel = SettingsSnapshot::current()->defaultZoomLevel;
+	scrollPosition = QPointF();
 	parentTab = -1;
 	childTabs.clear();
 	sessionData.clear();
@@ -120,6 +128,7 @@ QDataStream& operator<<(QDataStream& stream, const WebTab::SavedTab& tab)
 	stream << tab.parentTab;
 	stream << tab.childTabs;
 	stream << tab.sessionData;
+	stream << tab.scrollPosition;
 
 	return stream;
 
@@ -158,6 +167,9 @@ QDataStream& operator>>(QDataStream& stream, WebTab::SavedTab& tab)
 		stream >> tab.sessionData;
 	}
 
+	if (version >= 3)
+		stream >> tab.scrollPosition;
+
 	tab.icon = Application::getAppIcon("webpage");
 
 	return stream;
@@ -213,14 +225,43 @@ WebTab::WebTab(TabWidget* tabWidget) :
 
 	auto pageChanged = [this](WebPage *page)
 	{
-		connect(page, &WebPage::audioMutedChanged, this, &WebTab::playingChanged);
-		connect(page, &WebPage::recentlyAudibleChanged, this, &WebTab::mutedChanged);
+		connect(page, &WebPage::audioMutedChanged, this, &WebTab::mutedChanged);
+		connect(page, &WebPage::recentlyAudibleChanged, this, &WebTab::playingChanged);
+		connect(page, &WebPage::scrollPositionChanged, this, [this]()
+		{
+			m_snapshotOutdated = true;
+
+			if (m_isCurrentTab)
+				m_snapshotCaptureTimer->start();
+		});
 	};
 
 	pageChanged(m_webView->page());
 
 	connect(m_webView, &TabbedWebView::pageChanged, this, pageChanged);
 
+	m_snapshotTimer = new QTimer(this);
+	m_snapshotTimer->setSingleShot(true);
+	m_snapshotTimer->setInterval(SnapshotTimeout);
+
+	connect(m_snapshotTimer, &QTimer::timeout, this, &WebTab::hideSnapshot);
+
+	m_snapshotCaptureTimer = new QTimer(this);
+	m_snapshotCaptureTimer->setSingleShot(true);
+	m_snapshotCaptureTimer->setInterval(SnapshotCaptureDelay);
+
+	connect(m_snapshotCaptureTimer, &QTimer::timeout, this, &WebTab::captureSnapshot);
+	connect(m_webView, &TabbedWebView::aboutToNavigateHistory, this, [this](const QUrl& url)
+	{
+		const bool sameDocument{url.adjusted(QUrl::RemoveFragment) == m_webView->url().adjusted(QUrl::RemoveFragment)};
+
+		captureSnapshot();
+
+		// Navigations inside the same document don't load anything
+		if (!sameDocument)
+			showSnapshot(url);
+	});
+
 	connect(m_tabIcon, &TabIcon::resized, this, [this]()
 	{
 		if (m_tabWidget->tabBar())
@@ -247,7 +288,10 @@ WebTab::WebTab(TabWidget* tabWidget) :
 	setLayout(layout);
 
 	setFocusProxy(m_webView);
-	
+
+	m_lifecycleManager = Application::instance()->tabLifecycleManager();
+	m_lifecycleManager->addTab(this);
+
 	Application::instance()->plugins()->emitWebTabCreated(this);
 }
 
@@ -257,6 +301,10 @@ WebTab::~WebTab()
 {
 	Application::instance()->plugins()->emitWebTabDeleted(this);
 
+	// The manager may already be gone when the application quits
+	if (m_lifecycleManager)
+		m_lifecycleManager->removeTab(this);
+
 	if (m_application) {
 		m_application->disconnect();
 		delete m_application;
@@ -391,6 +439,9 @@ void WebTab::detach()
 	Q_ASSERT(m_tabWidget->tabBar());
 
 	removeFromTabTree();
+
+	hideSnapshot();
+	m_tabWidget->window()->pageSnapshotCache()->remove(this);
 	
 	m_tabWidget->tabBar()->setTabButton(tabIndex(), m_tabWidget->tabBar()->iconButtonPosition(), nullptr);
 	m_tabIcon->setParent(nullptr);
@@ -502,6 +553,8 @@ void WebTab::loadApplication(QWidget* application)
 
 void WebTab::unload()
 {
+	captureSnapshot();
+
 	m_savedTab = SavedTab(this);
 	
 	emit restoredChanged(isRestored());
@@ -548,6 +601,11 @@ bool WebTab::isMuted() const
 	return m_webView->page()->isAudioMuted();
 }
 
+bool WebTab::isPlaying() const
+{
+	return m_webView->page()->recentlyAudible();
+}
+
 void WebTab::setMuted(bool muted)
 {
 	m_webView->page()->setAudioMuted(muted);
@@ -639,12 +697,10 @@ void WebTab::restoreTab(const SavedTab& tab)
 {
 	Q_ASSERT(m_tabWidget->tabBar());
 
-	Settings settings{};
-
 	m_isPinned = tab.isPinned;
 	m_sessionData = tab.sessionData;
 
-	if (!isPinned() && settings.value("Web-Settings/LoadTabsOnActivation", true).toBool()) {
+	if (!isPinned() && SettingsSnapshot::current()->loadTabsOnActivation) {
 		m_savedTab = tab;
 
 		emit restoredChanged(isRestored());
@@ -677,6 +733,21 @@ void WebTab::restoreTab(const SavedTab& tab)
 void WebTab::p_restoreTab(const SavedTab& tab)
 {
 	p_restoreTab(tab.url, tab.history, tab.zoomLevel);
+
+	if (tab.scrollPosition.isNull())
+		return;
+
+	// Discarded tabs are reloaded where the user left them
+	const QPointF position{tab.scrollPosition};
+	auto connection = std::make_shared<QMetaObject::Connection>();
+
+	*connection = connect(m_webView, &TabbedWebView::loadFinished, this, [this, position, connection](bool ok)
+	{
+		disconnect(*connection);
+
+		if (ok)
+			m_webView->page()->runJavaScript(QStringLiteral("window.scrollTo(%1, %2)").arg(position.x()).arg(position.y()));
+	});
 }
 
 void WebTab::p_restoreTab(const QUrl& url, const QByteArray& history, int zoomLevel)
@@ -701,6 +772,7 @@ void WebTab::tabActivated()
 		if (isRestored())
 			return;
 
+		showSnapshot(m_savedTab.url);
 		p_restoreTab(m_savedTab);
 		m_savedTab.clear();
 
@@ -760,6 +832,12 @@ void WebTab::loadStarted()
 
 void WebTab::loadFinished()
 {
+	hideSnapshot();
+	m_snapshotOutdated = true;
+
+	if (m_isCurrentTab)
+		m_snapshotCaptureTimer->start();
+
 	titleChanged(m_webView->title());
 }
 
@@ -781,6 +859,97 @@ void WebTab::resizeEvent(QResizeEvent* event)
 	m_notificationWidget->setFixedWidth(width());
 }
 
+bool WebTab::eventFilter(QObject* watched, QEvent* event)
+{
+	if (m_snapshotView && watched == m_webView && event->type() == QEvent::Resize)
+		m_snapshotView->setGeometry(m_webView->rect());
+	else if (watched == m_snapshotView && (event->type() == QEvent::MouseButtonPress || event->type() == QEvent::Wheel))
+		hideSnapshot();
+
+	return QWidget::eventFilter(watched, event);
+}
+
+void WebTab::captureSnapshot()
+{
+	// Only a page fully loaded and really shown can be grabbed
+	if (!m_snapshotOutdated || !isRestored() || m_application || isLoading() || !m_webView->isVisible()
+		|| (m_snapshotView && m_snapshotView->isVisible()))
+		return;
+
+	PageSnapshotCache* cache{snapshotCache()};
+	const QUrl url{m_webView->url()};
+
+	if (!cache || url.isEmpty())
+		return;
+
+	const QImage screenshot{m_webView->grab().toImage()};
+
+	cache->insert(this, url, screenshot);
+	Application::instance()->thumbnailService()->store(url, screenshot);
+
+	m_snapshotOutdated = false;
+}
+
+void WebTab::captureMissingSnapshot()
+{
+	m_snapshotCaptureTimer->stop();
+
+	PageSnapshotCache* cache{snapshotCache()};
+
+	// The snapshot taken once the page settled is kept, switching tabs only grabs pages that never had one
+	if (cache && cache->contains(this, m_webView->url()))
+		return;
+
+	captureSnapshot();
+}
+
+PageSnapshotCache* WebTab::snapshotCache() const
+{
+	return m_tabWidget ? m_tabWidget->window()->pageSnapshotCache() : nullptr;
+}
+
+void WebTab::showSnapshot(const QUrl& url)
+{
+	PageSnapshotCache* cache{snapshotCache()};
+
+	if (!cache || url.isEmpty() || m_webView->height() <= 0)
+		return;
+
+	const QImage snapshot{cache->find(this, url)};
+
+	// A snapshot taken with another window shape would be distorted
+	if (snapshot.isNull() || qAbs(static_cast<qreal>(snapshot.width()) / snapshot.height()
+		- static_cast<qreal>(m_webView->width()) / m_webView->height()) > 0.02)
+		return;
+
+	if (!m_snapshotView) {
+		m_snapshotView = new QLabel(m_webView);
+		m_snapshotView->setScaledContents(true);
+		m_snapshotView->setAutoFillBackground(true);
+		m_snapshotView->installEventFilter(this);
+	}
+
+	m_snapshotView->setPixmap(QPixmap::fromImage(snapshot));
+	m_snapshotView->setGeometry(m_webView->rect());
+	m_snapshotView->show();
+	m_snapshotView->raise();
+
+	m_webView->installEventFilter(this);
+	m_snapshotTimer->start();
+}
+
+void WebTab::hideSnapshot()
+{
+	m_snapshotTimer->stop();
+
+	if (!m_snapshotView || m_snapshotView->isHidden())
+		return;
+
+	m_snapshotView->hide();
+	m_snapshotView->clear();
+	m_webView->removeEventFilter(this);
+}
+
 void WebTab::removeFromTabTree()
 {
 	WebTab* parentTab{m_parentTab};
@@ -35,6 +35,8 @@
 #include <QIcon>
 #include <QPushButton>
 #include <QSplitter>
+#include <QLabel>
+#include <QTimer>
 
 #include <QMenu>
 #include <QToolBar>
@@ -58,6 +60,8 @@ class TabbedWebView;
 
 class TabIcon;
 class MainTabBar;
+class PageSnapshotCache;
+class TabLifecycleManager;
 
 class FloatingButton;
 class AddressBar;
@@ -73,6 +77,7 @@ public:
 		QByteArray history{};
 		bool isPinned{false};
 		int zoomLevel{};
+		QPointF scrollPosition{};
 		int parentTab{-1};
 		QVector<int> childTabs{};
 		QHash<QString, QVariant> sessionData{};
@@ -167,6 +172,11 @@ public:
 
 	void tabActivated();
 
+	// Keeps a snapshot of the page shown, painted while this page is loaded again, and its preview
+	void captureSnapshot();
+	// Same, unless a snapshot of the page was already taken: grabbing the view is too slow for each tab switch
+	void captureMissingSnapshot();
+
 	static AddChildBehavior addChildBehavior();
 	static void setAddChildBehavior(AddChildBehavior behavior);
 
@@ -197,8 +207,13 @@ private slots:
 private:
 	void titleWasChanged(const QString& title);
 	void resizeEvent(QResizeEvent* event) override;
+	bool eventFilter(QObject* watched, QEvent* event) override;
 	void removeFromTabTree();
 
+	PageSnapshotCache* snapshotCache() const;
+	void showSnapshot(const QUrl& url);
+	void hideSnapshot();
+
 	QVBoxLayout* m_layout{nullptr};
 	QSplitter* m_splitter{nullptr};
 
@@ -208,8 +223,12 @@ private:
 	QPointer<WebInspector> m_inspector{};
 	TabbedWebView* m_webView{nullptr};
 	QPointer<QWidget> m_application{};
+	QPointer<TabLifecycleManager> m_lifecycleManager{};
 	TabIcon* m_tabIcon{nullptr};
 	QWidget* m_notificationWidget{nullptr};
+	QLabel* m_snapshotView{nullptr};
+	QTimer* m_snapshotTimer{nullptr};
+	QTimer* m_snapshotCaptureTimer{nullptr};
 
 	AddressBar* m_addressBar{nullptr};
 
@@ -220,6 +239,7 @@ private:
 	SavedTab m_savedTab{};
 	bool m_isPinned{false};
 	bool m_isCurrentTab{false};
+	bool m_snapshotOutdated{true};
 };
 }
 #endif //SIELOBROWSER_WEBTAB_HPP
@@ -31,12 +31,26 @@
 namespace Sn {
 
 WebHitTestResult::WebHitTestResult(const WebPage* page, const QPoint& pos) :
-	m_isNull(true),
-	m_isContentEditable(false),
-	m_isContentSelected(false),
-	m_mediaPaused(false),
-	m_mediaMuted(false),
 	m_pos(pos)
+{
+	WebPage* p = const_cast<WebPage*>(page);
+	m_viewportPos = p->mapToViewport(m_pos);
+
+	const QVariantMap& map{
+		p->executeJavaScript(source(m_viewportPos), Engine::WebProfile::ScriptWorldId::ApplicationWorld).toMap()
+	};
+
+	init(page->url(), map);
+}
+
+WebHitTestResult::WebHitTestResult(const WebPage* page, const QPoint& pos, const QVariantMap& result) :
+	m_pos(pos),
+	m_viewportPos(page->mapToViewport(pos))
+{
+	init(page->url(), result);
+}
+
+QString WebHitTestResult::source(const QPointF& viewportPos)
 {
 	QString source = QLatin1String("(function() {"
 									   "var e = document.elementFromPoint(%1, %2);"
@@ -79,11 +93,11 @@ WebHitTestResult::WebHitTestResult(const WebPage* page, const QPoint& pos) :
 									   "    res.linkUrl = e.getAttribute('href');"
 									   "}"
 									   "while (e) {"
-									   "    if (res.linkTitle == ''& & e.tagName == 'A')"
+									   "    if (res.linkTitle == '' && e.tagName == 'A')"
 									   "        res.linkTitle = e.text;"
-									   "    if (res.linkUrl == ''& & e.tagName == 'A')"
+									   "    if (res.linkUrl == '' && e.tagName == 'A')"
 									   "        res.linkUrl = e.getAttribute('href');"
-									   "    if (res.mediaUrl == ''& & isMediaElement(e)) {"
+									   "    if (res.mediaUrl == '' && isMediaElement(e)) {"
 									   "        res.mediaUrl = e.currentSrc;"
 									   "        res.mediaPaused = e.paused;"
 									   "        res.mediaMuted = e.muted;"
@@ -93,13 +107,11 @@ WebHitTestResult::WebHitTestResult(const WebPage* page, const QPoint& pos) :
 									   "return res;"
 									   "})()");
 
-	WebPage* p = const_cast<WebPage*>(page);
-	m_viewportPos = p->mapToViewport(m_pos);
-
-	const QString& js = source.arg(m_viewportPos.x()).arg(m_viewportPos.y());
-	const QUrl& url{p->url()};
-	const QVariantMap& map{p->executeJavaScript(js, Engine::WebProfile::ScriptWorldId::ApplicationWorld).toMap()};
+	return source.arg(viewportPos.x()).arg(viewportPos.y());
+}
 
+void WebHitTestResult::init(const QUrl& url, const QVariantMap& map)
+{
 	if (map.isEmpty())
 		return;
 
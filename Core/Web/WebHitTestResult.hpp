@@ -42,7 +42,12 @@ class WebPage;
 
 class SIELO_SHAREDLIB WebHitTestResult {
 public:
+	// Runs the hit test in a nested event loop, WebPage::hitTestContent() has an asynchronous version
 	WebHitTestResult(const WebPage* page, const QPoint& pos);
+	// From the result of the script returned by source()
+	WebHitTestResult(const WebPage* page, const QPoint& pos, const QVariantMap& result);
+
+	static QString source(const QPointF& viewportPos);
 
 	void updateWithContextMenuData(const Engine::ContextMenuData& data);
 
@@ -63,6 +68,8 @@ public:
 	QString tagName() const;
 
 private:
+	void init(const QUrl& url, const QVariantMap& map);
+
 	bool m_isNull{true};
 	QUrl m_baseUrl{QUrl()};
 	QString m_alternateText{QString()};
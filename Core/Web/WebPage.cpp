@@ -33,6 +33,8 @@
 
 #include <QMessageBox>
 
+#include <QAuthenticator>
+
 #include "Web/WebHitTestResult.hpp"
 #include "Web/WebView.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
@@ -52,7 +54,9 @@
 
 #include "Utils/DelayedFileWatcher.hpp"
 #include "Utils/ExternalJsObject.hpp"
+#include "Utils/Metrics.hpp"
 #include "Utils/Settings.hpp"
+#include "Utils/SettingsSnapshot.hpp"
 
 #include "Plugins/PluginProxy.hpp"
 
@@ -94,9 +98,19 @@ WebPage::WebPage(QObject* parent) :
 	connect(this, &Engine::WebPage::urlChanged, this, &WebPage::urlChanged);
 	connect(this, &Engine::WebPage::featurePermissionRequested, this, &WebPage::featurePermissionRequested);
 	connect(this, &Engine::WebPage::windowCloseRequested, this, &WebPage::windowCloseRequested);
+	connect(this, &Engine::WebPage::linkHovered, this, [this](const QString& url)
+	{
+		m_hoveredLink = QUrl(url);
+	});
 
 	connect(this, &Engine::WebPage::authenticationRequired, this, [this](const QUrl& url, QAuthenticator* authenticator)
 	{
+		// A null authenticator cancels the request
+		if (m_prerendering) {
+			*authenticator = QAuthenticator();
+			return;
+		}
+
 		Application::instance()->networkManager()->authentication(url, authenticator, view());
 	});
 
@@ -115,6 +129,12 @@ WebPage::WebPage(QObject* parent) :
 			[this](const QUrl& url, QAuthenticator* authenticator, const QString& proxyHost)
 			{
 				Q_UNUSED(url);
+
+				if (m_prerendering) {
+					*authenticator = QAuthenticator();
+					return;
+				}
+
 				Application::instance()->networkManager()->proxyAuthentication(proxyHost, authenticator, view());
 			});
 }
@@ -184,6 +204,41 @@ WebHitTestResult WebPage::hitTestContent(const QPoint& pos) const
 	return WebHitTestResult(this, pos);
 }
 
+void WebPage::hitTestContent(const QPoint& pos, const std::function<void(const WebHitTestResult&)>& callback)
+{
+	QPointer<WebPage> page{this};
+
+	runJavaScript(WebHitTestResult::source(mapToViewport(pos)), Engine::WebProfile::ScriptWorldId::ApplicationWorld,
+				  [page, pos, callback](const QVariant& result)
+				  {
+					  if (page)
+						  callback(WebHitTestResult(page, pos, result.toMap()));
+				  });
+}
+
+QUrl WebPage::linkUrlAt(const QPoint& pos) const
+{
+	if (m_hoveredLink.isEmpty())
+		return QUrl();
+
+	// The reporter also knows where the link is, which catches links that moved away while the mouse didn't
+	if (m_reportedLink == m_hoveredLink && !m_reportedLinkRect.isEmpty())
+		return m_reportedLinkRect.contains(mapToViewport(pos)) ? m_hoveredLink : QUrl();
+
+	return m_hoveredLink;
+}
+
+void WebPage::setReportedHoveredLink(const QUrl& url, const QRectF& rect)
+{
+	m_reportedLink = url;
+	m_reportedLinkRect = url.isEmpty() ? QRectF() : rect;
+}
+
+void WebPage::startClickTimer()
+{
+	m_clickTimer.start();
+}
+
 void WebPage::scroll(int x, int y)
 {
 	runJavaScript(QStringLiteral("window.scrollTo(window.scrollX + %1, window.scrollY + %2)").arg(x).arg(y),
@@ -196,11 +251,17 @@ void WebPage::setScrollPosition(const QPointF& pos)
 	runJavaScript(QStringLiteral("window.scrollTo(%1, %2)").arg(v.x()).arg(v.y()));
 }
 
+void WebPage::setPrerendering(bool prerendering)
+{
+	m_prerendering = prerendering;
+	setAudioMuted(prerendering);
+}
+
 void WebPage::javaScriptAlert(const QUrl& securityOrigin, const QString& msg)
 {
 	Q_UNUSED(securityOrigin)
 
-	if (m_blockAlerts || m_runningLoop)
+	if (m_prerendering || m_blockAlerts || m_runningLoop)
 		return;
 
 	QString title{tr("JavaScript Alert")};
@@ -218,6 +279,23 @@ void WebPage::javaScriptAlert(const QUrl& securityOrigin, const QString& msg)
 	m_blockAlerts = dialog.isChecked();
 }
 
+bool WebPage::javaScriptConfirm(const QUrl& securityOrigin, const QString& msg)
+{
+	if (m_prerendering)
+		return false;
+
+	return Engine::WebPage::javaScriptConfirm(securityOrigin, msg);
+}
+
+bool WebPage::javaScriptPrompt(const QUrl& securityOrigin, const QString& msg, const QString& defaultValue,
+							   QString* result)
+{
+	if (m_prerendering)
+		return false;
+
+	return Engine::WebPage::javaScriptPrompt(securityOrigin, msg, defaultValue, result);
+}
+
 bool WebPage::isRunningLoop()
 {
 	return m_runningLoop;
@@ -334,6 +412,11 @@ void WebPage::windowCloseRequested()
 
 void WebPage::featurePermissionRequested(const QUrl& origin, const Engine::WebPage::Feature& feature)
 {
+	if (m_prerendering) {
+		setFeaturePermission(origin, feature, PermissionDeniedByUser);
+		return;
+	}
+
 	if (feature == MouseLock && view()->isFullScreen())
 		setFeaturePermission(origin, feature, PermissionGrantedByUser);
 	else
@@ -351,11 +434,22 @@ bool WebPage::acceptNavigationRequest(const QUrl& url, NavigationType type, bool
 	if (url.scheme() == QLatin1String("abp") && ADB::Manager::instance()->addSubscriptionFromUrl(url))
 		return false;
 
+	// A click older than a few seconds didn't start this navigation
+	if (type == NavigationTypeLinkClicked && m_clickTimer.isValid()) {
+		if (m_clickTimer.elapsed() < 5 * 1000)
+			Metrics::record(Metrics::LinkClickNavigation, m_clickTimer.nsecsElapsed());
+
+		m_clickTimer.invalidate();
+	}
+
 	return Engine::WebPage::acceptNavigationRequest(url, type, isMainFrame);
 }
 
 Engine::WebPage* WebPage::createNewWindow(Engine::WebPage::WebWindowType type)
 {
+	if (m_prerendering)
+		return nullptr;
+
 	TabbedWebView* tabbedWebView = qobject_cast<TabbedWebView*>(view());
 	BrowserWindow* window = tabbedWebView ? tabbedWebView->webTab()->tabWidget()->window() : Application::instance()->getWindow();
 
@@ -389,12 +483,9 @@ Engine::WebPage* WebPage::createNewWindow(Engine::WebPage::WebWindowType type)
 
 void WebPage::handleUnknowProtocol(const QUrl& url)
 {
-	Settings settings{};
-
 	const QString protocol = url.scheme();
-	QStringList
-		autoOpenProtocols{settings.value("Web-Settings/AutomaticallyOpenProtocols", QStringList()).toStringList()};
-	QStringList blockedProtocols{settings.value("Web-Settings/BlockedProtocols", QStringList()).toStringList()};
+	QStringList autoOpenProtocols{SettingsSnapshot::current()->automaticallyOpenProtocols};
+	QStringList blockedProtocols{SettingsSnapshot::current()->blockedProtocols};
 
 	if (protocol == QLatin1String("mailto")) {
 		desktopServiceOpen(url);
@@ -422,7 +513,10 @@ void WebPage::handleUnknowProtocol(const QUrl& url)
 	case QDialog::Accepted:
 		if (dialog.isChecked()) {
 			autoOpenProtocols.append(protocol);
+
+			Settings settings{};
 			settings.setValue("Web-Settings/AutomaticallyOpenProtocols", autoOpenProtocols);
+			SettingsSnapshot::rebuild();
 		}
 
 		QDesktopServices::openUrl(url);
@@ -430,7 +524,10 @@ void WebPage::handleUnknowProtocol(const QUrl& url)
 	case QDialog::Rejected:
 		if (dialog.isChecked()) {
 			blockedProtocols.append(protocol);
+
+			Settings settings{};
 			settings.setValue("Web-Settings/BlockedProtocols", blockedProtocols);
+			SettingsSnapshot::rebuild();
 		}
 	default:
 		break;
@@ -35,6 +35,10 @@
 #include <QVariant>
 
 #include <QEventLoop>
+#include <QElapsedTimer>
+#include <QRectF>
+
+#include <functional>
 
 #include "Password/PasswordManager.hpp"
 
@@ -60,11 +64,26 @@ public:
 
 	QPointF mapToViewport(const QPointF& pos) const;
 	WebHitTestResult hitTestContent(const QPoint& pos) const;
+	void hitTestContent(const QPoint& pos, const std::function<void(const WebHitTestResult&)>& callback);
+
+	// Link under the mouse, known without asking the renderer
+	QUrl linkUrlAt(const QPoint& pos) const;
+	void setReportedHoveredLink(const QUrl& url, const QRectF& rect);
+
+	// Starts measuring the delay until the navigation request of a clicked link
+	void startClickTimer();
 
 	void scroll(int x, int y);
 	void setScrollPosition(const QPointF& pos);
 
+	// A prerendered page loads without view and is muted, it can't open dialogs or windows until it is shown
+	bool isPrerendering() const { return m_prerendering; }
+	void setPrerendering(bool prerendering);
+
 	void javaScriptAlert(const QUrl& securityOrigin, const QString& msg) override;
+	bool javaScriptConfirm(const QUrl& securityOrigin, const QString& msg) override;
+	bool javaScriptPrompt(const QUrl& securityOrigin, const QString& msg, const QString& defaultValue,
+						  QString* result) override;
 	
 	bool isRunningLoop();
 
@@ -99,10 +118,16 @@ private:
 	DelayedFileWatcher* m_fileWatcher{nullptr};
 	QEventLoop* m_runningLoop{nullptr};
 
+	QUrl m_hoveredLink{};
+	QUrl m_reportedLink{};
+	QRectF m_reportedLinkRect{};
+	QElapsedTimer m_clickTimer{};
+
 	QVector<PasswordEntry> m_passwordEntries;
 
 	int m_loadProgress{-1};
 	bool m_blockAlerts{false};
+	bool m_prerendering{false};
 	bool m_secureStatus{false};
 	bool m_adjustingSheduled{false};
 
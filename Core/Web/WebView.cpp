@@ -41,7 +41,7 @@
 #include "Web/WebInspector.hpp"
 #include "Web/Scripts.hpp"
 
-#include "Utils/Settings.hpp"
+#include "Utils/SettingsSnapshot.hpp"
 
 #include "History/History.hpp"
 
@@ -102,8 +102,7 @@ WebView::WebView(QWidget* parent) :
 	connect(this, &Engine::WebView::titleChanged, this, &WebView::sTitleChanged);
 	connect(this, &Engine::WebView::iconChanged, this, &WebView::sIconChanged);
 
-	Settings settings{};
-	m_currentZoomLevel = settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt();
+	m_currentZoomLevel = SettingsSnapshot::current()->defaultZoomLevel;
 
 	setAcceptDrops(true);
 
@@ -163,6 +162,7 @@ void WebView::setPage(WebPage* page)
 		}
 
 		Application::instance()->plugins()->emitWebPageDeleted(m_page);
+		m_page->disconnect(this);
 		m_page->setView(nullptr);
 		m_page->deleteLater();
 	}
@@ -176,8 +176,8 @@ void WebView::setPage(WebPage* page)
 		emit loadProgress(m_page->m_loadProgress);
 	}
 
-	connect(m_page, &WebPage::privacyChanged, this, &WebView::privacyChanged);
-	connect(m_page, &WebPage::pageRendering, this, &WebView::pageRendering);
+	connect(m_page, &WebPage::privacyChanged, this, &WebView::privacyChanged, Qt::UniqueConnection);
+	connect(m_page, &WebPage::pageRendering, this, &WebView::pageRendering, Qt::UniqueConnection);
 
 	zoomReset();
 	initActions();
@@ -323,8 +323,7 @@ void WebView::zoomOut()
 
 void WebView::zoomReset()
 {
-	Settings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", zoomLevels().indexOf(100)).toInt()};
+	const int defaultZoomLevel{SettingsSnapshot::current()->defaultZoomLevel};
 
 	if (m_currentZoomLevel != defaultZoomLevel) {
 		m_currentZoomLevel = defaultZoomLevel;
@@ -338,6 +337,7 @@ void WebView::back()
 	Engine::WebHistory* history = m_page->history();
 
 	if (history->canGoBack()) {
+		emit aboutToNavigateHistory(history->backUrl());
 		history->back();
 
 		emit urlChanged(url());
@@ -349,6 +349,7 @@ void WebView::forward()
 	Engine::WebHistory* history = m_page->history();
 
 	if (history->canGoForward()) {
+		emit aboutToNavigateHistory(history->forwardUrl());
 		history->forward();
 
 		emit urlChanged(url());
@@ -567,12 +568,13 @@ void WebView::newMousePressEvent(QMouseEvent* event)
 		event->accept();
 		break;
 	case Qt::MiddleButton:
-		m_clickedUrl = m_page->hitTestContent(event->pos()).linkUrl();
+		m_clickedUrl = m_page->linkUrlAt(event->pos());
 		if (!m_clickedUrl.isEmpty())
 			event->accept();
 		break;
 	case Qt::LeftButton:
-		m_clickedUrl = m_page->hitTestContent(event->pos()).linkUrl();
+		m_page->startClickTimer();
+		m_clickedUrl = m_page->linkUrlAt(event->pos());
 		break;
 	default:
 		break;
@@ -589,7 +591,7 @@ void WebView::newMouseReleaseEvent(QMouseEvent* event)
 	switch (event->button()) {
 	case Qt::MiddleButton:
 		if (!m_clickedUrl.isEmpty()) {
-			const QUrl newUrl{m_page->hitTestContent(event->pos()).linkUrl()};
+			const QUrl newUrl{m_page->linkUrlAt(event->pos())};
 
 			if (m_clickedUrl == newUrl && isUrlValide(newUrl)) {
 				if (event->modifiers() & Qt::ShiftModifier)
@@ -603,7 +605,7 @@ void WebView::newMouseReleaseEvent(QMouseEvent* event)
 		break;
 	case Qt::LeftButton:
 		if (!m_clickedUrl.isEmpty()) {
-			const QUrl newUrl{m_page->hitTestContent(event->pos()).linkUrl()};
+			const QUrl newUrl{m_page->linkUrlAt(event->pos())};
 
 			if ((m_clickedUrl == newUrl && isUrlValide(newUrl)) && event->modifiers() & Qt::ControlModifier) {
 				if (event->modifiers() & Qt::ShiftModifier)
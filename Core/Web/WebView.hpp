@@ -99,6 +99,8 @@ signals:
 	void zoomLevelChanged(int);
 	void showNotification(QWidget*);
 	void backgroundActivityChanged(bool);
+	// Emitted before going back or forward, while the current page is still shown
+	void aboutToNavigateHistory(const QUrl& url);
 
 public slots:
 	void zoomIn();
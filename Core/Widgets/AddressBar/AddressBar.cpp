@@ -46,6 +46,8 @@
 
 #include "History/HistoryItem.hpp"
 
+#include "Network/SpeculativeLoader.hpp"
+
 #include "Web/LoadRequest.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
 #include "Web/Tab/WebTab.hpp"
@@ -201,6 +203,8 @@ void AddressBar::textEdited(const QString& text)
 	m_oldTextLength = m_currentTextLength;
 	m_currentTextLength = text.length();
 
+	Application::instance()->speculativeLoader()->textChanged(text);
+
 	if (!text.isEmpty())
 		m_completer->complete(text);
 	else
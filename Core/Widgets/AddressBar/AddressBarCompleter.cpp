@@ -36,6 +36,9 @@
 
 #include "History/History.hpp"
 
+#include "Network/HostInfoCache.hpp"
+#include "Network/SpeculativeLoader.hpp"
+
 #include "Web/Tab/TabbedWebView.hpp"
 
 #include "Widgets/Tab/TabWidget.hpp"
@@ -99,6 +102,35 @@ void AddressBarCompleter::showMostVisited()
 	complete(QString());
 }
 
+void AddressBarCompleter::predictNavigation()
+{
+	QUrl topUrl{};
+	int topCount{0};
+	int totalCount{0};
+
+	for (int i{0}; i < s_model->rowCount(); ++i) {
+		const QModelIndex index{s_model->index(i, 0)};
+
+		if (index.data(AddressBarCompleterModel::VisitSearchItemRole).toBool())
+			continue;
+
+		const int count{index.data(AddressBarCompleterModel::CountRole).toInt()};
+
+		if (topUrl.isEmpty()) {
+			topUrl = index.data(AddressBarCompleterModel::UrlRole).toUrl();
+			topCount = count;
+		}
+
+		totalCount += count;
+	}
+
+	if (topUrl.isEmpty() || topCount <= 0)
+		return;
+
+	// Share of the visits going to the top suggestion, a page visited only a few times can't be very likely
+	Application::instance()->speculativeLoader()->predict(topUrl, static_cast<double>(topCount) / (totalCount + 1));
+}
+
 void AddressBarCompleter::refreshJobFinished()
 {
 	AddressBarCompleterRefreshJob* job = qobject_cast<AddressBarCompleterRefreshJob*>(sender());
@@ -120,6 +152,18 @@ void AddressBarCompleter::refreshJobFinished()
 
 		emit showDomainCompletion(job->domainCompletion());
 
+		// The top completions are the most likely to be opened, their host is resolved ahead of time
+		for (int i{0}; i < qMin(2, s_model->rowCount()); ++i) {
+			const QModelIndex index{s_model->index(i, 0)};
+
+			if (!index.data(AddressBarCompleterModel::VisitSearchItemRole).toBool())
+				Application::instance()->hostInfoCache()->prefetch(
+					index.data(AddressBarCompleterModel::UrlRole).toUrl().host());
+		}
+
+		if (!job->searchString().isEmpty())
+			predictNavigation();
+
 		m_originalText = m_addressBar->text();
 		s_view->setOriginalText(m_originalText);
 	}
@@ -76,6 +76,7 @@ private slots:
 private:
 	void switchToTab(TabWidget* tabWidget, int tab);
 	void loadString(const QString& url);
+	void predictNavigation();
 
 	void showPopup();
 	void adjustPopupSize();
@@ -28,8 +28,6 @@
 
 #include "Application.hpp"
 
-#include "Utils/Settings.hpp"
-
 #include "Web/HTML5Permissions/HTML5PermissionsManager.hpp"
 
 namespace Sn {
@@ -105,6 +103,8 @@ void HTML5PermissionsDialog::removeEntry()
 	else
 		m_denied[currentFeature()].removeOne(origin);
 
+	m_removed.append(qMakePair(currentFeature(), origin));
+
 	delete item;
 }
 
@@ -115,31 +115,12 @@ void HTML5PermissionsDialog::featureIndexChanged()
 
 void HTML5PermissionsDialog::saveSettings()
 {
-	Settings settings{};
-
-	settings.beginGroup("HTML5-Permissions");
-
-	settings.setValue("NotificationsGranted", m_granted[Engine::WebPage::Notifications]);
-	settings.setValue("NotificationDenied", m_denied[Engine::WebPage::Notifications]);
-
-	settings.setValue("GeoLocationGranted", m_granted[Engine::WebPage::Geolocation]);
-	settings.setValue("GeoLocationDenied", m_denied[Engine::WebPage::Geolocation]);
-
-	settings.setValue("MediaAudioCaptureGranted", m_granted[Engine::WebPage::MediaAudioCapture]);
-	settings.setValue("MediaAudioCaptureDenied", m_denied[Engine::WebPage::MediaAudioCapture]);
-
-	settings.setValue("MediaVideoCaptureGranted", m_granted[Engine::WebPage::MediaVideoCapture]);
-	settings.setValue("MediaVideoCaptureDenied", m_denied[Engine::WebPage::MediaVideoCapture]);
-
-	settings.setValue("MediaAudioVideoCaptureGranted", m_granted[Engine::WebPage::MediaAudioVideoCapture]);
-	settings.setValue("MediaAudioVideoCaptureDenied", m_denied[Engine::WebPage::MediaAudioVideoCapture]);
-
-	settings.setValue("MouseLockGranted", m_granted[Engine::WebPage::MouseLock]);
-	settings.setValue("MouseLockDenied", m_denied[Engine::WebPage::MouseLock]);
+	HTML5PermissionsManager* manager{Application::instance()->permissionsManager()};
 
-	settings.endGroup();
+	for (const auto& removed : m_removed)
+		manager->forgetPermissions(QUrl(removed.second), removed.first);
 
-	Application::instance()->permissionsManager()->loadSettings();
+	m_removed.clear();
 }
 
 void HTML5PermissionsDialog::setupUI()
@@ -198,35 +179,21 @@ void HTML5PermissionsDialog::setupUI()
 
 void HTML5PermissionsDialog::loadSettings()
 {
-	Settings settings{};
-
-	settings.beginGroup("HTML5-Permissions");
-
-	m_granted[Engine::WebPage::Notifications] = settings.value("NotificationsGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::Notifications] = settings.value("NotificationDenied", QStringList()).toStringList();
-
-	m_granted[Engine::WebPage::Geolocation] = settings.value("GeoLocationGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::Geolocation] = settings.value("GeoLocationDenied", QStringList()).toStringList();
-
-	m_granted[Engine::WebPage::MediaAudioCapture] =
-		settings.value("MediaAudioCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaAudioCapture] =
-		settings.value("MediaAudioCaptureDenied", QStringList()).toStringList();
-
-	m_granted[Engine::WebPage::MediaVideoCapture] =
-		settings.value("MediaVideoCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaVideoCapture] =
-		settings.value("MediaVideoCaptureDenied", QStringList()).toStringList();
-
-	m_granted[Engine::WebPage::MediaAudioVideoCapture] =
-		settings.value("MediaAudioVideoCaptureGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MediaAudioVideoCapture] =
-		settings.value("MediaAudioVideoCaptureDenied", QStringList()).toStringList();
-
-	m_granted[Engine::WebPage::MouseLock] = settings.value("MouseLockGranted", QStringList()).toStringList();
-	m_denied[Engine::WebPage::MouseLock] = settings.value("MouseLockDenied", QStringList()).toStringList();
-
-	settings.endGroup();
+	HTML5PermissionsManager* manager{Application::instance()->permissionsManager()};
+
+	const QList<Engine::WebPage::Feature> features{
+		Engine::WebPage::Notifications,
+		Engine::WebPage::Geolocation,
+		Engine::WebPage::MediaAudioCapture,
+		Engine::WebPage::MediaVideoCapture,
+		Engine::WebPage::MediaAudioVideoCapture,
+		Engine::WebPage::MouseLock
+	};
+
+	foreach (Engine::WebPage::Feature feature, features) {
+		m_granted[feature] = manager->origins(feature, Engine::WebPage::PermissionGrantedByUser);
+		m_denied[feature] = manager->origins(feature, Engine::WebPage::PermissionDeniedByUser);
+	}
 }
 
 Engine::WebPage::Feature HTML5PermissionsDialog::currentFeature() const
@@ -32,6 +32,8 @@
 #include <QWidget>
 
 #include <QHash>
+#include <QList>
+#include <QPair>
 #include <QStringList>
 
 #include <QGridLayout>
@@ -84,6 +86,7 @@ private:
 
 	QHash<Engine::WebPage::Feature, QStringList> m_granted{};
 	QHash<Engine::WebPage::Feature, QStringList> m_denied{};
+	QList<QPair<Engine::WebPage::Feature, QString>> m_removed{};
 };
 
 }
@@ -51,6 +51,7 @@
 #include "Widgets/SiteInfo.hpp"
 #include "Widgets/PartnerDialog.hpp"
 #include "Widgets/Preferences/PreferencesDialog.hpp"
+#include "Widgets/TaskManager.hpp"
 #include "Widgets/Tab/TabWidget.hpp"
 
 #include "Web/Tab/TabbedWebView.hpp"
@@ -146,6 +147,8 @@ MainMenu::MainMenu(TabWidget* tabWidget, QWidget* parent) :
 	QAction
 		* showCookiesManagerAction = createAction("ShowCookiesManager", m_toolsMenu, QIcon(),
 		                                          tr("&Cookies Manager"));
+	QAction* showTaskManagerAction =
+		createAction("ShowTaskManager", m_toolsMenu, QIcon(), tr("&Task Manager"), "Shift+Esc");
 	m_toolsMenu->addMenu(m_pluginsMenu);
 	addSeparator();
 	QAction* showSettingsAction = createAction("ShowSettings",
@@ -187,6 +190,7 @@ MainMenu::MainMenu(TabWidget* tabWidget, QWidget* parent) :
 	connect(showSiteInfoAction, &QAction::triggered, this, &MainMenu::showSiteInfo);
 	connect(showDownloadManagerAction, &QAction::triggered, this, &MainMenu::showDownloadManager);
 	connect(showCookiesManagerAction, &QAction::triggered, this, &MainMenu::showCookiesManager);
+	connect(showTaskManagerAction, &QAction::triggered, this, &MainMenu::showTaskManager);
 
 	connect(showSettingsAction, &QAction::triggered, this, &MainMenu::showSettings);
 	connect(showAboutSieloAction, &QAction::triggered, this, &MainMenu::showAboutSielo);
@@ -453,6 +457,18 @@ void MainMenu::showCookiesManager()
 	dialog->show();
 }
 
+void MainMenu::showTaskManager()
+{
+	static QPointer<TaskManager> taskManager{};
+
+	if (!taskManager)
+		taskManager = new TaskManager();
+
+	taskManager->show();
+	taskManager->raise();
+	taskManager->activateWindow();
+}
+
 void MainMenu::showSiteInfo()
 {
 	if (m_tabWidget && SiteInfo::canShowSiteInfo(m_tabWidget->webTab()->url())) {
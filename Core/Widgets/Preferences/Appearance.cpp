@@ -24,9 +24,6 @@
 
 #include "Widgets/Preferences/Appearance.hpp"
 
-#include <QProcess>
-#include <QTimer>
-
 #include <QMessageBox>
 #include <QColorDialog>
 #include <QFileDialog>
@@ -36,7 +33,9 @@
 
 #include "Utils/RegExp.hpp"
 #include "Utils/DataPaths.hpp"
+#include "Utils/InitScheduler.hpp"
 #include "Utils/Settings.hpp"
+#include "Utils/ThemePackage.hpp"
 
 #include "Widgets/Preferences/PreferencesDialog.hpp"
 
@@ -207,48 +206,36 @@ void AppearancePage::openGallery()
 
 void AppearancePage::addTheme()
 {
-#if defined(Q_OS_WIN)
-	QString compilerName = "sielo-compiler.exe";
-#else
-	QString compilerName = "sielo-compiler";
-#endif
-	if (!QFile(QDir(QCoreApplication::applicationDirPath()).absolutePath() + QLatin1Char('/') + compilerName)
-		.exists()) {
-		QMessageBox::critical(this,
-		                      tr("Error"),
-		                      tr(
-			                      "Can't decompile theme... Be sure compiler is with Sielo main exe, else move it manually or update/reinstall the browser."));
-		return;
-	}
-
 	QString themeFile{QFileDialog::getOpenFileName(this, tr("Open a theme"), QString(), "Themes (*.snthm)")};
 
 	if (themeFile.isEmpty())
 		return;
 
-	QFileInfo themeInfo{
-		DataPaths::currentProfilePath() + "/themes/" + QLatin1Char('/')
-		+ QFileInfo(themeFile).baseName()
-		+ QLatin1String("/main.sss")
-	};
+	// The package is read in place, sielo-compiler is not needed anymore to install a theme
+	ThemePackage package{themeFile};
+
+	if (!package.open() || !package.contains(QLatin1String("main.sss"))) {
+		QMessageBox::critical(this, tr("Error"), tr("Can't decompile theme... ") + package.errorString());
+		return;
+	}
 
-	if (themeInfo.exists()) {
+	const QString themePath{DataPaths::currentProfilePath() + "/themes/" + QFileInfo(themeFile).baseName()};
+
+	if (QFileInfo::exists(themePath + QLatin1String("/main.sss"))) {
 		QMessageBox::warning(this,
 		                     tr("Theme exist"),
 		                     tr("The theme already exist and is going to be update with the new version."));
-		QDir(DataPaths::currentProfilePath() + "/themes/" + QLatin1Char('/') + QFileInfo(themeFile).baseName())
-			.removeRecursively();
+		QDir(themePath).removeRecursively();
 	}
 
-	QStringList decompileArgs{};
-	decompileArgs << "decompile" << themeFile
-		<< DataPaths::currentProfilePath() + "/themes/" + QLatin1Char('/')
-		+ QFileInfo(themeFile).baseName() << "Theme successfully decompiled";
+	if (!package.extract(themePath)) {
+		QMessageBox::critical(this, tr("Error"), tr("Can't decompile theme... ") + package.errorString());
+		return;
+	}
 
-	QProcess::execute(QDir(QCoreApplication::applicationDirPath()).absolutePath() + QLatin1Char('/') + compilerName,
-	                  decompileArgs);
+	QMessageBox::information(this, tr("Success"), tr("Theme successfully decompiled"));
 
-	QTimer::singleShot(500, this, &AppearancePage::loadSettings);
+	loadSettings();
 }
 
 void AppearancePage::getColor()
@@ -368,6 +355,9 @@ void AppearancePage::loadSettings()
 
 	m_themeList->clear();
 
+	// Bundled themes may still be extracted by a deferred task
+	Application::instance()->initScheduler()->waitFor(QStringLiteral("Theme extraction"));
+
 	QDir dir{DataPaths::currentProfilePath() + "/themes"};
 	QStringList list = dir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
 
@@ -76,6 +76,8 @@ void DownloadPage::loadSettings()
 		m_choosePath->setEnabled(true);
 	}
 
+	m_segmentedDownloads->setChecked(settings.value(QLatin1String("segmentedDownloads"), false).toBool());
+
 	settings.endGroup();
 }
 
@@ -87,6 +89,7 @@ void DownloadPage::save()
 
 	settings.setValue(QLatin1String("downloadDirectory"), m_path->text());
 	settings.setValue(QLatin1String("alwaysAsk"), m_radioAlwaysAsk->isChecked());
+	settings.setValue(QLatin1String("segmentedDownloads"), m_segmentedDownloads->isChecked());
 
 	settings.endGroup();
 }
@@ -128,6 +131,8 @@ void DownloadPage::setupUI()
 
 	m_choosePath = new QPushButton(tr("..."), this);
 
+	m_segmentedDownloads = new QCheckBox(tr("Download big files with several connections"), this);
+
 	m_spacer = new QSpacerItem(20, 40, QSizePolicy::Minimum, QSizePolicy::Expanding);
 
 	m_layoutPath->addWidget(m_path);
@@ -136,6 +141,7 @@ void DownloadPage::setupUI()
 	m_layout->addWidget(m_radioAlwaysAsk);
 	m_layout->addWidget(m_radioCustomPath);
 	m_layout->addLayout(m_layoutPath);
+	m_layout->addWidget(m_segmentedDownloads);
 	m_layout->addItem(m_spacer);
 }
 
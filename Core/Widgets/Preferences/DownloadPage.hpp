@@ -37,6 +37,7 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QSpacerItem>
+#include <QCheckBox>
 
 namespace Sn {
 
@@ -65,6 +66,7 @@ private:
 	QRadioButton* m_radioCustomPath{nullptr};
 	QLineEdit* m_path{nullptr};
 	QPushButton* m_choosePath{nullptr};
+	QCheckBox* m_segmentedDownloads{nullptr};
 	QSpacerItem* m_spacer{nullptr};
 };
 
@@ -58,6 +58,9 @@ void WebConfigPage::loadSettings()
 	m_enableXSS->setChecked(settings.value("XSSAuditing", false).toBool());
 	m_animatedScrolling->setChecked(settings.value("animateScrolling", true).toBool());
 	m_enableSpacialAnimation->setChecked(settings.value("spatialNavigation", false).toBool());
+	m_dnsPrefetch->setChecked(settings.value("dnsPrefetch", false).toBool());
+	m_speculativeLoading->setChecked(settings.value("speculativeLoading", true).toBool());
+	m_speculativePrerender->setChecked(settings.value("speculativePrerender", false).toBool());
 
 	m_wheelSpin->setValue(settings.value("wheelScrollLines", Application::instance()->wheelScrollLines()).toInt());
 
@@ -80,6 +83,9 @@ void WebConfigPage::save()
 	settings.setValue("XSSAuditing", m_enableXSS->isChecked());
 	settings.setValue("animateScrolling", m_animatedScrolling->isChecked());
 	settings.setValue("spatialNavigation", m_enableSpacialAnimation->isChecked());
+	settings.setValue("dnsPrefetch", m_dnsPrefetch->isChecked());
+	settings.setValue("speculativeLoading", m_speculativeLoading->isChecked());
+	settings.setValue("speculativePrerender", m_speculativePrerender->isChecked());
 
 	settings.setValue("wheelScrollLines", m_wheelSpin->value());
 
@@ -100,6 +106,9 @@ void WebConfigPage::setupUI()
 	m_enableXSS = new QCheckBox(tr("Enable XSS Auditing"), this);
 	m_animatedScrolling = new QCheckBox(tr("Animated scrolling"), this);
 	m_enableSpacialAnimation = new QCheckBox(tr("Enable spatial navigation"), this);
+	m_dnsPrefetch = new QCheckBox(tr("Resolve addresses of hovered links and suggestions in advance"), this);
+	m_speculativeLoading = new QCheckBox(tr("Prepare the most likely address bar suggestion while typing"), this);
+	m_speculativePrerender = new QCheckBox(tr("Load the most likely address bar suggestion in the background"), this);
 
 	m_line1 = new QFrame(this);
 	m_line1->setFrameShape(QFrame::HLine);
@@ -131,6 +140,9 @@ void WebConfigPage::setupUI()
 	m_layout->addWidget(m_enableXSS);
 	m_layout->addWidget(m_animatedScrolling);
 	m_layout->addWidget(m_enableSpacialAnimation);
+	m_layout->addWidget(m_dnsPrefetch);
+	m_layout->addWidget(m_speculativeLoading);
+	m_layout->addWidget(m_speculativePrerender);
 	m_layout->addWidget(m_line1);
 	m_layout->addLayout(m_wheelLayout);
 	m_layout->addWidget(m_line2);
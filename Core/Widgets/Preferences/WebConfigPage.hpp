@@ -66,6 +66,9 @@ private:
 	QCheckBox* m_enableXSS{nullptr};
 	QCheckBox* m_animatedScrolling{nullptr};
 	QCheckBox* m_enableSpacialAnimation{nullptr};
+	QCheckBox* m_dnsPrefetch{nullptr};
+	QCheckBox* m_speculativeLoading{nullptr};
+	QCheckBox* m_speculativePrerender{nullptr};
 
 	QFrame* m_line1{nullptr};
 
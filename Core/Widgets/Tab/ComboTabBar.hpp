@@ -117,7 +117,7 @@ public:
 	QString tabText(int index) const;
 	void setTabText(int index, const QString& text);
 
-	QString tabToolTip(int index) const;
+	virtual QString tabToolTip(int index) const;
 	void setTabToolTip(int index, const QString& tip);
 
 	bool tabsClosable() const;
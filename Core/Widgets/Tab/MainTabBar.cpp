@@ -35,6 +35,9 @@
 #include <QAbstractButton>
 #include <QMessageBox>
 
+#include <algorithm>
+#include <iterator>
+
 #include "BrowserWindow.hpp"
 #include "Application.hpp"
 
@@ -51,6 +54,7 @@
 #include "Widgets/Tab/TabCloseButton.hpp"
 #include "Widgets/Tab/TabBar.hpp"
 #include "Widgets/Tab/TabContextMenu.hpp"
+#include "Widgets/TaskManager.hpp"
 
 
 namespace Sn {
@@ -108,6 +112,8 @@ void MainTabBar::loadSettings()
 
 	settings.endGroup();
 
+	m_tabSizeHints.clear();
+
 	setSelectionBehaviorOnRemove(activateLastTab ? QTabBar::SelectPreviousTab : QTabBar::SelectRightTab);
 	setVisible(!(count() <= 1 && m_hideTabBarWithOneTab));
 
@@ -159,9 +165,23 @@ void MainTabBar::setTabText(int index, const QString& text)
 	}
 
 	setTabToolTip(index, text);
+
+	if (tabText != ComboTabBar::tabText(index))
+		m_tabSizeHints.clear();
+
 	ComboTabBar::setTabText(index, tabText);
 }
 
+QString MainTabBar::tabToolTip(int index) const
+{
+	const QString usage{TaskManager::tabUsageSummary(webTab(index))};
+
+	if (usage.isEmpty())
+		return ComboTabBar::tabToolTip(index);
+
+	return ComboTabBar::tabToolTip(index) + QLatin1Char('\n') + usage;
+}
+
 void MainTabBar::wheelEvent(QWheelEvent* event)
 {
 	if (Application::instance()->plugins()->processWheelEvent(Application::ON_TabBar, this, event))
@@ -222,6 +242,8 @@ void MainTabBar::tabInserted(int index)
 {
 	Q_UNUSED(index);
 
+	m_tabSizeHints.clear();
+
 	if (tabMetrics()->pinnedWidth() == 1) {
 		QTimer::singleShot(0, this, [this]()
 		{
@@ -247,6 +269,8 @@ void MainTabBar::tabRemoved(int index)
 {
 	Q_UNUSED(index);
 
+	m_tabSizeHints.clear();
+
 	showCloseButton(currentIndex());
 	setVisible(!(count() <= 1 && m_hideTabBarWithOneTab));
 
@@ -680,14 +704,70 @@ MainTabBar::TabDropAction MainTabBar::tabDropAction(const QPoint& pos, const QRe
 		return AppendTab;
 }
 
-QSize MainTabBar::tabSizeHint(int index, bool fast) const
+void MainTabBar::changeEvent(QEvent* event)
 {
-	int cout = normalTabsCount();
+	if (event->type() == QEvent::StyleChange || event->type() == QEvent::FontChange)
+		m_tabSizeHints.clear();
 
-	if (!m_tabWidget->isVisible()) {
+	ComboTabBar::changeEvent(event);
+}
+
+bool MainTabBar::TabSizeHintKey::operator==(const TabSizeHintKey& other) const
+{
+	return availableWidth == other.availableWidth && count == other.count && pinnedCount == other.pinnedCount
+		   && currentIndex == other.currentIndex && cornerWidth == other.cornerWidth && closable == other.closable
+		   && fast == other.fast
+		   && std::equal(std::begin(metrics), std::end(metrics), std::begin(other.metrics));
+}
+
+/*
+ * The tab bars ask the size hint of every tab each time they lay out their tabs, and the width of a tab depends on the
+ * whole bar. Hints are cached until the bar size, the tab count, the current tab or the metrics change.
+ */
+QSize MainTabBar::tabSizeHint(int index, bool fast) const
+{
+	if (!m_tabWidget->isVisible())
 		return QSize(-1, -1);
+
+	TabSizeHintKey key{};
+	key.availableWidth = mainTabBarWidth() - comboTabBarPixelMetric(ExtraReservedWidth);
+	key.count = count();
+	key.pinnedCount = pinnedTabsCount();
+	key.currentIndex = mainTabBarCurentIndex();
+	key.cornerWidth = cornerWidth(Qt::TopLeftCorner) + pinTabBarWidth();
+	key.metrics[0] = tabMetrics()->normalMaxWidth();
+	key.metrics[1] = tabMetrics()->normalMinWidth();
+	key.metrics[2] = tabMetrics()->activeMinWidth();
+	key.metrics[3] = tabMetrics()->overflowedWidth();
+	key.metrics[4] = tabMetrics()->pinnedWidth();
+	key.closable = tabsClosable();
+	key.fast = fast;
+
+	if (!(key == m_tabSizeHintKey) || m_tabSizeHints.count() != key.count) {
+		m_tabSizeHintKey = key;
+		m_tabSizeHints.fill(QSize(), key.count);
 	}
 
+	QSize size{};
+
+	if (index >= 0 && index < m_tabSizeHints.count() && m_tabSizeHints[index].isValid())
+		size = m_tabSizeHints[index];
+	else {
+		size = computeTabSizeHint(index, fast);
+
+		// Computing the hint can change the bar (close buttons) and drop the cache
+		if (index >= 0 && index < m_tabSizeHints.count())
+			m_tabSizeHints[index] = size;
+	}
+
+	if (index == count() - 1)
+		updateAddTabButton();
+
+	return size;
+}
+
+QSize MainTabBar::computeTabSizeHint(int index, bool fast) const
+{
 	const int pinnedTabWidth = comboTabBarPixelMetric(ComboTabBar::PinnedTabWidth);
 	const int minTabWidth = comboTabBarPixelMetric(ComboTabBar::NormalTabMinimumWidth);
 
@@ -761,19 +841,20 @@ QSize MainTabBar::tabSizeHint(int index, bool fast) const
 
 	}
 
-	if (index == count() - 1) {
-		WebTab* lastMainActiveTab = qobject_cast<WebTab*>(m_tabWidget->widget(mainTabBarCurentIndex()));
-		int xForAddTabButton{cornerWidth(Qt::TopLeftCorner) + pinTabBarWidth() + normalTabsCount() * m_normalTabWidth};
+	return size;
+}
 
-		if (lastMainActiveTab && m_activeTabWidth > m_normalTabWidth)
-			xForAddTabButton += m_activeTabWidth - m_normalTabWidth;
-		if (QApplication::layoutDirection() == Qt::RightToLeft)
-			xForAddTabButton = width() - xForAddTabButton;
+void MainTabBar::updateAddTabButton() const
+{
+	WebTab* lastMainActiveTab = qobject_cast<WebTab*>(m_tabWidget->widget(mainTabBarCurentIndex()));
+	int xForAddTabButton{cornerWidth(Qt::TopLeftCorner) + pinTabBarWidth() + normalTabsCount() * m_normalTabWidth};
 
-		emit tabBar->moveAddTabButton(xForAddTabButton);
-	}
+	if (lastMainActiveTab && m_activeTabWidth > m_normalTabWidth)
+		xForAddTabButton += m_activeTabWidth - m_normalTabWidth;
+	if (QApplication::layoutDirection() == Qt::RightToLeft)
+		xForAddTabButton = width() - xForAddTabButton;
 
-	return size;
+	emit const_cast<MainTabBar*>(this)->moveAddTabButton(xForAddTabButton);
 }
 
 int MainTabBar::comboTabBarPixelMetric(ComboTabBar::SizeType sizeType) const
@@ -798,7 +879,7 @@ int MainTabBar::comboTabBarPixelMetric(ComboTabBar::SizeType sizeType) const
 	return -1;
 }
 
-WebTab* MainTabBar::webTab(int index)
+WebTab* MainTabBar::webTab(int index) const
 {
 	if (index == -1)
 		return qobject_cast<WebTab*>(m_tabWidget->widget(currentIndex()));
@@ -115,6 +115,7 @@ public:
 	void restoreTabTextColor(int index);
 
 	void setTabText(int index, const QString& text);
+	QString tabToolTip(int index) const override;
 
 	void wheelEvent(QWheelEvent* event);
 
@@ -152,9 +153,13 @@ private:
 
 	TabDropAction tabDropAction(const QPoint& pos, const QRect& tabRect, bool allowSelect) const;
 
+	void changeEvent(QEvent* event) override;
+
 	QSize tabSizeHint(int index, bool fast) const;
+	QSize computeTabSizeHint(int index, bool fast) const;
+	void updateAddTabButton() const;
 	int comboTabBarPixelMetric(ComboTabBar::SizeType sizeType) const;
-	WebTab* webTab(int index = -1);
+	WebTab* webTab(int index = -1) const;
 
 	TabWidget* m_tabWidget{nullptr};
 
@@ -165,6 +170,25 @@ private:
 	mutable int m_normalTabWidth{0};
 	mutable int m_activeTabWidth{0};
 
+	// Everything the width of a tab depends on, the cached size hints are dropped when one of them changes. They are
+	// also dropped when a tab is inserted, removed or renamed, since the text of a tab gives its height and its
+	// overflowed width
+	struct TabSizeHintKey {
+		int availableWidth{-1};
+		int count{-1};
+		int pinnedCount{-1};
+		int currentIndex{-1};
+		int cornerWidth{-1};
+		int metrics[5]{};
+		bool closable{false};
+		bool fast{false};
+
+		bool operator==(const TabSizeHintKey& other) const;
+	};
+
+	mutable TabSizeHintKey m_tabSizeHintKey{};
+	mutable QVector<QSize> m_tabSizeHints{};
+
 	QColor m_originalTabTextColor{};
 	QPoint m_dragStartPosition{};
 
@@ -172,6 +172,23 @@ QPixmap TabBar::tabPixmap(int index) const
 	return out;
 }
 
+int TabBar::findTabAt(const QPoint& position) const
+{
+	const int current{currentIndex()};
+
+	// The current tab is drawn above the tabs it overlaps
+	if (current >= 0 && tabRect(current).contains(position))
+		return current;
+
+	const QPoint logicalPosition{QStyle::visualPos(layoutDirection(), rect(), position)};
+	const int index{firstTabEndingAfter(logicalPosition.x())};
+
+	if (index < count() && logicalTabRect(index).contains(logicalPosition))
+		return index;
+
+	return -1;
+}
+
 void TabBar::setActiveTabBar(bool activate)
 {
 	if (m_activeTabBar != activate) {
@@ -265,8 +282,8 @@ void TabBar::paintEvent(QPaintEvent* event)
 
 	initStyleBaseOption(&optionTabBase, this, size());
 
-	for (int i{0}; i < count(); ++i)
-		optionTabBase.tabBarRect |= tabRect(i);
+	if (count() > 0)
+		optionTabBase.tabBarRect = tabRect(0) | tabRect(count() - 1);
 
 	if (m_activeTabBar)
 		optionTabBase.selectedTabRect = tabRect(selected);
@@ -275,18 +292,26 @@ void TabBar::paintEvent(QPaintEvent* event)
 //		painter.drawPrimitive(QStyle::PE_FrameTabBarBase, optionTabBase);
 
 	const QPoint cursorPos{QCursor::pos()};
-	int indexUnderMouse{isDisplayedOnViewport(cursorPos.x(), cursorPos.x()) ? tabAt(mapFromGlobal(cursorPos)) : -1};
+	int indexUnderMouse{isDisplayedOnViewport(cursorPos.x(), cursorPos.x()) ? findTabAt(mapFromGlobal(cursorPos)) : -1};
+
+	// Only the tabs in the exposed part of the scroll area viewport are painted
+	QRect exposedRect{event->rect()};
+
+	if (m_scrollArea)
+		exposedRect &= QRect(mapFrom(m_scrollArea->viewport(), QPoint(0, 0)), m_scrollArea->viewport()->size());
+
+	const QRect logicalExposedRect{QStyle::visualRect(layoutDirection(), rect(), exposedRect)};
+
+	for (int i{firstTabEndingAfter(logicalExposedRect.left())}; i < count(); ++i) {
+		if (logicalTabRect(i).left() > logicalExposedRect.right())
+			break;
 
-	for (int i{0}; i < count(); ++i) {
 		if (i == selected)
 			continue;
 
 		QStyleOptionTab tab{};
 		initStyleOption(&tab, i);
 
-		if (!isDisplayedOnViewport(mapToGlobal(tab.rect.topLeft()).x(), mapToGlobal(tab.rect.topRight()).x()))
-			continue;
-
 		if (!m_activeTabBar)
 			tab.selectedPosition = QStyleOptionTab::NotAdjacent;
 
@@ -385,7 +410,7 @@ void TabBar::mousePressEvent(QMouseEvent* event)
 	event->ignore();
 
 	if (event->button() == Qt::LeftButton) {
-		m_pressedIndex = tabAt(event->pos());
+		m_pressedIndex = findTabAt(event->pos());
 		if (m_pressedIndex != -1) {
 			m_dragStartPosition = event->pos();
 
@@ -487,6 +512,28 @@ int TabBar::dragOffset(QStyleOptionTab* option, int tabIndex) const
 	return button->pos().x() - rect.topLeft().x();
 }
 
+QRect TabBar::logicalTabRect(int index) const
+{
+	return QStyle::visualRect(layoutDirection(), rect(), tabRect(index));
+}
+
+int TabBar::firstTabEndingAfter(int logicalX) const
+{
+	int low{0};
+	int high{count()};
+
+	while (low < high) {
+		const int middle{(low + high) / 2};
+
+		if (logicalTabRect(middle).right() < logicalX)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
 void TabBar::initStyleOption(QStyleOptionTab* option, int tabIndex) const
 {
 	QTabBar::initStyleOption(option, tabIndex);
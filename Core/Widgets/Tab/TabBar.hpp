@@ -50,6 +50,9 @@ public:
 	QRect draggedTabRect() const;
 	QPixmap tabPixmap(int index) const;
 
+	// Same as QTabBar::tabAt, which tests every tab: tabs are laid out in order, so a binary search is enough
+	int findTabAt(const QPoint& position) const;
+
 	ComboTabBar* comboTabBar() const { return m_comboTabBar; };
 
 	bool isActiveTabBar() { return m_activeTabBar; }
@@ -79,6 +82,8 @@ private:
 	void mouseReleaseEvent(QMouseEvent* event);
 
 	int dragOffset(QStyleOptionTab* option, int tabIndex) const;
+	QRect logicalTabRect(int index) const;
+	int firstTabEndingAfter(int logicalX) const;
 	void initStyleOption(QStyleOptionTab* option, int tabIndex) const;
 
 	ComboTabBar* m_comboTabBar{nullptr};
@@ -34,6 +34,7 @@
 
 #include "Utils/ToolButton.hpp"
 
+#include "Widgets/Tab/TabBar.hpp"
 #include "Widgets/Tab/TabScrollBar.hpp"
 
 #include "Application.hpp"
@@ -169,7 +170,12 @@ int TabBarScrollWidget::tabAt(const QPoint& position) const
 		&& (m_leftScrollButton->rect().contains(position) || m_rightScrollButton->rect().contains(position)))
 		return -1;
 
-	return m_tabBar->tabAt(m_tabBar->mapFromGlobal(mapToGlobal(position)));
+	const QPoint tabBarPosition{m_tabBar->mapFromGlobal(mapToGlobal(position))};
+
+	if (TabBar* tabBar = qobject_cast<TabBar*>(m_tabBar))
+		return tabBar->findTabAt(tabBarPosition);
+
+	return m_tabBar->tabAt(tabBarPosition);
 }
 
 void TabBarScrollWidget::ensureVisible(int index, int xmargin)
@@ -27,6 +27,14 @@
 #include <QPainter>
 #include <QRect>
 
+#include <QDateTime>
+#include <QPointer>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+
+#include <QtMath>
+
 #include "Web/WebPage.hpp"
 #include "Web/WebView.hpp"
 #include "Web/Tab/WebTab.hpp"
@@ -35,13 +43,165 @@
 namespace Sn {
 
 static const int ANIMATION_INTERVAL = 25;
+static const int HIDE_DELAY = 250;
+
+TabIconAnimator* TabIconAnimator::instance()
+{
+	static QPointer<TabIconAnimator> animator{};
+
+	if (!animator)
+		animator = new TabIconAnimator();
+
+	return animator;
+}
+
+TabIconAnimator::TabIconAnimator() :
+	QObject(QCoreApplication::instance()),
+	m_frameTimer(new QTimer(this)),
+	m_hideTimer(new QTimer(this))
+{
+	// Frames are shown on a multiple of the refresh period closest to the animation interval
+	const QScreen* screen{QGuiApplication::primaryScreen()};
+	const qreal refreshPeriod{1000.0 / qMax<qreal>(1.0, screen ? screen->refreshRate() : 60.0)};
+
+	m_frameTimer->setInterval(qRound(refreshPeriod * qCeil(ANIMATION_INTERVAL / refreshPeriod)));
+	m_hideTimer->setSingleShot(true);
+
+	connect(m_frameTimer, &QTimer::timeout, this, &TabIconAnimator::nextFrame);
+	connect(m_hideTimer, &QTimer::timeout, this, &TabIconAnimator::hideExpiredIcons);
+}
+
+void TabIconAnimator::subscribe(TabIcon* icon)
+{
+	m_animatedIcons.insert(icon);
+
+	start();
+}
+
+void TabIconAnimator::unsubscribe(TabIcon* icon)
+{
+	m_animatedIcons.remove(icon);
+
+	if (m_animatedIcons.isEmpty())
+		m_frameTimer->stop();
+}
+
+void TabIconAnimator::scheduleHide(TabIcon* icon)
+{
+	m_hideDeadlines.insert(icon, QDateTime::currentMSecsSinceEpoch() + HIDE_DELAY);
+
+	if (!m_hideTimer->isActive())
+		m_hideTimer->start(HIDE_DELAY);
+}
+
+void TabIconAnimator::cancelHide(TabIcon* icon)
+{
+	m_hideDeadlines.remove(icon);
+}
+
+bool TabIconAnimator::eventFilter(QObject* watched, QEvent* event)
+{
+	switch (event->type()) {
+	case QEvent::Show:
+	case QEvent::WindowStateChange:
+	case QEvent::WindowActivate:
+	case QEvent::Paint: {
+		QWidget* window{qobject_cast<QWidget*>(watched)};
+
+		if (window && m_watchedWindows.contains(window) && !window->isMinimized()) {
+			m_watchedWindows.remove(window);
+			window->removeEventFilter(this);
+
+			start();
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+
+	return QObject::eventFilter(watched, event);
+}
+
+void TabIconAnimator::nextFrame()
+{
+	bool windowOnScreen{false};
+
+	m_currentFrame = (m_currentFrame + 1) % qMax(1, TabIcon::s_data->framesCount);
+
+	// Updates are only posted here, Qt paints all the icons of a window in one pass
+	foreach (TabIcon* icon, m_animatedIcons) {
+		QWidget* window{icon->window()};
+		QWindow* windowHandle{window->windowHandle()};
+
+		if (!window->isVisible() || window->isMinimized() || !windowHandle || !windowHandle->isExposed()) {
+			watchWindow(window);
+			continue;
+		}
+
+		windowOnScreen = true;
+
+		if (isOnScreen(icon))
+			icon->update();
+	}
+
+	// Nothing can be seen, the watched windows restart the animation when they come back
+	if (!windowOnScreen)
+		m_frameTimer->stop();
+}
+
+void TabIconAnimator::hideExpiredIcons()
+{
+	const qint64 now{QDateTime::currentMSecsSinceEpoch()};
+	qint64 nextDeadline{0};
+
+	for (auto it = m_hideDeadlines.begin(); it != m_hideDeadlines.end();) {
+		if (it.value() <= now) {
+			TabIcon* icon{it.key()};
+			it = m_hideDeadlines.erase(it);
+			icon->hide();
+		}
+		else {
+			nextDeadline = nextDeadline == 0 ? it.value() : qMin(nextDeadline, it.value());
+			++it;
+		}
+	}
+
+	if (nextDeadline > 0)
+		m_hideTimer->start(static_cast<int>(nextDeadline - now));
+}
+
+void TabIconAnimator::start()
+{
+	if (!m_animatedIcons.isEmpty() && !m_frameTimer->isActive())
+		m_frameTimer->start();
+}
+
+bool TabIconAnimator::isOnScreen(TabIcon* icon) const
+{
+	return icon->isVisible() && !icon->visibleRegion().isEmpty();
+}
+
+void TabIconAnimator::watchWindow(QWidget* window)
+{
+	if (m_watchedWindows.contains(window))
+		return;
+
+	m_watchedWindows.insert(window);
+	window->installEventFilter(this);
+
+	connect(window, &QObject::destroyed, this, [this, window]()
+	{
+		m_watchedWindows.remove(window);
+	});
+}
 
 TabIcon::Data* TabIcon::s_data = Q_NULLPTR;
 
 TabIcon::TabIcon(QWidget* parent) :
 	QWidget(parent),
 	m_tab(nullptr),
-	m_currentFrame(0),
 	m_animationRunning(false),
 	m_audioIconDisplayed(false)
 {
@@ -62,18 +222,15 @@ TabIcon::TabIcon(QWidget* parent) :
 			Application::getAppIcon("audiomuted", "tabs");
 	}
 
-	m_updateTimer = new QTimer(this);
-	m_updateTimer->setInterval(ANIMATION_INTERVAL);
-
-	m_hideTimer = new QTimer(this);
-	m_hideTimer->setInterval(250);
-
-	connect(m_updateTimer, &QTimer::timeout, this, &TabIcon::updateAnimationFrame);
-	connect(m_hideTimer, &QTimer::timeout, this, &TabIcon::hide);
-
 	resize(16, 16);
 }
 
+TabIcon::~TabIcon()
+{
+	TabIconAnimator::instance()->unsubscribe(this);
+	TabIconAnimator::instance()->cancelHide(this);
+}
+
 void TabIcon::setWebTab(WebTab* tab)
 {
 	m_tab = tab;
@@ -81,7 +238,11 @@ void TabIcon::setWebTab(WebTab* tab)
 	connect(m_tab->webView(), &TabbedWebView::loadStarted, this, &TabIcon::showLoadingAnimation);
 	connect(m_tab->webView(), &TabbedWebView::loadFinished, this, &TabIcon::hideLoadingAnimation);
 	connect(m_tab->webView(), &TabbedWebView::iconChanged, this, &TabIcon::updateIcon);
-	connect(m_tab->webView()->page(), &WebPage::recentlyAudibleChanged, this, &TabIcon::updateAudioIcon);
+	connect(m_tab, &WebTab::playingChanged, this, &TabIcon::updateAudioIcon);
+	connect(m_tab, &WebTab::mutedChanged, this, [this]()
+	{
+		updateAudioIcon(m_tab->isPlaying());
+	});
 
 	updateIcon();
 }
@@ -91,7 +252,7 @@ void TabIcon::updateIcon()
 	m_sitePixmap = m_tab->icon(false).pixmap(16);
 
 	if (m_sitePixmap.isNull())
-		m_hideTimer->start();
+		TabIconAnimator::instance()->scheduleHide(this);
 	else
 		showNormal();
 
@@ -100,9 +261,11 @@ void TabIcon::updateIcon()
 
 void TabIcon::showLoadingAnimation()
 {
-	m_currentFrame = 0;
+	m_animationRunning = true;
+
+	TabIconAnimator::instance()->subscribe(this);
 
-	updateAnimationFrame();
+	update();
 	show();
 }
 
@@ -110,7 +273,7 @@ void TabIcon::hideLoadingAnimation()
 {
 	m_animationRunning = false;
 
-	m_updateTimer->stop();
+	TabIconAnimator::instance()->unsubscribe(this);
 	updateIcon();
 }
 
@@ -130,23 +293,12 @@ void TabIcon::updateAudioIcon(bool recentlyAudible)
 	update();
 }
 
-void TabIcon::updateAnimationFrame()
-{
-	if (!m_animationRunning) {
-		m_updateTimer->start();
-		m_animationRunning = true;
-	}
-
-	update();
-	m_currentFrame = (m_currentFrame + 1) % s_data->framesCount;
-}
-
 void TabIcon::show()
 {
 	if (!shouldBeVisible())
 		return;
 
-	m_hideTimer->stop();
+	TabIconAnimator::instance()->cancelHide(this);
 
 	if (isVisible())
 		return;
@@ -190,7 +342,7 @@ void TabIcon::paintEvent(QPaintEvent* event)
 
 	if (m_animationRunning && !m_tab->application())
 		painter
-			.drawPixmap(r, s_data->animationPixmap, QRect(m_currentFrame * pixmapSize, 0, pixmapSize, pixmapSize));
+			.drawPixmap(r, s_data->animationPixmap, QRect(TabIconAnimator::instance()->currentFrame() * pixmapSize, 0, pixmapSize, pixmapSize));
 	else if (m_audioIconDisplayed)
 		painter.drawPixmap(r,
 						   m_tab->isMuted() ? s_data->audioMutedPixmap.pixmap(16) : s_data->audioPlayingPixmap
@@ -33,18 +33,65 @@
 #include <QIcon>
 
 #include <QTimer>
+#include <QHash>
+#include <QSet>
 
 #include <QPaintEvent>
 #include <QMouseEvent>
 
 namespace Sn {
 class WebTab;
+class TabIcon;
+
+/*
+ * Drives the loading animation of every tab icon with a single timer, ticking on a multiple of the display refresh
+ * period. Only visible icons of windows on screen are repainted; when there is none the timer stops until one of
+ * the windows is shown again. It also hides icons left without pixmap after a short delay.
+ */
+class SIELO_SHAREDLIB TabIconAnimator: public QObject {
+Q_OBJECT
+
+public:
+	static TabIconAnimator* instance();
+
+	int currentFrame() const { return m_currentFrame; }
+
+	void subscribe(TabIcon* icon);
+	void unsubscribe(TabIcon* icon);
+
+	void scheduleHide(TabIcon* icon);
+	void cancelHide(TabIcon* icon);
+
+protected:
+	bool eventFilter(QObject* watched, QEvent* event);
+
+private slots:
+	void nextFrame();
+	void hideExpiredIcons();
+
+private:
+	TabIconAnimator();
+
+	void start();
+	bool isOnScreen(TabIcon* icon) const;
+	void watchWindow(QWidget* window);
+
+	QTimer* m_frameTimer{nullptr};
+	QTimer* m_hideTimer{nullptr};
+
+	QSet<TabIcon*> m_animatedIcons{};
+	QHash<TabIcon*, qint64> m_hideDeadlines{};
+	QSet<QWidget*> m_watchedWindows{};
+
+	int m_currentFrame{0};
+};
 
 class SIELO_SHAREDLIB TabIcon: public QWidget {
 Q_OBJECT
 
 public:
 	TabIcon(QWidget* parent = nullptr);
+	~TabIcon();
 
 	void setWebTab(WebTab* tab);
 	void updateIcon();
@@ -57,7 +104,6 @@ private slots:
 	void hideLoadingAnimation();
 
 	void updateAudioIcon(bool recentlyAudible);
-	void updateAnimationFrame();
 
 private:
 	void show();
@@ -68,11 +114,8 @@ private:
 	void mousePressEvent(QMouseEvent* event);
 
 	WebTab* m_tab{nullptr};
-	QTimer* m_updateTimer{nullptr};
-	QTimer* m_hideTimer{nullptr};
 	QPixmap m_sitePixmap{};
 
-	int m_currentFrame{0};
 	bool m_animationRunning{false};
 	bool m_audioIconDisplayed{false};
 
@@ -84,6 +127,8 @@ private:
 	};
 
 	static Data* s_data;
+
+	friend class TabIconAnimator;
 };
 }
 #endif //SIELOBROWSER_TABICON_HPP
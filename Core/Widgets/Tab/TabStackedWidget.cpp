@@ -313,6 +313,9 @@ void TabStackedWidget::keyPressEvent(QKeyEvent* event)
 
 void TabStackedWidget::showTab(int index)
 {
+	if (index != m_currentIndex && validIndex(m_currentIndex))
+		emit currentAboutToChange(m_currentIndex);
+
 	if (validIndex(index))
 		m_stack->setCurrentIndex(index);
 
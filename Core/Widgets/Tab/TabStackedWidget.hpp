@@ -90,6 +90,8 @@ public:
 	QWidget* widget(int index) const;
 
 signals:
+	// Emitted while the current tab is still shown
+	void currentAboutToChange(int index);
 	void currentChanged(int index);
 	void tabCloseRequested(int index);
 	void pinStateChanged(int index, bool pinned);
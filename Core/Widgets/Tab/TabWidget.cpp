@@ -79,7 +79,7 @@ TabWidget::TabWidget(BrowserWindow* window, Application::TabsSpaceType type, QWi
 {
 	setObjectName(QLatin1String("tabwidget"));
 
-	m_closedTabsManager = new ClosedTabsManager;
+	m_closedTabsManager = Application::instance()->closedTabsManager();
 	
 	m_tabBar = new MainTabBar(this);
 	m_menuTabs = new MenuTabs(this);
@@ -153,6 +153,11 @@ TabWidget::TabWidget(BrowserWindow* window, Application::TabsSpaceType type, QWi
 
 	connect(this, &TabWidget::changed, m_saveTimer, &AutoSaver::changeOccurred);
 	connect(this, &TabStackedWidget::pinStateChanged, this, &TabWidget::changed);
+	connect(this, &TabStackedWidget::currentAboutToChange, this, [this](int index)
+	{
+		if (WebTab* tab = weTab(index))
+			tab->captureMissingSnapshot();
+	});
 
 	connect(m_tabBar, &MainTabBar::tabCloseRequested, this, &TabWidget::requestCloseTab);
 	connect(m_tabBar, &MainTabBar::tabMoved, this, &TabWidget::tabMoved);
@@ -164,6 +169,7 @@ TabWidget::TabWidget(BrowserWindow* window, Application::TabsSpaceType type, QWi
 	connect(m_buttonAddTab, SIGNAL(clicked()), this, SLOT(addTab()));
 	connect(m_buttonAddTab2, SIGNAL(clicked()), this, SLOT(addTab()));
 	connect(m_buttonClosedTabs, &ToolButton::aboutToShowMenu, this, &TabWidget::aboutToShowClosedTabsMenu);
+	connect(m_closedTabsManager, &ClosedTabsManager::changed, this, &TabWidget::updateClosedTabsButton);
 	connect(m_buttonListTabs, &ToolButton::aboutToShowMenu, this, &TabWidget::aboutToShowTabsMenu);
 
 	///**** Shortcuts ****///
@@ -213,7 +219,6 @@ TabWidget::TabWidget(BrowserWindow* window, Application::TabsSpaceType type, QWi
 TabWidget::~TabWidget()
 {
 	Application::instance()->plugins()->emitTabsSpaceDeleted(this);
-	delete m_closedTabsManager;
 }
 
 void TabWidget::loadSettings()
@@ -835,15 +840,16 @@ void TabWidget::restoreAllClosedTabs()
 	if (!m_closedTabsManager->isClosedTabAvailable())
 		return;
 
-	const QLinkedList<ClosedTabsManager::Tab>& closedTabs = m_closedTabsManager->allClosedTab();
+	const int count{m_closedTabsManager->count()};
 
-	foreach (const ClosedTabsManager::Tab& tab, closedTabs) {
+	for (int i{0}; i < count; ++i) {
+		const ClosedTabsManager::Tab tab{m_closedTabsManager->takeLastClosedTab()};
 		int index{addView(QUrl(), tab.title, Application::NTT_CleanSelectedTab)};
 		WebTab* webTab{weTab(index)};
 		webTab->p_restoreTab(tab.url, tab.history, tab.zoomLevel);
 	}
 
-	clearClosedTabsList();
+	updateClosedTabsButton();
 }
 
 void TabWidget::clearClosedTabsList()
@@ -979,12 +985,12 @@ void TabWidget::aboutToShowClosedTabsMenu()
 	m_menuClosedTabs->clear();
 
 	int i{0};
-	const QLinkedList<ClosedTabsManager::Tab> closedTabs = closedTabsManager()->allClosedTab();
+	const QVector<ClosedTabsManager::Tab> closedTabs = closedTabsManager()->allClosedTab();
 
 	foreach (const ClosedTabsManager::Tab& tab, closedTabs) {
 		const QString title{tab.title.length() > 40 ? tab.title.left(40) + QLatin1String("...") : tab.title};
 		QAction* action{m_menuClosedTabs->addAction(tab.icon, title, this, SLOT(restoreClosedTab()))};
-		action->setData(++i);
+		action->setData(i++);
 	}
 
 	if (m_menuClosedTabs->isEmpty())
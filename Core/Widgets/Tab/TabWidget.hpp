@@ -196,7 +196,7 @@ private:
 
 	BrowserWindow* m_window{nullptr};
 	MainTabBar* m_tabBar{nullptr};
-	ClosedTabsManager* m_closedTabsManager;
+	ClosedTabsManager* m_closedTabsManager{nullptr};
 	Application::TabsSpaceType m_tabsSpaceType{};
 
 	MenuTabs* m_menuTabs{nullptr};
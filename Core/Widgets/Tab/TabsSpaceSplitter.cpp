@@ -29,6 +29,7 @@
 #include "Bookmarks/BookmarksToolbar.hpp"
 
 #include "Utils/Settings.hpp"
+#include "Utils/SettingsSnapshot.hpp"
 #include "Utils/DataPaths.hpp"
 
 #include "Web/WebView.hpp"
@@ -90,8 +91,7 @@ TabsSpaceSplitter::SavedTabsSpace::SavedTabsSpace(TabsSpaceSplitter* splitter, T
 
 TabsSpaceSplitter::SavedTabsSpace::SavedTabsSpace(MaquetteGridTabsList* maquetteGridTabsList)
 {
-	Settings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
+	const int defaultZoomLevel{SettingsSnapshot::current()->defaultZoomLevel};
 
 	homeUrl = maquetteGridTabsList->manager()->window()->homePageUrl().toString();
 	currentTab = 0;
@@ -0,0 +1,362 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Widgets/TaskManager.hpp"
+
+#include <QHeaderView>
+#include <QLocale>
+#include <QShortcut>
+
+#include <algorithm>
+
+#include "Application.hpp"
+
+#include "Network/RequestAccounting.hpp"
+
+#include "Utils/ProcessMemory.hpp"
+
+#include "Web/WebPage.hpp"
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabbedWebView.hpp"
+#include "Web/Tab/TabLifecycleManager.hpp"
+
+namespace Sn
+{
+namespace
+{
+const int RefreshInterval = 2000;
+
+// Numeric columns are sorted on their raw value, stored in Qt::UserRole
+class TaskItem: public QTreeWidgetItem {
+public:
+	bool operator<(const QTreeWidgetItem& other) const override
+	{
+		const int column{treeWidget() ? treeWidget()->sortColumn() : 0};
+		const QVariant value{data(column, Qt::UserRole)};
+
+		if (value.isValid())
+			return value.toDouble() < other.data(column, Qt::UserRole).toDouble();
+
+		return QTreeWidgetItem::operator<(other);
+	}
+};
+
+QString resourcesSummary(const RequestAccounting::Usage& usage)
+{
+	if (usage.requests <= 0)
+		return QString();
+
+	QVector<int> categories{};
+
+	for (int i{0}; i < RequestAccounting::CategoryCount; ++i) {
+		if (usage.categories[i] > 0)
+			categories.append(i);
+	}
+
+	std::sort(categories.begin(), categories.end(), [&usage](int first, int second)
+	{
+		return usage.categories[first] > usage.categories[second];
+	});
+
+	QStringList parts{};
+
+	for (int i{0}; i < qMin(3, categories.count()); ++i) {
+		const int category{categories[i]};
+
+		parts.append(QStringLiteral("%1 %2%").arg(
+			RequestAccounting::categoryName(static_cast<RequestAccounting::ResourceCategory>(category)),
+			QString::number(usage.categories[category] * 100 / usage.requests)));
+	}
+
+	return parts.join(QLatin1String(", "));
+}
+}
+
+TaskManager::TaskManager(QWidget* parent) :
+	QDialog(parent),
+	m_refreshTimer(new QTimer(this))
+{
+	setAttribute(Qt::WA_DeleteOnClose);
+	setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
+	setWindowTitle(tr("Task Manager"));
+
+	setupUI();
+
+	connect(m_tree, &QTreeWidget::currentItemChanged, this, &TaskManager::currentItemChanged);
+	connect(m_unloadButton, &QPushButton::clicked, this, &TaskManager::unloadTab);
+	connect(m_closeTabButton, &QPushButton::clicked, this, &TaskManager::closeTab);
+	connect(m_closeButton, &QPushButton::clicked, this, &TaskManager::close);
+	connect(m_refreshTimer, &QTimer::timeout, this, &TaskManager::refresh);
+
+	QShortcut* unloadShortcut{new QShortcut(QKeySequence("Del"), this)};
+	connect(unloadShortcut, &QShortcut::activated, this, &TaskManager::unloadTab);
+
+	refresh();
+	currentItemChanged();
+
+	m_tree->sortItems(MemoryColumn, Qt::DescendingOrder);
+	m_refreshTimer->start(RefreshInterval);
+}
+
+TaskManager::~TaskManager()
+{
+	// Empty
+}
+
+QString TaskManager::tabUsageSummary(WebTab* tab)
+{
+	if (!tab || tab->application())
+		return QString();
+
+	if (!tab->isRestored())
+		return tr("Unloaded");
+
+	const RequestAccounting::Usage usage{RequestAccounting::usage(tab->url().host())};
+	const qint64 memory{Application::instance()->tabLifecycleManager()->memoryEstimate(tab)};
+	QString summary{tr("%1 requests, %2 blocked").arg(usage.requests).arg(usage.blocked)};
+
+	if (memory > 0)
+		summary = tr("Memory: %1").arg(QLocale().formattedDataSize(memory)) + QLatin1String(" - ") + summary;
+
+	return summary;
+}
+
+void TaskManager::refresh()
+{
+	TabLifecycleManager* lifecycleManager{Application::instance()->tabLifecycleManager()};
+	const QVector<ProcessMemory::ProcessInfo> processes{ProcessMemory::browserProcesses()};
+	const QHash<QString, RequestAccounting::Usage> usages{RequestAccounting::allUsage()};
+	QHash<qint64, ProcessMemory::ProcessInfo> processByPid{};
+	QHash<qint64, qint64> ticks{};
+	QHash<QString, QTreeWidgetItem*> previousItems{m_items};
+
+	foreach (const ProcessMemory::ProcessInfo& process, processes)
+		processByPid.insert(process.pid, process);
+
+	qint64 elapsed{0};
+
+	if (m_sampleTimer.isValid())
+		elapsed = m_sampleTimer.restart();
+	else
+		m_sampleTimer.start();
+
+	// Items are moved while sorting is enabled, which would make the loop below slow and the selection jump
+	const int sortColumn{m_tree->header()->sortIndicatorSection()};
+	const Qt::SortOrder sortOrder{m_tree->header()->sortIndicatorOrder()};
+	m_tree->setSortingEnabled(false);
+
+	RequestAccounting::Usage total{};
+
+	foreach (const RequestAccounting::Usage& usage, usages)
+		total += usage;
+
+	const ProcessMemory::ProcessInfo browser{processes.value(0)};
+	previousItems.remove(QStringLiteral("browser"));
+	updateItem(item(QStringLiteral("browser")), tr("Browser"), browser.residentBytes,
+			   cpuUsage(browser.pid, browser.cpuTicks, elapsed, ticks), total.requests, total.blocked,
+			   resourcesSummary(total));
+
+	m_tabs.clear();
+
+	foreach (WebTab* tab, lifecycleManager->tabs()) {
+		const QString key{QStringLiteral("tab-%1").arg(reinterpret_cast<quintptr>(tab), 0, 16)};
+		const RequestAccounting::Usage usage{
+			tab->application() ? RequestAccounting::Usage() : usages.value(tab->url().host())
+		};
+		double cpu{-1};
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+		if (tab->isRestored()) {
+			const qint64 pid{tab->webView()->page()->renderProcessPid()};
+
+			if (processByPid.contains(pid))
+				cpu = cpuUsage(pid, processByPid.value(pid).cpuTicks, elapsed, ticks);
+		}
+#endif
+
+		QTreeWidgetItem* tabItem{item(key)};
+		previousItems.remove(key);
+		m_tabs.insert(tabItem, tab);
+
+		tabItem->setIcon(TaskColumn, tab->icon());
+		tabItem->setToolTip(TaskColumn, tab->url().toString());
+		updateItem(tabItem, tab->isRestored() ? tab->title() : tr("%1 (unloaded)").arg(tab->title()),
+				   lifecycleManager->memoryEstimate(tab), cpu, usage.requests, usage.blocked, resourcesSummary(usage));
+	}
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+	// Renderers can't be matched with their tabs, all the web engine processes are shown together
+	qint64 contentMemory{0};
+	double contentCpu{-1};
+
+	for (int i{1}; i < processes.count(); ++i) {
+		const double cpu{cpuUsage(processes[i].pid, processes[i].cpuTicks, elapsed, ticks)};
+
+		contentMemory += processes[i].residentBytes;
+
+		if (cpu >= 0)
+			contentCpu = qMax(0.0, contentCpu) + cpu;
+	}
+
+	if (processes.count() > 1) {
+		previousItems.remove(QStringLiteral("content"));
+		updateItem(item(QStringLiteral("content")), tr("Web content processes"), contentMemory, contentCpu, -1, -1,
+				   QString());
+	}
+#endif
+
+	for (auto it = previousItems.constBegin(); it != previousItems.constEnd(); ++it) {
+		m_items.remove(it.key());
+		delete it.value();
+	}
+
+	m_previousTicks = ticks;
+
+	m_tree->setSortingEnabled(true);
+	m_tree->sortItems(sortColumn, sortOrder);
+
+	m_summary->setText(tr("%1 tabs, %2 requests, %3 blocked")
+						   .arg(lifecycleManager->tabs().count())
+						   .arg(total.requests)
+						   .arg(total.blocked));
+
+	currentItemChanged();
+}
+
+void TaskManager::currentItemChanged()
+{
+	WebTab* tab{selectedTab()};
+
+	m_unloadButton->setEnabled(tab && Application::instance()->tabLifecycleManager()->canDiscard(tab));
+	m_closeTabButton->setEnabled(tab);
+}
+
+void TaskManager::unloadTab()
+{
+	if (WebTab* tab = selectedTab())
+		Application::instance()->tabLifecycleManager()->discardTab(tab);
+
+	refresh();
+}
+
+void TaskManager::closeTab()
+{
+	if (WebTab* tab = selectedTab())
+		tab->closeTab();
+
+	// The tab is deleted later, it is removed from the list on next refresh
+	QTimer::singleShot(0, this, &TaskManager::refresh);
+}
+
+void TaskManager::setupUI()
+{
+	resize(760, 420);
+
+	m_layout = new QVBoxLayout(this);
+	m_buttonsLayout = new QHBoxLayout();
+
+	m_tree = new QTreeWidget(this);
+	m_tree->setRootIsDecorated(false);
+	m_tree->setUniformRowHeights(true);
+	m_tree->setAlternatingRowColors(true);
+	m_tree->setHeaderLabels({tr("Task"), tr("Memory"), tr("CPU"), tr("Requests"), tr("Blocked"), tr("Resources")});
+	m_tree->header()->setSectionResizeMode(TaskColumn, QHeaderView::Stretch);
+	m_tree->header()->setStretchLastSection(false);
+	m_tree->setSortingEnabled(true);
+
+	m_summary = new QLabel(this);
+	m_unloadButton = new QPushButton(tr("Unload Tab"), this);
+	m_closeTabButton = new QPushButton(tr("Close Tab"), this);
+	m_closeButton = new QPushButton(tr("Close"), this);
+
+	m_buttonsLayout->addWidget(m_summary);
+	m_buttonsLayout->addStretch();
+	m_buttonsLayout->addWidget(m_unloadButton);
+	m_buttonsLayout->addWidget(m_closeTabButton);
+	m_buttonsLayout->addWidget(m_closeButton);
+
+	m_layout->addWidget(m_tree);
+	m_layout->addLayout(m_buttonsLayout);
+}
+
+QTreeWidgetItem* TaskManager::item(const QString& key)
+{
+	QTreeWidgetItem* item{m_items.value(key)};
+
+	if (!item) {
+		item = new TaskItem();
+
+		for (int column{MemoryColumn}; column <= BlockedColumn; ++column)
+			item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+
+		m_tree->addTopLevelItem(item);
+		m_items.insert(key, item);
+	}
+
+	return item;
+}
+
+void TaskManager::updateItem(QTreeWidgetItem* item, const QString& name, qint64 memory, double cpu, qint64 requests,
+							 qint64 blocked, const QString& resources)
+{
+	item->setText(TaskColumn, name);
+
+	item->setText(MemoryColumn, memory > 0 ? QLocale().formattedDataSize(memory) : QStringLiteral("-"));
+	item->setData(MemoryColumn, Qt::UserRole, memory);
+
+	item->setText(CpuColumn, cpu >= 0 ? QString::number(cpu, 'f', 1) + QLatin1Char('%') : QStringLiteral("-"));
+	item->setData(CpuColumn, Qt::UserRole, cpu);
+
+	item->setText(RequestsColumn, requests >= 0 ? QString::number(requests) : QStringLiteral("-"));
+	item->setData(RequestsColumn, Qt::UserRole, requests);
+
+	item->setText(BlockedColumn, blocked >= 0 ? QString::number(blocked) : QStringLiteral("-"));
+	item->setData(BlockedColumn, Qt::UserRole, blocked);
+
+	item->setText(ResourcesColumn, resources);
+}
+
+double TaskManager::cpuUsage(qint64 pid, qint64 cpuTicks, qint64 elapsed, QHash<qint64, qint64>& ticks) const
+{
+	ticks.insert(pid, cpuTicks);
+
+	if (pid <= 0 || elapsed <= 0 || !m_previousTicks.contains(pid))
+		return -1;
+
+	const double seconds{(cpuTicks - m_previousTicks.value(pid)) / double(ProcessMemory::clockTicksPerSecond())};
+
+	return qMax(0.0, seconds * 1000 * 100 / elapsed);
+}
+
+WebTab* TaskManager::selectedTab() const
+{
+	WebTab* tab{m_tabs.value(m_tree->currentItem())};
+
+	// The tab may have been closed since the last refresh
+	if (!tab || !Application::instance()->tabLifecycleManager()->tabs().contains(tab))
+		return nullptr;
+
+	return tab;
+}
+}
@@ -0,0 +1,109 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_TASKMANAGER_HPP
+#define SIELOBROWSER_TASKMANAGER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QDialog>
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QLabel>
+
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <QHash>
+
+namespace Sn
+{
+class WebTab;
+
+/*
+ * Lists the tabs of every window with the memory and CPU used by their renderer and the requests their site made,
+ * refreshed every two seconds. Memory and CPU come from /proc through the renderer pid when the web engine exposes it
+ * (Qt 5.15), otherwise the memory is estimated by the tab lifecycle manager and the CPU is only shown for all the web
+ * engine processes together. Requests are counted per first party host, so tabs showing a same site share them.
+ */
+class SIELO_SHAREDLIB TaskManager: public QDialog {
+Q_OBJECT
+
+public:
+	enum Column {
+		TaskColumn,
+		MemoryColumn,
+		CpuColumn,
+		RequestsColumn,
+		BlockedColumn,
+		ResourcesColumn
+	};
+
+	TaskManager(QWidget* parent = nullptr);
+	~TaskManager();
+
+	// Usage summary shown in the tab bar tooltip
+	static QString tabUsageSummary(WebTab* tab);
+
+private slots:
+	void refresh();
+	void currentItemChanged();
+
+	void unloadTab();
+	void closeTab();
+
+private:
+	void setupUI();
+
+	QTreeWidgetItem* item(const QString& key);
+	void updateItem(QTreeWidgetItem* item, const QString& name, qint64 memory, double cpu, qint64 requests,
+					qint64 blocked, const QString& resources);
+
+	double cpuUsage(qint64 pid, qint64 cpuTicks, qint64 elapsed, QHash<qint64, qint64>& ticks) const;
+	WebTab* selectedTab() const;
+
+	QVBoxLayout* m_layout{nullptr};
+	QHBoxLayout* m_buttonsLayout{nullptr};
+
+	QTreeWidget* m_tree{nullptr};
+	QLabel* m_summary{nullptr};
+	QPushButton* m_unloadButton{nullptr};
+	QPushButton* m_closeTabButton{nullptr};
+	QPushButton* m_closeButton{nullptr};
+
+	QTimer* m_refreshTimer{nullptr};
+	QElapsedTimer m_sampleTimer{};
+
+	QHash<QString, QTreeWidgetItem*> m_items{};
+	QHash<QTreeWidgetItem*, WebTab*> m_tabs{};
+	QHash<qint64, qint64> m_previousTicks{};
+};
+}
+
+#endif //SIELOBROWSER_TASKMANAGER_HPP
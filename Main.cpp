@@ -30,6 +30,8 @@
 
 #include "Core/BrowserWindow.hpp"
 
+#include <QWebEngine/UrlSchemeHandler.hpp>
+
 #ifdef Q_OS_WIN
 #include <d3d9.h>
 #endif
@@ -87,6 +89,8 @@ int main(int argc, char** argv)
 	if (settings.value("useSoftwareOpenGL", false).toBool())
 		QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL);
 
+	Engine::UrlSchemeHandler::registerScheme(QByteArrayLiteral("sielo"));
+
 	Sn::Application app(argc, argv);
 
 	if (app.isClosing())
@@ -30,6 +30,8 @@
 #include <QFileInfo>
 #include <QFileInfoList>
 
+#include "Utils/ThemePackage.hpp"
+
 #include <iostream>
 
 Application::Application(int& argc, char** argv) :
@@ -94,114 +96,23 @@ bool Application::compile(const QString& srcFolder, const QString& fileDestinati
 		return false;
 	}
 
-	m_file.setFileName(fileDestination);
-
-	if (!m_file.open(QIODevice::WriteOnly)) {
-		m_errors = QApplication::tr("The destination file can't be open.");
-		return false;
-	}
-
-	m_stream.setDevice(&m_file);
-
-	bool success{compress(srcFolder, "")};
-
-	m_file.close();
-
-	return success;
-
+	return Sn::ThemePackage::write(src.absolutePath(), fileDestination, &m_errors);
 }
 
 bool Application::decompile(const QString& srcFile, const QString& filesDestination)
 {
-	QFile src{srcFile};
-	QFileInfo name{};
-
-	if (!src.exists()) {
+	if (!QFileInfo::exists(srcFile)) {
 		m_errors = QApplication::tr("Sources to decompile don't exists.");
 		return false;
 	}
 
-	QDir dir{};
+	// Reads both the indexed packages and the sequential ones of the first version
+	Sn::ThemePackage package{srcFile};
 
-	if (!dir.mkpath(filesDestination)) {
-		m_errors = QApplication::tr("Can't create folder to receive decompiled files");
+	if (!package.open() || !package.extract(filesDestination)) {
+		m_errors = package.errorString();
 		return false;
 	}
 
-	if (!src.open(QIODevice::ReadOnly)) {
-		m_errors = QApplication::tr("Failed to read compiled file.");
-		return false;
-	}
-
-	QDataStream stream{&src};
-
-	while (!stream.atEnd()) {
-		QString fileName{};
-		QByteArray data{};
-
-		stream >> fileName >> data;
-
-		QString subFolder{};
-
-		for (int i{fileName.length() - 1}; i > 0; --i) {
-			if ((QString(fileName[i]) == QString("\\")) || (QString(fileName[i]) == QString("/"))) {
-				subFolder = fileName.left(i);
-				dir.mkpath(filesDestination + QLatin1Char('/') + subFolder);
-
-				break;
-			}
-		}
-
-		QFile outFile{filesDestination + QLatin1Char('/') + fileName};
-
-		if (!outFile.open(QIODevice::WriteOnly)) {
-			src.close();
-			m_errors = QApplication::tr("Failed to write decompiled files.");
-			return false;
-		}
-
-		outFile.write(qUncompress(data));
-		outFile.close();
-	}
-
-	src.close();
-
 	return true;
 }
-
-bool Application::compress(const QString& srcFolder, const QString& prefexe)
-{
-	QDir dir{srcFolder};
-
-	dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
-
-	QFileInfoList folderList{dir.entryInfoList()};
-
-	for (int i{0}; i < folderList.length(); ++i) {
-		QString folderName{folderList[i].fileName()};
-		QString folderPath{dir.absolutePath() + QLatin1Char('/') + folderName};
-		QString newPrefexe{prefexe + QLatin1Char('/') + folderName};
-
-		compress(folderPath, newPrefexe);
-	}
-
-	dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
-
-	QFileInfoList filesList{dir.entryInfoList()};
-
-	for (int i{0}; i < filesList.length(); ++i) {
-		QFile file{dir.absolutePath() + QLatin1Char('/') + filesList[i].fileName()};
-
-		if (!file.open(QIODevice::ReadOnly)) {
-			m_errors = QApplication::tr("Failed to read ") + filesList[i].fileName();
-			return false;
-		}
-
-		m_stream << QString(prefexe + QLatin1Char('/') + filesList[i].fileName());
-		m_stream << qCompress(file.readAll());
-
-		file.close();
-	}
-
-	return true;
-}
\ No newline at end of file
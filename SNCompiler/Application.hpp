@@ -28,9 +28,6 @@
 
 #include <QApplication>
 
-#include <QFile>
-#include <QDataStream>
-
 class Application: public QApplication {
 public:
 	Application(int& argc, char** argv);
@@ -40,11 +37,6 @@ private:
 	bool compile(const QString& srcFolder, const QString& fileDestination);
 	bool decompile(const QString& srcFile, const QString& filesDestination);
 
-	bool compress(const QString& srcFolder, const QString& prefexe);
-
 	QString m_errors{};
-
-	QFile m_file{};
-	QDataStream m_stream{};
 };
 #endif //SIELO_BROWSER_APPLICATION_HPP
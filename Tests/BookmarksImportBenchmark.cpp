@@ -0,0 +1,174 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "Bookmarks/BookmarkItem.hpp"
+#include "Bookmarks/BookmarksImport/HtmlImporter.hpp"
+#include "Bookmarks/BookmarksImport/ChromeImporter.hpp"
+
+using namespace Sn;
+
+/*
+ * Imports synthetic HTML and Chrome exports holding as many bookmarks as large real world profiles.
+ */
+class BookmarksImportBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void htmlImport();
+	void chromeImport();
+
+private:
+	static int countUrls(const BookmarkItem* item);
+
+	QTemporaryDir m_dir{};
+	QString m_htmlPath{};
+	QString m_chromePath{};
+};
+
+static const int FolderCount = 200;
+static const int BookmarksPerFolder = 100;
+
+void BookmarksImportBenchmark::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+
+	m_htmlPath = m_dir.filePath(QStringLiteral("bookmarks.html"));
+	m_chromePath = m_dir.filePath(QStringLiteral("Bookmarks"));
+
+	QFile html{m_htmlPath};
+	QVERIFY(html.open(QIODevice::WriteOnly | QIODevice::Text));
+
+	QTextStream htmlStream{&html};
+	htmlStream.setCodec("UTF-8");
+	htmlStream << "<!DOCTYPE NETSCAPE-Bookmark-file-1>\n<!-- This is an automatically generated file. -->\n"
+		<< "<META HTTP-EQUIV=\"Content-Type\" CONTENT=\"text/html; charset=UTF-8\">\n<TITLE>Bookmarks</TITLE>\n"
+		<< "<H1>Bookmarks</H1>\n<DL><p>\n";
+
+	for (int folder{0}; folder < FolderCount; ++folder) {
+		htmlStream << "    <DT><H3 ADD_DATE=\"1500000000\">Folder " << folder << "</H3>\n    <DL><p>\n";
+
+		for (int i{0}; i < BookmarksPerFolder; ++i) {
+			htmlStream << "        <DT><A HREF=\"https://www.example" << folder << ".com/page/" << i
+				<< "?query=value&amp;other=1\" ADD_DATE=\"1500000000\" ICON=\"data:image/png;base64,iVBORw0KGgo=\">"
+				<< "Bookmark " << i << " of folder " << folder << " &amp; more</A>\n";
+		}
+
+		htmlStream << "    </DL><p>\n";
+	}
+
+	htmlStream << "</DL><p>\n";
+	htmlStream.flush();
+	html.close();
+
+	QFile chrome{m_chromePath};
+	QVERIFY(chrome.open(QIODevice::WriteOnly | QIODevice::Text));
+
+	QTextStream chromeStream{&chrome};
+	chromeStream.setCodec("UTF-8");
+	chromeStream << "{\n   \"checksum\": \"0123456789abcdef\",\n   \"roots\": {\n      \"bookmark_bar\": {\n"
+		<< "         \"children\": [ ";
+
+	for (int folder{0}; folder < FolderCount; ++folder) {
+		chromeStream << (folder > 0 ? ", " : "") << "{\n            \"children\": [ ";
+
+		for (int i{0}; i < BookmarksPerFolder; ++i) {
+			chromeStream << (i > 0 ? ", " : "") << "{\n               \"date_added\": \"13000000000000000\",\n"
+				<< "               \"id\": \"" << folder * BookmarksPerFolder + i << "\",\n"
+				<< "               \"meta_info\": { \"last_visited_desktop\": \"13000000000000000\" },\n"
+				<< "               \"name\": \"Bookmark " << i << " of folder " << folder << " \\u00e9\",\n"
+				<< "               \"type\": \"url\",\n"
+				<< "               \"url\": \"https://www.example" << folder << ".com/page/" << i << "\"\n"
+				<< "            }";
+		}
+
+		chromeStream << " ],\n            \"date_added\": \"13000000000000000\",\n            \"id\": \"f" << folder
+			<< "\",\n            \"name\": \"Folder " << folder << "\",\n            \"type\": \"folder\"\n         }";
+	}
+
+	chromeStream << " ],\n         \"name\": \"Bookmarks bar\",\n         \"type\": \"folder\"\n      },\n"
+		<< "      \"other\": { \"children\": [  ], \"name\": \"Other bookmarks\", \"type\": \"folder\" },\n"
+		<< "      \"synced\": { \"children\": [  ], \"name\": \"Mobile bookmarks\", \"type\": \"folder\" }\n"
+		<< "   },\n   \"version\": 1\n}\n";
+	chromeStream.flush();
+	chrome.close();
+}
+
+int BookmarksImportBenchmark::countUrls(const BookmarkItem* item)
+{
+	int count{item->isUrl() ? 1 : 0};
+
+	foreach (const BookmarkItem* child, item->children())
+		count += countUrls(child);
+
+	return count;
+}
+
+void BookmarksImportBenchmark::htmlImport()
+{
+	int count{0};
+
+	QBENCHMARK {
+		HtmlImporter importer{};
+		importer.setPath(m_htmlPath);
+
+		QVERIFY(importer.prepareImport());
+
+		QScopedPointer<BookmarkItem> root{importer.importBookmarks()};
+		QVERIFY(root);
+
+		count = countUrls(root.data());
+	}
+
+	QCOMPARE(count, FolderCount * BookmarksPerFolder);
+}
+
+void BookmarksImportBenchmark::chromeImport()
+{
+	int count{0};
+
+	QBENCHMARK {
+		ChromeImporter importer{};
+		importer.setPath(m_chromePath);
+
+		QVERIFY(importer.prepareImport());
+
+		QScopedPointer<BookmarkItem> root{importer.importBookmarks()};
+		QVERIFY(root);
+
+		count = countUrls(root.data());
+	}
+
+	QCOMPARE(count, FolderCount * BookmarksPerFolder);
+}
+
+QTEST_GUILESS_MAIN(BookmarksImportBenchmark)
+
+#include "BookmarksImportBenchmark.moc"
@@ -0,0 +1,68 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_BROWSERTESTMAIN_HPP
+#define SIELOBROWSER_BROWSERTESTMAIN_HPP
+
+#include <QtTest>
+
+#include <QTemporaryDir>
+
+#include <QWebEngine/UrlSchemeHandler.hpp>
+
+#include "Application.hpp"
+
+/*
+ * Main of the tests which need a running browser, with its windows, tabs and web views. The browser starts in private
+ * browsing on a profile of its own: it never touches the profile of the user nor talks to a running browser.
+ * The browser reads its own command line, the one of the test is given to QTest.
+ */
+#define SIELO_BROWSER_TEST_MAIN(TestObject) \
+int main(int argc, char** argv) \
+{ \
+	QTemporaryDir home{}; \
+	qputenv("HOME", QFile::encodeName(home.path())); \
+	qputenv("XDG_CONFIG_HOME", QFile::encodeName(home.filePath(QStringLiteral("config")))); \
+	qputenv("XDG_DATA_HOME", QFile::encodeName(home.filePath(QStringLiteral("data")))); \
+	qputenv("XDG_CACHE_HOME", QFile::encodeName(home.filePath(QStringLiteral("cache")))); \
+\
+	Engine::UrlSchemeHandler::registerScheme(QByteArrayLiteral("sielo")); \
+\
+	char noRemote[]{"--no-remote"}; \
+	char privateBrowsing[]{"--private-browsing"}; \
+	char startUrl[]{"about:blank"}; \
+	char* browserArgv[]{argv[0], noRemote, privateBrowsing, startUrl, nullptr}; \
+	int browserArgc{4}; \
+\
+	Sn::Application app{browserArgc, browserArgv}; \
+\
+	if (app.isClosing()) \
+		return 1; \
+\
+	TestObject test{}; \
+	return QTest::qExec(&test, argc, argv); \
+}
+
+#endif //SIELOBROWSER_BROWSERTESTMAIN_HPP
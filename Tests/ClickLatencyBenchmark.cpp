@@ -0,0 +1,123 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+#include "BrowserTestMain.hpp"
+
+#include "BrowserWindow.hpp"
+
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabbedWebView.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+
+using namespace Sn;
+
+/*
+ * Time from a left click on a link to the start of the navigation it requests. The mouse first rests on the link,
+ * as it does when the user aims at it. Only the view signals are used, so the benchmark also runs on a browser
+ * resolving the clicked link with a blocking hit test.
+ */
+class ClickLatencyBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void clickToNavigation();
+
+private:
+	qint64 clickLink();
+
+	TabbedWebView* m_view{nullptr};
+};
+
+static const int Runs = 5;
+static const int Timeout = 10 * 1000;
+// The link covers the whole page, the center of the view is always on it
+static const char LinkPage[] = "data:text/html,<a href='about:blank' "
+	"style='position:fixed;top:0;left:0;right:0;bottom:0'>Link</a>";
+
+void ClickLatencyBenchmark::initTestCase()
+{
+	BrowserWindow* window{Application::instance()->getWindow()};
+	QVERIFY(window);
+
+	window->resize(1280, 800);
+	window->show();
+	QVERIFY(QTest::qWaitForWindowExposed(window));
+
+	m_view = window->tabWidget()->webTab()->webView();
+	QVERIFY(m_view);
+}
+
+qint64 ClickLatencyBenchmark::clickLink()
+{
+	QSignalSpy loaded{m_view, &QWebEngineView::loadFinished};
+	m_view->load(QUrl(QString::fromLatin1(LinkPage)));
+
+	if (!loaded.wait(Timeout))
+		return -1;
+
+	QWidget* input{m_view->inputWidget()};
+	const QPoint center{input->rect().center()};
+
+	QTest::mouseMove(input, center);
+	QTest::qWait(200);
+
+	QSignalSpy started{m_view, &QWebEngineView::loadStarted};
+	QElapsedTimer timer{};
+	timer.start();
+
+	QTest::mouseClick(input, Qt::LeftButton, Qt::NoModifier, center);
+
+	if (started.isEmpty() && !started.wait(Timeout))
+		return -1;
+
+	return timer.elapsed();
+}
+
+void ClickLatencyBenchmark::clickToNavigation()
+{
+	QVector<qint64> times{};
+
+	for (int i{0}; i < Runs; ++i) {
+		const qint64 time{clickLink()};
+
+		QVERIFY2(time >= 0, "The click on the link didn't start a navigation");
+		times.append(time);
+	}
+
+	std::sort(times.begin(), times.end());
+	QTest::setBenchmarkResult(times[Runs / 2], QTest::WalltimeMilliseconds);
+}
+
+SIELO_BROWSER_TEST_MAIN(ClickLatencyBenchmark)
+
+#include "ClickLatencyBenchmark.moc"
@@ -0,0 +1,382 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <QNetworkAccessManager>
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include "Download/DownloadEngine.hpp"
+
+#include "Utils/Settings.hpp"
+
+#include <algorithm>
+
+using namespace Sn;
+
+/*
+ * Minimal HTTP server for one file, answering HEAD and range requests with If-Range support. Every connection serves a
+ * single request. Responses can be cut in the middle of the body to simulate interrupted transfers.
+ */
+class RangeServer: public QTcpServer {
+public:
+	RangeServer(const QByteArray& content, QObject* parent = nullptr) :
+		QTcpServer(parent),
+		m_content(content)
+	{
+		connect(this, &QTcpServer::newConnection, this, &RangeServer::acceptConnections);
+	}
+
+	QUrl url() const { return QUrl(QStringLiteral("http://127.0.0.1:%1/file.bin").arg(serverPort())); }
+
+	QByteArray etag{"\"v1\""};
+	// Next range responses closing the connection after half of their body
+	int truncatedResponses{0};
+	// Range responses send half of their body, then keep the connection open without sending anything more
+	bool stalled{false};
+
+	QVector<qint64> rangeStarts{};
+	int fullResponses{0};
+	QSet<QByteArray> userAgents{};
+
+private:
+	void acceptConnections()
+	{
+		while (QTcpSocket* socket = nextPendingConnection()) {
+			connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { readRequest(socket); });
+			connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+		}
+	}
+
+	void readRequest(QTcpSocket* socket)
+	{
+		if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n"))
+			return;
+
+		const QList<QByteArray> lines{socket->readAll().split('\n')};
+		const QByteArray method{lines.value(0).split(' ').value(0)};
+		QHash<QByteArray, QByteArray> headers{};
+
+		for (int i{1}; i < lines.count(); ++i) {
+			const int separator{lines[i].indexOf(':')};
+
+			if (separator > 0)
+				headers.insert(lines[i].left(separator).trimmed().toLower(), lines[i].mid(separator + 1).trimmed());
+		}
+
+		userAgents.insert(headers.value("user-agent"));
+
+		const QByteArray range{headers.value("range")};
+		const QByteArray ifRange{headers.value("if-range")};
+		qint64 start{0};
+		qint64 end{m_content.size() - 1};
+		bool partial{false};
+
+		if (method == "GET" && range.startsWith("bytes=") && (ifRange.isEmpty() || ifRange == etag)) {
+			const QList<QByteArray> bounds{range.mid(6).split('-')};
+
+			start = bounds.value(0).toLongLong();
+
+			if (!bounds.value(1).isEmpty())
+				end = qMin(bounds.value(1).toLongLong(), end);
+
+			partial = true;
+			rangeStarts.append(start);
+		}
+		else if (method == "GET") {
+			++fullResponses;
+		}
+
+		const QByteArray body{m_content.mid(start, end - start + 1)};
+		QByteArray response{partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n"};
+
+		response += "Accept-Ranges: bytes\r\nETag: " + etag + "\r\nConnection: close\r\n";
+		response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+
+		if (partial) {
+			response += "Content-Range: bytes " + QByteArray::number(start) + '-' + QByteArray::number(end) + '/'
+				+ QByteArray::number(m_content.size()) + "\r\n";
+		}
+
+		socket->write(response + "\r\n");
+
+		if (method == "HEAD") {
+			socket->disconnectFromHost();
+			return;
+		}
+
+		if (partial && stalled) {
+			socket->write(body.left(body.size() / 2));
+			return;
+		}
+
+		if (partial && truncatedResponses > 0) {
+			--truncatedResponses;
+			socket->write(body.left(body.size() / 2));
+			socket->disconnectFromHost();
+			return;
+		}
+
+		socket->write(body);
+		socket->disconnectFromHost();
+	}
+
+	QByteArray m_content{};
+};
+
+class DownloadEngineTest: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+
+	void probe();
+	void download();
+	void validatorMismatch();
+	void retryResumesSegment();
+	void journalResume();
+
+private:
+	QByteArray fileContent(const QString& path) const;
+	qint64 journalWritten(qint64 id) const;
+
+	QTemporaryDir m_dir{};
+	QByteArray m_content{};
+
+	QNetworkAccessManager* m_networkManager{nullptr};
+	RangeServer* m_server{nullptr};
+	DownloadEngine* m_engine{nullptr};
+};
+
+// The engine doesn't split below one MiB per segment, this gives four segments of one MiB
+static const qint64 ContentSize = 4 * 1024 * 1024;
+static const qint64 SegmentSize = ContentSize / 4;
+static const int Timeout = 30 * 1000;
+
+void DownloadEngineTest::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+
+	m_content.reserve(ContentSize);
+
+	for (qint64 i{0}; i < ContentSize; ++i)
+		m_content.append(static_cast<char>(i % 251));
+
+	Settings::createSettings(m_dir.filePath(QStringLiteral("settings.ini")));
+
+	Settings settings{};
+	settings.beginGroup(QStringLiteral("Download-Settings"));
+	settings.setValue(QStringLiteral("segmentedDownloads"), true);
+	settings.setValue(QStringLiteral("segmentedDownloadConnections"), 4);
+	settings.setValue(QStringLiteral("segmentedDownloadMinimumSize"), 0);
+	settings.endGroup();
+
+	QSqlDatabase database{QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"))};
+	database.setDatabaseName(m_dir.filePath(QStringLiteral("browsedata.db")));
+	QVERIFY(database.open());
+
+	m_networkManager = new QNetworkAccessManager(this);
+}
+
+void DownloadEngineTest::init()
+{
+	m_server = new RangeServer(m_content, this);
+	QVERIFY(m_server->listen(QHostAddress::LocalHost));
+
+	m_engine = new DownloadEngine(m_networkManager, true, this);
+	m_engine->setUserAgent("Sielo/test");
+}
+
+void DownloadEngineTest::cleanup()
+{
+	delete m_engine;
+	m_engine = nullptr;
+
+	delete m_server;
+	m_server = nullptr;
+}
+
+QByteArray DownloadEngineTest::fileContent(const QString& path) const
+{
+	QFile file{path};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return QByteArray();
+
+	return file.readAll();
+}
+
+qint64 DownloadEngineTest::journalWritten(qint64 id) const
+{
+	QSqlQuery query{QSqlDatabase::database()};
+	query.prepare(QStringLiteral("SELECT SUM(written) FROM download_segments WHERE download_id = ?"));
+	query.addBindValue(id);
+
+	if (!query.exec() || !query.next())
+		return -1;
+
+	return query.value(0).toLongLong();
+}
+
+void DownloadEngineTest::probe()
+{
+	qint64 size{0};
+	QByteArray validator{};
+	bool answered{false};
+
+	m_engine->probe(m_server->url(), this, [&](qint64 probedSize, const QByteArray& probedValidator)
+	{
+		size = probedSize;
+		validator = probedValidator;
+		answered = true;
+	});
+
+	QTRY_VERIFY_WITH_TIMEOUT(answered, Timeout);
+	QCOMPARE(size, ContentSize);
+	QCOMPARE(validator, QByteArray("\"v1\""));
+	QCOMPARE(m_server->userAgents, QSet<QByteArray>() << m_engine->userAgent());
+}
+
+void DownloadEngineTest::download()
+{
+	const QString path{m_dir.filePath(QStringLiteral("download.bin"))};
+	QScopedPointer<SegmentedDownload> download{m_engine->download(m_server->url(), path, ContentSize, "\"v1\"")};
+
+	QTRY_COMPARE_WITH_TIMEOUT(download->state(), SegmentedDownload::Completed, Timeout);
+	QVERIFY(fileContent(path) == m_content);
+	QVERIFY(!QFile::exists(path + QLatin1String(".part")));
+
+	std::sort(m_server->rangeStarts.begin(), m_server->rangeStarts.end());
+	QCOMPARE(m_server->rangeStarts, QVector<qint64>() << 0 << SegmentSize << 2 * SegmentSize << 3 * SegmentSize);
+	QCOMPARE(m_server->fullResponses, 0);
+	QCOMPARE(m_server->userAgents, QSet<QByteArray>() << m_engine->userAgent());
+
+	// Finished downloads leave the journal
+	QCOMPARE(journalWritten(download->id()), qint64(0));
+}
+
+void DownloadEngineTest::validatorMismatch()
+{
+	const QString path{m_dir.filePath(QStringLiteral("changed.bin"))};
+
+	// The file changed on the server since it was probed
+	m_server->etag = "\"v2\"";
+
+	QScopedPointer<SegmentedDownload> download{m_engine->download(m_server->url(), path, ContentSize, "\"v1\"")};
+
+	QTRY_COMPARE_WITH_TIMEOUT(download->state(), SegmentedDownload::Failed, Timeout);
+	QVERIFY(!download->errorString().isEmpty());
+	QVERIFY(m_server->fullResponses > 0);
+	QTRY_VERIFY(!QFile::exists(path + QLatin1String(".part")));
+	QVERIFY(!QFile::exists(path));
+
+	// Writes queued before the failure don't count anymore, and the stale validator is never used again
+	QTest::qWait(100);
+	QCOMPARE(download->bytesReceived(), qint64(0));
+	QVERIFY(!download->canResume());
+
+	download->start();
+	QCOMPARE(download->state(), SegmentedDownload::Failed);
+	QCOMPARE(journalWritten(download->id()), qint64(0));
+}
+
+void DownloadEngineTest::retryResumesSegment()
+{
+	const QString path{m_dir.filePath(QStringLiteral("retried.bin"))};
+
+	m_server->truncatedResponses = 1;
+
+	QScopedPointer<SegmentedDownload> download{m_engine->download(m_server->url(), path, ContentSize, "\"v1\"")};
+
+	QTRY_COMPARE_WITH_TIMEOUT(download->state(), SegmentedDownload::Completed, Timeout);
+	QVERIFY(fileContent(path) == m_content);
+
+	// The interrupted segment asked the rest of its range again, not the whole of it
+	QCOMPARE(m_server->rangeStarts.count(), 5);
+
+	const bool resumedInside{std::any_of(m_server->rangeStarts.cbegin(), m_server->rangeStarts.cend(), [](qint64 start)
+	{
+		return start % SegmentSize != 0;
+	})};
+
+	QVERIFY(resumedInside);
+}
+
+void DownloadEngineTest::journalResume()
+{
+	const QString path{m_dir.filePath(QStringLiteral("resumed.bin"))};
+
+	m_server->stalled = true;
+
+	SegmentedDownload* download{m_engine->download(m_server->url(), path, ContentSize, "\"v1\"")};
+	const qint64 id{download->id()};
+
+	// Half of every segment is sent, it reaches the journal once written
+	QTRY_COMPARE_WITH_TIMEOUT(journalWritten(id), ContentSize / 2, Timeout);
+
+	download->pause();
+	QCOMPARE(download->state(), SegmentedDownload::Paused);
+	delete download;
+
+	m_server->stalled = false;
+	m_server->rangeStarts.clear();
+
+	const QVector<SegmentedDownload*> unfinished{m_engine->unfinishedDownloads()};
+	SegmentedDownload* resumed{nullptr};
+
+	foreach (SegmentedDownload* candidate, unfinished) {
+		if (candidate->id() == id)
+			resumed = candidate;
+		else
+			delete candidate;
+	}
+
+	QVERIFY(resumed);
+	QScopedPointer<SegmentedDownload> guard{resumed};
+
+	QCOMPARE(resumed->state(), SegmentedDownload::Paused);
+	QCOMPARE(resumed->bytesReceived(), ContentSize / 2);
+
+	resumed->start();
+
+	QTRY_COMPARE_WITH_TIMEOUT(resumed->state(), SegmentedDownload::Completed, Timeout);
+	QVERIFY(fileContent(path) == m_content);
+
+	// Every segment went on from the middle of its range
+	std::sort(m_server->rangeStarts.begin(), m_server->rangeStarts.end());
+	QCOMPARE(m_server->rangeStarts, QVector<qint64>() << SegmentSize / 2 << SegmentSize + SegmentSize / 2
+		<< 2 * SegmentSize + SegmentSize / 2 << 3 * SegmentSize + SegmentSize / 2);
+}
+
+QTEST_GUILESS_MAIN(DownloadEngineTest)
+
+#include "DownloadEngineTest.moc"
@@ -0,0 +1,189 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QTemporaryDir>
+#include <QHostAddress>
+
+#include "Network/HostInfoCache.hpp"
+
+#include "Utils/Settings.hpp"
+
+using namespace Sn;
+
+/*
+ * The cache runs against a stub resolver that keeps the pending lookups, the test answers them when it wants to.
+ */
+class HostInfoCacheTest: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+
+	void concurrentLookupsShareOneResolve();
+	void lookupJoinsPrefetch();
+	void cachedHostIsAHit();
+	void failureExpires();
+	void destroyedContextIsNotCalled();
+
+private:
+	void answer(int index, bool success = true);
+
+	QTemporaryDir m_settingsDir{};
+	HostInfoCache* m_cache{nullptr};
+	QVector<QPair<QString, HostInfoCache::Callback>> m_resolving{};
+};
+
+void HostInfoCacheTest::initTestCase()
+{
+	QVERIFY(m_settingsDir.isValid());
+
+	Settings::createSettings(m_settingsDir.filePath(QStringLiteral("settings.ini")));
+
+	Settings settings{};
+	settings.setValue(QStringLiteral("Web-Settings/dnsPrefetch"), true);
+}
+
+void HostInfoCacheTest::init()
+{
+	m_resolving.clear();
+
+	m_cache = new HostInfoCache(this);
+	m_cache->setResolver([this](const QString& host, const HostInfoCache::Callback& callback)
+	{
+		m_resolving.append(qMakePair(host, callback));
+	});
+}
+
+void HostInfoCacheTest::cleanup()
+{
+	delete m_cache;
+	m_cache = nullptr;
+}
+
+void HostInfoCacheTest::answer(int index, bool success)
+{
+	QHostInfo info{};
+
+	if (success)
+		info.setAddresses(QList<QHostAddress>() << QHostAddress(QHostAddress::LocalHost));
+	else
+		info.setError(QHostInfo::HostNotFound);
+
+	m_resolving[index].second(info);
+}
+
+void HostInfoCacheTest::concurrentLookupsShareOneResolve()
+{
+	int answered{0};
+
+	m_cache->lookup(QStringLiteral("example.com"), this, [&answered](const QHostInfo&) { ++answered; });
+	m_cache->lookup(QStringLiteral("EXAMPLE.com"), this, [&answered](const QHostInfo&) { ++answered; });
+
+	QCOMPARE(m_resolving.count(), 1);
+	QCOMPARE(m_resolving[0].first, QStringLiteral("example.com"));
+	QCOMPARE(answered, 0);
+
+	answer(0);
+
+	QCOMPARE(answered, 2);
+	QCOMPARE(m_cache->lookupCount(), qint64(1));
+}
+
+void HostInfoCacheTest::lookupJoinsPrefetch()
+{
+	QVERIFY(m_cache->isPrefetchEnabled());
+
+	m_cache->prefetch(QStringLiteral("example.com"));
+	QCOMPARE(m_resolving.count(), 1);
+
+	bool answered{false};
+
+	m_cache->lookup(QStringLiteral("example.com"), this, [&answered](const QHostInfo& info)
+	{
+		answered = info.error() == QHostInfo::NoError;
+	});
+
+	QCOMPARE(m_resolving.count(), 1);
+
+	answer(0);
+
+	QVERIFY(answered);
+	QCOMPARE(m_cache->lookupCount(), qint64(1));
+	QCOMPARE(m_cache->prefetchCount(), qint64(1));
+}
+
+void HostInfoCacheTest::cachedHostIsAHit()
+{
+	m_cache->lookup(QStringLiteral("example.com"), this, [](const QHostInfo&) {});
+	answer(0);
+
+	QVERIFY(m_cache->contains(QStringLiteral("example.com")));
+
+	bool answered{false};
+
+	m_cache->lookup(QStringLiteral("example.com"), this, [&answered](const QHostInfo&) { answered = true; });
+
+	QVERIFY(answered);
+	QCOMPARE(m_resolving.count(), 1);
+	QCOMPARE(m_cache->hitCount(), qint64(1));
+
+	// Cached hosts are not prefetched again
+	m_cache->prefetch(QStringLiteral("example.com"));
+	QCOMPARE(m_resolving.count(), 1);
+}
+
+void HostInfoCacheTest::failureExpires()
+{
+	m_cache->setTimeToLive(60 * 1000, 0);
+
+	m_cache->lookup(QStringLiteral("example.com"), this, [](const QHostInfo&) {});
+	answer(0, false);
+
+	QVERIFY(!m_cache->contains(QStringLiteral("example.com")));
+
+	m_cache->lookup(QStringLiteral("example.com"), this, [](const QHostInfo&) {});
+	QCOMPARE(m_resolving.count(), 2);
+}
+
+void HostInfoCacheTest::destroyedContextIsNotCalled()
+{
+	QObject* context{new QObject()};
+	bool answered{false};
+
+	m_cache->lookup(QStringLiteral("example.com"), context, [&answered](const QHostInfo&) { answered = true; });
+	delete context;
+
+	answer(0);
+
+	QVERIFY(!answered);
+	QVERIFY(m_cache->contains(QStringLiteral("example.com")));
+}
+
+QTEST_GUILESS_MAIN(HostInfoCacheTest)
+
+#include "HostInfoCacheTest.moc"
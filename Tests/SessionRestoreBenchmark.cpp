@@ -0,0 +1,110 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include "BrowserTestMain.hpp"
+
+#include "BrowserWindow.hpp"
+
+#include "Utils/RestoreManager.hpp"
+
+#include "Web/Tab/WebTab.hpp"
+
+#include "Widgets/Tab/TabsSpaceSplitter.hpp"
+#include "Widgets/Tab/TabWidget.hpp"
+
+using namespace Sn;
+
+/*
+ * Restore of a saved session holding one window with five hundred tabs, from the session data to the restored window.
+ * The tabs are loaded on activation, so only the restore itself is measured.
+ */
+class SessionRestoreBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void restoreTabs();
+
+private:
+	QByteArray m_session{};
+};
+
+static const int TabCount = 500;
+
+void SessionRestoreBenchmark::initTestCase()
+{
+	TabsSpaceSplitter::SavedTabsSpace tabsSpace{};
+	tabsSpace.currentTab = 0;
+	tabsSpace.tabs.reserve(TabCount);
+
+	for (int i{0}; i < TabCount; ++i) {
+		WebTab::SavedTab tab{};
+		tab.title = QStringLiteral("Tab %1").arg(i);
+		tab.url = QUrl(QStringLiteral("http://tab%1.test/").arg(i));
+
+		tabsSpace.tabs.append(tab);
+	}
+
+	BrowserWindow::SavedWindow window{};
+	window.tabsSpaces.append(tabsSpace);
+
+	RestoreData data{};
+	data.windows.append(window);
+
+	QVERIFY(data.isValid());
+
+	QDataStream stream{&m_session, QIODevice::WriteOnly};
+	stream << data;
+}
+
+void SessionRestoreBenchmark::restoreTabs()
+{
+	const int windowCount{Application::instance()->windowCount()};
+
+	// Once, the tabs of a restored window stay: a second restore would measure a window twice as big
+	QBENCHMARK_ONCE {
+		RestoreData data{};
+		QDataStream stream{m_session};
+		stream >> data;
+
+		Application::instance()->openSession(nullptr, data);
+	}
+
+	QCOMPARE(Application::instance()->windowCount(), windowCount + 1);
+
+	int restoredTabs{0};
+
+	// New windows are put first
+	foreach (TabWidget* tabWidget, Application::instance()->windows().first()->tabsSpaceSplitter()->tabWidgets())
+		restoredTabs += tabWidget->count();
+
+	QVERIFY(restoredTabs >= TabCount);
+}
+
+SIELO_BROWSER_TEST_MAIN(SessionRestoreBenchmark)
+
+#include "SessionRestoreBenchmark.moc"
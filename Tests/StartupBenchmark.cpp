@@ -0,0 +1,135 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <algorithm>
+
+/*
+ * Cold start of the browser with an empty profile. The browser writes its startup trace once the deferred tasks
+ * drained, the benchmark reads the "Time to first paint" span from it.
+ */
+class StartupBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void timeToFirstPaint();
+
+private:
+	qint64 startBrowser(QStringList* spans);
+};
+
+static const int Runs = 3;
+static const int TraceTimeout = 60 * 1000;
+
+qint64 StartupBenchmark::startBrowser(QStringList* spans)
+{
+	QTemporaryDir home{};
+	const QString traceFile{home.filePath(QStringLiteral("startup.json"))};
+
+	// A profile of its own, so the run is a cold start and never talks to a running browser
+	QProcessEnvironment environment{QProcessEnvironment::systemEnvironment()};
+	environment.insert(QStringLiteral("HOME"), home.path());
+	environment.insert(QStringLiteral("XDG_CONFIG_HOME"), home.filePath(QStringLiteral("config")));
+	environment.insert(QStringLiteral("XDG_DATA_HOME"), home.filePath(QStringLiteral("data")));
+	environment.insert(QStringLiteral("XDG_CACHE_HOME"), home.filePath(QStringLiteral("cache")));
+
+	QProcess browser{};
+	browser.setProcessEnvironment(environment);
+	browser.start(QStringLiteral(SIELO_BROWSER_EXECUTABLE), QStringList()
+		<< QStringLiteral("--no-remote") << QStringLiteral("--trace-startup") << traceFile
+		<< QStringLiteral("about:blank"));
+
+	if (!browser.waitForStarted())
+		return -1;
+
+	QJsonDocument trace{};
+	QElapsedTimer timer{};
+	timer.start();
+
+	// The file is written in one go, it is complete once it parses
+	while (trace.isNull() && timer.elapsed() < TraceTimeout) {
+		QTest::qWait(100);
+
+		QFile file{traceFile};
+
+		if (file.open(QIODevice::ReadOnly))
+			trace = QJsonDocument::fromJson(file.readAll());
+	}
+
+	browser.kill();
+	browser.waitForFinished();
+
+	qint64 firstPaint{-1};
+
+	foreach (const QJsonValue& value, trace.object().value(QStringLiteral("traceEvents")).toArray()) {
+		const QJsonObject event{value.toObject()};
+		const QString name{event.value(QStringLiteral("name")).toString()};
+
+		if (event.value(QStringLiteral("ph")).toString() != QLatin1String("X"))
+			continue;
+
+		if (spans)
+			spans->append(name);
+
+		if (name == QLatin1String("Time to first paint"))
+			firstPaint = static_cast<qint64>(event.value(QStringLiteral("dur")).toDouble() / 1000);
+	}
+
+	return firstPaint;
+}
+
+void StartupBenchmark::timeToFirstPaint()
+{
+#ifndef SIELO_TRACING
+	QSKIP("The browser is built without SIELO_TRACING");
+#endif
+
+	QVector<qint64> times{};
+	QStringList spans{};
+
+	for (int i{0}; i < Runs; ++i) {
+		const qint64 time{startBrowser(i == 0 ? &spans : nullptr)};
+
+		QVERIFY2(time >= 0, "The startup trace has no \"Time to first paint\" span");
+		times.append(time);
+	}
+
+	// Deferred tasks run after the first paint and must be in the trace too
+	QVERIFY(spans.contains(QStringLiteral("Theme extraction")));
+
+	std::sort(times.begin(), times.end());
+	QTest::setBenchmarkResult(times[Runs / 2], QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(StartupBenchmark)
+
+#include "StartupBenchmark.moc"
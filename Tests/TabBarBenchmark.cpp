@@ -0,0 +1,161 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QScrollArea>
+#include <QScrollBar>
+
+#include "BrowserTestMain.hpp"
+
+#include "BrowserWindow.hpp"
+
+#include "Web/Tab/WebTab.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+#include "Widgets/Tab/MainTabBar.hpp"
+#include "Widgets/Tab/TabBar.hpp"
+
+using namespace Sn;
+
+/*
+ * Layout, paint, scrolling and hit testing of the tab bar of a browser window holding two thousand tabs, most of them
+ * scrolled out of the view. The tabs are restored without being loaded, only the bar is measured.
+ */
+class TabBarBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void layout();
+	void tabAt();
+	void paint();
+	void scroll();
+	void retitle();
+
+private:
+	MainTabBar* m_tabBar{nullptr};
+	QScrollBar* m_scrollBar{nullptr};
+};
+
+static const int TabCount = 2000;
+// Scrolled by each frame, about what a wheel step animates in one frame
+static const int ScrollStep = 40;
+
+void TabBarBenchmark::initTestCase()
+{
+	BrowserWindow* window{Application::instance()->getWindow()};
+	QVERIFY(window);
+
+	QVector<WebTab::SavedTab> tabs{};
+	tabs.reserve(TabCount);
+
+	for (int i{0}; i < TabCount; ++i) {
+		WebTab::SavedTab tab{};
+		tab.title = QStringLiteral("Tab %1").arg(i);
+		tab.url = QUrl(QStringLiteral("http://tab%1.test/").arg(i));
+
+		tabs.append(tab);
+	}
+
+	QVERIFY(window->tabWidget()->restoreState(tabs, 0, QUrl()));
+
+	window->resize(1280, 800);
+	window->show();
+	QVERIFY(QTest::qWaitForWindowExposed(window));
+
+	m_tabBar = window->tabWidget()->tabBar();
+	QVERIFY(m_tabBar->count() >= TabCount);
+
+	// The main bar scrolls in a scroll area, its bar moves the tabs
+	for (QWidget* parent{m_tabBar->qtabBar()->parentWidget()}; parent && !m_scrollBar; parent = parent->parentWidget()) {
+		if (QScrollArea* scrollArea = qobject_cast<QScrollArea*>(parent))
+			m_scrollBar = scrollArea->horizontalScrollBar();
+	}
+
+	QVERIFY(m_scrollBar);
+	QVERIFY(m_scrollBar->maximum() > 0);
+}
+
+void TabBarBenchmark::layout()
+{
+	// Asks the size hint of every tab, answered from the cache as long as the bar doesn't change
+	QBENCHMARK {
+		m_tabBar->setUpLayout();
+	}
+}
+
+void TabBarBenchmark::tabAt()
+{
+	const int width{m_tabBar->width()};
+	int found{0};
+
+	QBENCHMARK {
+		for (int x{0}; x < width; x += 8)
+			found += m_tabBar->tabAt(QPoint(x, m_tabBar->height() / 2)) != -1 ? 1 : 0;
+	}
+
+	QVERIFY(found > 0);
+}
+
+void TabBarBenchmark::paint()
+{
+	QBENCHMARK {
+		m_tabBar->repaint();
+	}
+}
+
+void TabBarBenchmark::scroll()
+{
+	int value{0};
+
+	// One frame of a scroll: the tabs move by a few pixels and the bar is painted again
+	QBENCHMARK {
+		value = (value + ScrollStep) % (m_scrollBar->maximum() + 1);
+
+		m_scrollBar->setValue(value);
+		m_tabBar->repaint();
+	}
+
+	m_scrollBar->setValue(0);
+}
+
+void TabBarBenchmark::retitle()
+{
+	const int count{m_tabBar->count()};
+	int i{0};
+
+	// A tab always gets the same title, so the last ones don't depend on the number of iterations
+	QBENCHMARK {
+		m_tabBar->setTabText(i % count, QStringLiteral("A longer title for tab %1").arg(i % count));
+		++i;
+	}
+
+	QCOMPARE(m_tabBar->tabText(0), QStringLiteral("A longer title for tab 0"));
+}
+
+SIELO_BROWSER_TEST_MAIN(TabBarBenchmark)
+
+#include "TabBarBenchmark.moc"
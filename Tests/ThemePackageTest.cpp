@@ -0,0 +1,128 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include <QTemporaryDir>
+#include <QDataStream>
+
+#include "Utils/ThemePackage.hpp"
+
+using namespace Sn;
+
+class ThemePackageTest: public QObject {
+Q_OBJECT
+
+private slots:
+	void roundTrip();
+	void rejectsEscapingPaths_data();
+	void rejectsEscapingPaths();
+	void reportsCorruptedLegacyEntries();
+};
+
+void ThemePackageTest::roundTrip()
+{
+	QTemporaryDir dir{};
+	QVERIFY(QDir().mkpath(dir.filePath(QStringLiteral("theme/images"))));
+
+	QFile file{dir.filePath(QStringLiteral("theme/images/icon.txt"))};
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write("icon");
+	file.close();
+
+	const QString packagePath{dir.filePath(QStringLiteral("theme.snthm"))};
+	QVERIFY(ThemePackage::write(dir.filePath(QStringLiteral("theme")), packagePath));
+
+	ThemePackage package{packagePath};
+	QVERIFY(package.open());
+	QCOMPARE(package.version(), 2);
+	QVERIFY(package.extract(dir.filePath(QStringLiteral("extracted"))));
+
+	QFile extracted{dir.filePath(QStringLiteral("extracted/images/icon.txt"))};
+	QVERIFY(extracted.open(QIODevice::ReadOnly));
+	QCOMPARE(extracted.readAll(), QByteArray("icon"));
+}
+
+void ThemePackageTest::rejectsEscapingPaths_data()
+{
+	QTest::addColumn<QString>("path");
+
+	QTest::newRow("parent") << QStringLiteral("../evil.txt");
+	QTest::newRow("nested parent") << QStringLiteral("images/../../evil.txt");
+	QTest::newRow("backslashes") << QStringLiteral("..\\evil.txt");
+	QTest::newRow("drive") << QStringLiteral("C:/evil.txt");
+}
+
+void ThemePackageTest::rejectsEscapingPaths()
+{
+	QFETCH(QString, path);
+
+	QTemporaryDir dir{};
+	const QString packagePath{dir.filePath(QStringLiteral("evil.snthm"))};
+
+	// A version 1 package is a plain stream of (path, compressed content) pairs
+	QFile file{packagePath};
+	QVERIFY(file.open(QIODevice::WriteOnly));
+
+	QDataStream stream{&file};
+	stream << path << qCompress(QByteArray("evil"));
+	file.close();
+
+	ThemePackage package{packagePath};
+	QVERIFY(!package.open());
+	QVERIFY(package.entries().isEmpty());
+
+	package.extract(dir.filePath(QStringLiteral("themes/evil")));
+	QVERIFY(!QFile::exists(dir.filePath(QStringLiteral("themes/evil.txt"))));
+	QVERIFY(!QFile::exists(dir.filePath(QStringLiteral("evil.txt"))));
+}
+
+void ThemePackageTest::reportsCorruptedLegacyEntries()
+{
+	QTemporaryDir dir{};
+	const QString packagePath{dir.filePath(QStringLiteral("corrupted.snthm"))};
+
+	// Keeps the size qCompress stored, but not the deflate stream after it
+	QByteArray data{qCompress(QByteArray("content"))};
+	data.truncate(6);
+
+	QFile file{packagePath};
+	QVERIFY(file.open(QIODevice::WriteOnly));
+
+	QDataStream stream{&file};
+	stream << QStringLiteral("style.sss") << data;
+	file.close();
+
+	ThemePackage package{packagePath};
+	QVERIFY(package.open());
+	QCOMPARE(package.version(), 1);
+	QVERIFY(package.errorString().isEmpty());
+
+	QVERIFY(package.read(QStringLiteral("style.sss")).isEmpty());
+	QVERIFY(!package.errorString().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(ThemePackageTest)
+
+#include "ThemePackageTest.moc"
@@ -30,6 +30,10 @@ CookieStore::CookieStore(QWebEngineCookieStore* store) :
 		QObject(),
 		m_store(store)
 {
+	m_flushTimer.setSingleShot(true);
+	m_flushTimer.setInterval(FlushDelay);
+
+	connect(&m_flushTimer, &QTimer::timeout, this, &CookieStore::flush);
 	connect(m_store, &QWebEngineCookieStore::cookieAdded, this, &CookieStore::emitCookieAdded);
 	connect(m_store, &QWebEngineCookieStore::cookieRemoved, this, &CookieStore::emitCookieRemoved);
 }
@@ -54,14 +58,48 @@ void CookieStore::loadAllCookies()
 	m_store->loadAllCookies();
 }
 
+void CookieStore::flush()
+{
+	m_flushTimer.stop();
+
+	if (m_pendingCookies.isEmpty())
+		return;
+
+	const PendingType type{m_pendingType};
+	QVector<QNetworkCookie> cookies{};
+
+	cookies.swap(m_pendingCookies);
+	m_pendingType = NoPending;
+
+	if (type == PendingAdd)
+		emit cookiesAdded(cookies);
+	else
+		emit cookiesRemoved(cookies);
+}
+
 void CookieStore::emitCookieAdded(const QNetworkCookie& cookie)
 {
-	emit cookieAdded(cookie);
+	queueCookie(PendingAdd, cookie);
 }
 
 void CookieStore::emitCookieRemoved(const QNetworkCookie& cookie)
 {
-	emit cookieRemoved(cookie);
+	queueCookie(PendingRemove, cookie);
+}
+
+void CookieStore::queueCookie(PendingType type, const QNetworkCookie& cookie)
+{
+	// A change of kind closes the current batch so adds and removes are never reordered
+	if (m_pendingType != type)
+		flush();
+
+	m_pendingType = type;
+	m_pendingCookies.append(cookie);
+
+	if (m_pendingCookies.size() >= MaxBatchSize)
+		flush();
+	else
+		m_flushTimer.start();
 }
 
 }
\ No newline at end of file
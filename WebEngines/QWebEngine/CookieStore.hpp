@@ -29,6 +29,8 @@
 #include <QtWebEngineCore/QWebEngineCookieStore>
 
 #include <QNetworkCookie>
+#include <QVector>
+#include <QTimer>
 
 namespace Engine {
 class CookieStore : public QObject {
@@ -42,17 +44,36 @@ public:
 	void deleteAllCookies();
 	void loadAllCookies();
 
+	// Deliver pending changes now instead of waiting for the idle timer
+	void flush();
+
 signals:
-	void cookieAdded(const QNetworkCookie& cookie);
-	void cookieRemoved(const QNetworkCookie& cookie);
+	// Changes are coalesced and delivered in the order they happened, a batch only contains one kind of change
+	void cookiesAdded(const QVector<QNetworkCookie>& cookies);
+	void cookiesRemoved(const QVector<QNetworkCookie>& cookies);
 
 private slots:
 	void emitCookieAdded(const QNetworkCookie& cookie);
 	void emitCookieRemoved(const QNetworkCookie& cookie);
 
 private:
+	enum PendingType {
+		NoPending,
+		PendingAdd,
+		PendingRemove
+	};
+
+	static constexpr int MaxBatchSize = 512;
+	static constexpr int FlushDelay = 50; // In milliseconds
+
+	void queueCookie(PendingType type, const QNetworkCookie& cookie);
+
 	QWebEngineCookieStore* m_store{nullptr};
 
+	QTimer m_flushTimer{};
+	PendingType m_pendingType{NoPending};
+	QVector<QNetworkCookie> m_pendingCookies{};
+
 };
 }
 
@@ -25,41 +25,92 @@
 #include "UrlRequestInfo.hpp"
 
 namespace Engine {
+namespace {
+// Writes a lowercased copy of source in target, reusing the memory target already holds
+void assignLower(QString& target, const QString& source)
+{
+	const int size{source.size()};
+	const QChar* in{source.constData()};
+
+	target.resize(size);
+	QChar* out{target.data()};
+
+	for (int i{0}; i < size; ++i)
+		out[i] = in[i].toLower();
+}
+
+void assignLower(QString& target, const QByteArray& source)
+{
+	const int size{source.size()};
+	const char* in{source.constData()};
+
+	target.resize(size);
+	QChar* out{target.data()};
+
+	for (int i{0}; i < size; ++i) {
+		const char c{in[i]};
+		out[i] = QLatin1Char(c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c);
+	}
+}
+
+QString toSecondLevelDomain(const QUrl& url)
+{
+	const QString topLevelDomain{url.topLevelDomain()};
+	const QString urlHost{url.host()};
+
+	if (topLevelDomain.isEmpty() || urlHost.isEmpty())
+		return QString();
+
+	QString domain{urlHost.left(urlHost.size() - topLevelDomain.size())};
+
+	if (domain.count(QLatin1Char('.')) != 0)
+		return urlHost;
+
+	return domain + topLevelDomain;
+}
+}
 
 UrlRequestInfo::UrlRequestInfo(QWebEngineUrlRequestInfo* request) :
-	QObject(),
-	m_request(request)
+	m_request(request),
+	m_buffers(&threadBuffers()),
+	m_requestUrl(request->requestUrl()),
+	m_firstPartyUrl(request->firstPartyUrl()),
+	m_resourceType(static_cast<ResourceType>(request->resourceType()))
 {
-	// Empty
+	assignLower(m_buffers->url, m_requestUrl.toEncoded());
+	assignLower(m_buffers->host, m_requestUrl.host());
+	assignLower(m_buffers->scheme, m_requestUrl.scheme());
+	assignLower(m_buffers->firstPartyHost, m_firstPartyUrl.host());
 }
 
-UrlRequestInfo::ResourceType UrlRequestInfo::resourceType() const
+UrlRequestInfo::Buffers& UrlRequestInfo::threadBuffers()
 {
-	return static_cast<ResourceType>(m_request->resourceType());
+	thread_local Buffers buffers{};
+	return buffers;
 }
 
-QUrl UrlRequestInfo::requestUrl() const
+bool UrlRequestInfo::isThirdParty() const
 {
-	return m_request->requestUrl();
+	if (m_isThirdParty < 0)
+		m_isThirdParty = toSecondLevelDomain(m_firstPartyUrl) != toSecondLevelDomain(m_requestUrl) ? 1 : 0;
+
+	return m_isThirdParty == 1;
 }
 
 void UrlRequestInfo::redirect(const QUrl& url)
 {
 	m_request->redirect(url);
+	m_redirected = true;
 }
 
 void UrlRequestInfo::block(bool shouldBlock)
 {
 	m_request->block(shouldBlock);
-}
-
-QUrl UrlRequestInfo::firstPartyUrl() const
-{
-	return m_request->firstPartyUrl();
+	m_blocked = shouldBlock;
 }
 
 void UrlRequestInfo::setHttpHeader(const QByteArray& name, const QByteArray& value)
 {
 	m_request->setHttpHeader(name, value);
 }
-}
\ No newline at end of file
+}
@@ -27,14 +27,19 @@
 
 #include "SharedDefines.hpp"
 
-#include <QObject>
+#include <QString>
+#include <QUrl>
 
 #include <QtWebEngineCore/QWebEngineUrlRequestInfo>
 
 namespace Engine {
-class SIELO_SHAREDLIB UrlRequestInfo: public QObject {
-Q_OBJECT
-
+/*
+ * Stack-only view on a request being intercepted, passed by reference to every interceptor. The lowercased url,
+ * host, scheme and first party host are computed once when the view is created, in buffers owned by the calling
+ * thread and reused from one request to the next, so interceptors don't allocate to read them. Only one view may
+ * exist at a time on a thread, and the strings it returns are only valid while it exists.
+ */
+class SIELO_SHAREDLIB UrlRequestInfo {
 public:
 	enum ResourceType {
 		ResourceTypeMainFrame = 0,
@@ -58,19 +63,52 @@ public:
 		ResourceTypeUnknown = 255
 	};
 
-	UrlRequestInfo(QWebEngineUrlRequestInfo* request);
+	explicit UrlRequestInfo(QWebEngineUrlRequestInfo* request);
 	~UrlRequestInfo() = default;
 
+	UrlRequestInfo(const UrlRequestInfo&) = delete;
+	UrlRequestInfo& operator=(const UrlRequestInfo&) = delete;
+
 	void redirect(const QUrl& url);
 	void block(bool shouldBlock);
+	bool isBlocked() const { return m_blocked; }
+	bool isRedirected() const { return m_redirected; }
+
+	const QUrl& firstPartyUrl() const { return m_firstPartyUrl; }
+	const QUrl& requestUrl() const { return m_requestUrl; }
+	ResourceType resourceType() const { return m_resourceType; }
 
-	QUrl firstPartyUrl() const;
-	QUrl requestUrl() const;
-	ResourceType resourceType() const;
+	// Lowercased encoded request url
+	const QString& normalizedUrl() const { return m_buffers->url; }
+	const QString& host() const { return m_buffers->host; }
+	const QString& scheme() const { return m_buffers->scheme; }
+	const QString& firstPartyHost() const { return m_buffers->firstPartyHost; }
+
+	// Compares the second level domains of the request and of the first party, computed on first call only
+	bool isThirdParty() const;
 
 	void setHttpHeader(const QByteArray& name, const QByteArray& value);
+
 private:
+	struct Buffers {
+		QString url{};
+		QString host{};
+		QString scheme{};
+		QString firstPartyHost{};
+	};
+
+	static Buffers& threadBuffers();
+
 	QWebEngineUrlRequestInfo* m_request{nullptr};
+	Buffers* m_buffers{nullptr};
+
+	QUrl m_requestUrl{};
+	QUrl m_firstPartyUrl{};
+	ResourceType m_resourceType{ResourceTypeUnknown};
+
+	mutable int m_isThirdParty{-1};
+	bool m_blocked{false};
+	bool m_redirected{false};
 };
 }
 
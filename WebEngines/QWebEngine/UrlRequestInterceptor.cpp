@@ -34,7 +34,7 @@ UrlRequestInterceptor::UrlRequestInterceptor(QObject* parent) :
 void UrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo& info)
 {
 	UrlRequestInfo request{&info};
-	UrlRequestInterceptor::interceptUrlRequest(request);
+	interceptUrlRequest(request);
 }
 
 void UrlRequestInterceptor::interceptUrlRequest(Engine::UrlRequestInfo& info)
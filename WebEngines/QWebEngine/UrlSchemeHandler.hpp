@@ -0,0 +1,71 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#ifndef SIELO_BROWSER_URLSCHEMEHANDLER_HPP
+#define SIELO_BROWSER_URLSCHEMEHANDLER_HPP
+
+#include "SharedDefines.hpp"
+
+#include <QtWebEngineCore/QWebEngineUrlSchemeHandler>
+#include <QtWebEngineCore/QWebEngineUrlRequestJob>
+
+#include <QHash>
+#include <QUrl>
+
+#include <functional>
+
+namespace Engine {
+/*
+ * Serves internal pages of a custom scheme, like sielo:performance. Pages are added by name (the path of the url)
+ * with a function generating their content each time they are requested.
+ */
+class SIELO_SHAREDLIB UrlSchemeHandler : public QWebEngineUrlSchemeHandler {
+Q_OBJECT
+
+public:
+	using PageGenerator = std::function<QByteArray(const QUrl& url)>;
+
+	UrlSchemeHandler(QObject* parent = nullptr);
+	~UrlSchemeHandler() = default;
+
+	void addPage(const QString& name, const PageGenerator& generator,
+				 const QByteArray& mimeType = QByteArrayLiteral("text/html"));
+	void removePage(const QString& name);
+
+	void requestStarted(QWebEngineUrlRequestJob* job) Q_DECL_OVERRIDE;
+
+	// Must be called before the application object is created
+	static void registerScheme(const QByteArray& name);
+
+private:
+	struct Page {
+		PageGenerator generator{};
+		QByteArray mimeType{};
+	};
+
+	QHash<QString, Page> m_pages{};
+};
+}
+
+#endif //SIELO_BROWSER_URLSCHEMEHANDLER_HPP
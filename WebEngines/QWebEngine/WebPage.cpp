@@ -24,6 +24,9 @@
 
 #include "WebPage.hpp"
 
+#include <QWebEngineScript>
+#include <QWebEngineScriptCollection>
+
 namespace Engine {
 
 WebPage::WebPage(QObject* parent) :
@@ -31,6 +34,8 @@ WebPage::WebPage(QObject* parent) :
 {
 	m_history = new WebHistory(QWebEnginePage::history());
 
+	installLifecycleScript();
+
 	connect(this, &QWebEnginePage::fullScreenRequested, this, &WebPage::emitFullScreenRequest);
 }
 
@@ -39,6 +44,8 @@ WebPage::WebPage(Engine::WebProfile* profile, QObject* parent) :
 {
 	m_history = new WebHistory(QWebEnginePage::history());
 
+	installLifecycleScript();
+
 	connect(this, &QWebEnginePage::fullScreenRequested, this, &WebPage::emitFullScreenRequest);
 }
 
@@ -75,6 +82,86 @@ Engine::WebPage* WebPage::createNewWindow(QWebEnginePage::WebWindowType type)
 	return qobject_cast<Engine::WebPage*>(QWebEnginePage::createWindow(type));
 }
 
+void WebPage::setFrozen(bool frozen)
+{
+	if (m_frozen == frozen)
+		return;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	// Qt refuses to freeze a visible page
+	if (frozen && isVisible())
+		return;
+
+	setLifecycleState(frozen ? LifecycleState::Frozen : LifecycleState::Active);
+#else
+	runJavaScript(frozen ? QStringLiteral("window.__sieloLifecycle && window.__sieloLifecycle.freeze()")
+						 : QStringLiteral("window.__sieloLifecycle && window.__sieloLifecycle.thaw()"));
+#endif
+
+	m_frozen = frozen;
+
+	emit frozenChanged(m_frozen);
+}
+
+void WebPage::installLifecycleScript()
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+	// Without lifecycle states, timer and animation frame callbacks are deferred while the page is frozen:
+	// one-shot callbacks run when the page is thawed, repeating ones are skipped. The wrappers have to replace the
+	// functions the page calls, so this runs in the main world.
+	const QString source{QLatin1String("(function() {"
+		"if (window.__sieloLifecycle)"
+		"    return;"
+		"var lifecycle = window.__sieloLifecycle = {frozen: false, pending: []};"
+		"var nativeSetTimeout = window.setTimeout;"
+		"var nativeSetInterval = window.setInterval;"
+		"var nativeRequestAnimationFrame = window.requestAnimationFrame;"
+		"function wrap(callback, repeat) {"
+		"    if (typeof callback !== 'function')"
+		"        return callback;"
+		"    return function() {"
+		"        var self = this, args = arguments;"
+		"        if (!lifecycle.frozen)"
+		"            return callback.apply(self, args);"
+		"        if (!repeat)"
+		"            lifecycle.pending.push(function() { callback.apply(self, args); });"
+		"    };"
+		"}"
+		"window.setTimeout = function(callback) {"
+		"    var args = Array.prototype.slice.call(arguments);"
+		"    args[0] = wrap(callback, false);"
+		"    return nativeSetTimeout.apply(window, args);"
+		"};"
+		"window.setInterval = function(callback) {"
+		"    var args = Array.prototype.slice.call(arguments);"
+		"    args[0] = wrap(callback, true);"
+		"    return nativeSetInterval.apply(window, args);"
+		"};"
+		"if (nativeRequestAnimationFrame) {"
+		"    window.requestAnimationFrame = function(callback) {"
+		"        return nativeRequestAnimationFrame.call(window, wrap(callback, false));"
+		"    };"
+		"}"
+		"lifecycle.freeze = function() { lifecycle.frozen = true; };"
+		"lifecycle.thaw = function() {"
+		"    lifecycle.frozen = false;"
+		"    var pending = lifecycle.pending;"
+		"    lifecycle.pending = [];"
+		"    pending.forEach(function(callback) { nativeSetTimeout(callback, 0); });"
+		"};"
+		"})();")};
+
+	QWebEngineScript script{};
+	script.setName(QStringLiteral("_sielo_page_lifecycle"));
+	script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+	script.setWorldId(QWebEngineScript::MainWorld);
+	script.setRunsOnSubFrames(false);
+	script.setSourceCode(source);
+
+	scripts().insert(script);
+#endif
+}
+
 void WebPage::emitFullScreenRequest(QWebEngineFullScreenRequest request)
 {
 	FullScreenRequest newRequest{&request};
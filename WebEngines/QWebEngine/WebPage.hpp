@@ -51,14 +51,25 @@ public:
 	QWebEnginePage* createWindow(WebWindowType type) Q_DECL_OVERRIDE;
 	virtual Engine::WebPage* createNewWindow(WebWindowType type);
 
+	/*
+	 * A frozen page stops running its timers and animations until it is thawed. With Qt 5.14 and later the page
+	 * lifecycle state is used, older versions only have a script deferring timer and animation frame callbacks.
+	 */
+	bool isFrozen() const { return m_frozen; }
+	void setFrozen(bool frozen);
+
 signals:
 	void fullScreenRequested(FullScreenRequest& request);
+	void frozenChanged(bool frozen);
 
 private slots:
 	void emitFullScreenRequest(QWebEngineFullScreenRequest request);
 
 private:
+	void installLifecycleScript();
+
 	WebHistory* m_history{nullptr};
+	bool m_frozen{false};
 };
 }
 